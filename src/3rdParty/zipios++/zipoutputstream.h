@@ -53,6 +53,11 @@ public:
       Begins writing the next entry.
   */
   void putNextEntry(const std::string& entryName);
+  /** Writes a complete entry from already compressed data. See
+      ZipOutputStreambuf::putRawEntry(). */
+  void putRawEntry( const std::string &entryName, const char *data,
+                    uint32 compressed_size, uint32 size, uint32 crc,
+                    StorageMethod method ) ;
 
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
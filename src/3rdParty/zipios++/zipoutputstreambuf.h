@@ -49,6 +49,20 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry whose data has already been compressed
+      with the given method, e.g. raw deflate data without zlib
+      header. Any open entry is closed first. The entry is closed when
+      the method returns.
+      @param entry the entry to write.
+      @param data the compressed entry data.
+      @param compressed_size the size of data in bytes.
+      @param size the uncompressed size of the entry data.
+      @param crc the crc32 checksum of the uncompressed data.
+      @param method the method used to compress data. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data,
+                    uint32 compressed_size, uint32 size, uint32 crc,
+                    StorageMethod method ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -68,6 +82,7 @@ protected:
 
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
+  static int dosTime() ;
 
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
@@ -0,0 +1,571 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************************************
+ *                                                                                                 *
+ *   Copyright (c) 2026 FreeCAD Project Association                                                *
+ *                                                                                                 *
+ *   This file is part of FreeCAD.                                                                 *
+ *                                                                                                 *
+ *   FreeCAD is free software: you can redistribute it and/or modify it under the terms of the     *
+ *   GNU Lesser General Public License as published by the Free Software Foundation, either        *
+ *   version 2.1 of the License, or (at your option) any later version.                            *
+ *                                                                                                 *
+ *   FreeCAD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;          *
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     *
+ *   See the GNU Lesser General Public License for more details.                                   *
+ *                                                                                                 *
+ *   You should have received a copy of the GNU Lesser General Public License along with           *
+ *   FreeCAD. If not, see <https://www.gnu.org/licenses/>.                                         *
+ *                                                                                                 *
+ **************************************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <set>
+#endif
+
+#include <QFile>
+
+#include "CompactElementMap.h"
+
+#include <Base/Exception.h>
+
+
+namespace Data
+{
+
+// The block starts with the header, followed by the string IDs, the names,
+// the types, the slots, the names ordered by element and the arena. Every
+// section starts at a multiple of eight bytes.
+struct CompactElementMap::Header
+{
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t nameCount;
+    std::uint32_t typeCount;
+    std::uint32_t slotCount;
+    std::uint32_t idCount;
+    std::uint32_t arenaSize;
+    std::uint64_t blockSize;
+};
+
+struct CompactElementMap::Name
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+    std::uint32_t type;
+    std::int32_t index;
+    std::uint32_t idOffset;
+    std::uint32_t idCount;
+};
+
+// The names of the element with index i of a type are byElement[slots[slotOffset + i]]
+// up to byElement[slots[slotOffset + i + 1]].
+struct CompactElementMap::Type
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+    std::uint32_t slotOffset;
+    std::uint32_t slotCount;
+};
+
+struct CompactElementMap::Entry
+{
+    QByteArray text;
+    std::uint32_t type;
+    std::int32_t index;
+    std::vector<std::int64_t> ids;
+};
+
+namespace
+{
+
+constexpr char blockMagic[8] = {'F', 'C', 'E', 'M', 'A', 'P', '0', '1'};
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+std::size_t align(std::size_t size)
+{
+    constexpr std::size_t alignment = 8;
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+struct Layout
+{
+    std::size_t ids;
+    std::size_t names;
+    std::size_t types;
+    std::size_t slots;
+    std::size_t byElement;
+    std::size_t arena;
+    std::size_t size;
+};
+
+template<class Header, class Name, class Type>
+Layout layoutOf(const Header& header)
+{
+    Layout layout {};
+    layout.ids = align(sizeof(Header));
+    layout.names = align(layout.ids + header.idCount * sizeof(std::int64_t));
+    layout.types = align(layout.names + header.nameCount * sizeof(Name));
+    layout.slots = align(layout.types + header.typeCount * sizeof(Type));
+    layout.byElement = align(layout.slots + header.slotCount * sizeof(std::uint32_t));
+    layout.arena = align(layout.byElement + header.nameCount * sizeof(std::uint32_t));
+    layout.size = align(layout.arena + header.arenaSize);
+    return layout;
+}
+
+// Compares the text of a stored name with the data and postfix of a mapped
+// name the same way as the names were sorted, i.e. bytewise as by memcmp().
+int compareText(const char* text, std::size_t size, const MappedName& name)
+{
+    const QByteArray& data = name.dataBytes();
+    const QByteArray& postfix = name.postfixBytes();
+    std::size_t dataSize = std::min<std::size_t>(size, data.size());
+    int res = std::memcmp(text, data.constData(), dataSize);
+    if (res != 0) {
+        return res;
+    }
+    if (size < static_cast<std::size_t>(data.size())) {
+        return -1;
+    }
+    text += dataSize;
+    size -= dataSize;
+    res = std::memcmp(text, postfix.constData(), std::min<std::size_t>(size, postfix.size()));
+    if (res != 0) {
+        return res;
+    }
+    if (size < static_cast<std::size_t>(postfix.size())) {
+        return -1;
+    }
+    return size > static_cast<std::size_t>(postfix.size()) ? 1 : 0;
+}
+
+void throwInvalid()
+{
+    FC_THROWM(Base::RuntimeError, "Invalid compact element map");  // NOLINT
+}
+
+}  // namespace
+
+CompactElementMap::CompactElementMap()
+{
+    build({}, {});
+}
+
+CompactElementMap::CompactElementMap(const ElementMap& map)
+    : hasher(map.hasher)
+{
+    std::vector<IndexedName> elements;
+    for (const auto& element : map.getAll()) {
+        elements.push_back(element.index);
+    }
+    std::sort(elements.begin(),
+              elements.end(),
+              [](const IndexedName& element1, const IndexedName& element2) {
+                  int res = std::strcmp(element1.getType(), element2.getType());
+                  return res < 0 || (res == 0 && element1.getIndex() < element2.getIndex());
+              });
+    elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+
+    std::vector<QByteArray> typeNames;
+    std::vector<Entry> entries;
+    std::set<QByteArray> texts;
+    for (const auto& element : elements) {
+        for (const auto& [name, sids] : map.findAll(element)) {
+            QByteArray text = name.toBytes();
+            if (!texts.insert(text).second) {
+                continue;
+            }
+            if (typeNames.empty() || typeNames.back() != element.getType()) {
+                typeNames.emplace_back(element.getType());
+            }
+            Entry entry {text,
+                         static_cast<std::uint32_t>(typeNames.size() - 1),
+                         element.getIndex(),
+                         {}};
+            for (const auto& sid : sids) {
+                if (sid.isFromSameHasher(hasher)) {
+                    entry.ids.push_back(sid.value());
+                }
+            }
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    build(entries, typeNames);
+}
+
+CompactElementMap::~CompactElementMap() = default;
+
+void CompactElementMap::build(const std::vector<Entry>& entries,
+                              const std::vector<QByteArray>& typeNames)
+{
+    Header head {};
+    std::memcpy(head.magic, blockMagic, sizeof(blockMagic));
+    head.byteOrder = byteOrderMark;
+    head.nameCount = static_cast<std::uint32_t>(entries.size());
+    head.typeCount = static_cast<std::uint32_t>(typeNames.size());
+
+    std::size_t arenaSize = 0;
+    for (const auto& typeName : typeNames) {
+        arenaSize += typeName.size() + 1;
+    }
+    for (const auto& entry : entries) {
+        arenaSize += entry.text.size() + 1;
+        head.idCount += static_cast<std::uint32_t>(entry.ids.size());
+    }
+    head.arenaSize = static_cast<std::uint32_t>(arenaSize);
+
+    // one slot per index of each type and one to end the last range
+    std::vector<std::uint32_t> slotCounts(typeNames.size(), 0);
+    for (const auto& entry : entries) {
+        slotCounts[entry.type] = static_cast<std::uint32_t>(entry.index) + 2;
+    }
+    head.slotCount = std::accumulate(slotCounts.begin(), slotCounts.end(), std::uint32_t(0));
+
+    Layout layout = layoutOf<Header, Name, Type>(head);
+    head.blockSize = layout.size;
+    reset();
+    buffer.assign(layout.size / sizeof(std::uint64_t), 0);
+    char* data = reinterpret_cast<char*>(buffer.data());  // NOLINT
+    std::memcpy(data, &head, sizeof(head));
+    auto* blockIds = reinterpret_cast<std::int64_t*>(data + layout.ids);         // NOLINT
+    auto* blockNames = reinterpret_cast<Name*>(data + layout.names);              // NOLINT
+    auto* blockTypes = reinterpret_cast<Type*>(data + layout.types);              // NOLINT
+    auto* blockSlots = reinterpret_cast<std::uint32_t*>(data + layout.slots);     // NOLINT
+    auto* blockOrder = reinterpret_cast<std::uint32_t*>(data + layout.byElement);  // NOLINT
+    char* blockArena = data + layout.arena;                                        // NOLINT
+
+    std::uint32_t arenaOffset = 0;
+    std::uint32_t slotOffset = 0;
+    std::size_t entry = 0;
+    for (std::size_t type = 0; type < typeNames.size(); ++type) {
+        const QByteArray& typeName = typeNames[type];
+        auto& blockType = blockTypes[type];
+        blockType.offset = arenaOffset;
+        blockType.size = static_cast<std::uint32_t>(typeName.size());
+        std::memcpy(blockArena + arenaOffset, typeName.constData(), typeName.size());
+        arenaOffset += blockType.size + 1;
+
+        std::size_t end = entry;
+        while (end < entries.size() && entries[end].type == type) {
+            ++end;
+        }
+        blockType.slotOffset = slotOffset;
+        blockType.slotCount = slotCounts[type];
+        for (std::uint32_t i = 0; i < blockType.slotCount; ++i) {
+            while (entry < end && entries[entry].index < static_cast<std::int32_t>(i)) {
+                ++entry;
+            }
+            blockSlots[slotOffset + i] = static_cast<std::uint32_t>(entry);
+        }
+        slotOffset += blockType.slotCount;
+        entry = end;
+    }
+
+    std::vector<std::uint32_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&entries](std::uint32_t i1, std::uint32_t i2) {
+        const QByteArray& text1 = entries[i1].text;
+        const QByteArray& text2 = entries[i2].text;
+        int res = std::memcmp(text1.constData(),
+                              text2.constData(),
+                              std::min(text1.size(), text2.size()));
+        return res < 0 || (res == 0 && text1.size() < text2.size());
+    });
+
+    std::uint32_t idOffset = 0;
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        const Entry& source = entries[order[i]];
+        auto& blockName = blockNames[i];
+        blockName.offset = arenaOffset;
+        blockName.size = static_cast<std::uint32_t>(source.text.size());
+        blockName.type = source.type;
+        blockName.index = source.index;
+        blockName.idOffset = idOffset;
+        blockName.idCount = static_cast<std::uint32_t>(source.ids.size());
+        std::memcpy(blockArena + arenaOffset, source.text.constData(), source.text.size());
+        arenaOffset += blockName.size + 1;
+        std::copy(source.ids.begin(), source.ids.end(), blockIds + idOffset);
+        idOffset += blockName.idCount;
+        blockOrder[order[i]] = i;
+    }
+
+    attach(data, layout.size);
+}
+
+void CompactElementMap::reset()
+{
+    header = nullptr;
+    ids = nullptr;
+    names = nullptr;
+    types = nullptr;
+    slots = nullptr;
+    byElement = nullptr;
+    arena = nullptr;
+    file.reset();
+    buffer.clear();
+}
+
+void CompactElementMap::attach(const char* data, std::size_t size)
+{
+    // The block comes from a file and is checked once here, so that the
+    // lookups can use the offsets without further checks.
+    Header head {};
+    if (size < sizeof(Header)) {
+        throwInvalid();
+    }
+    std::memcpy(&head, data, sizeof(Header));
+    Layout layout = layoutOf<Header, Name, Type>(head);
+    if (std::memcmp(head.magic, blockMagic, sizeof(blockMagic)) != 0
+        || head.byteOrder != byteOrderMark || head.blockSize != layout.size
+        || layout.size > size) {
+        throwInvalid();
+    }
+
+    header = reinterpret_cast<const Header*>(data);                         // NOLINT
+    ids = reinterpret_cast<const std::int64_t*>(data + layout.ids);         // NOLINT
+    names = reinterpret_cast<const Name*>(data + layout.names);             // NOLINT
+    types = reinterpret_cast<const Type*>(data + layout.types);             // NOLINT
+    slots = reinterpret_cast<const std::uint32_t*>(data + layout.slots);    // NOLINT
+    byElement = reinterpret_cast<const std::uint32_t*>(data + layout.byElement);  // NOLINT
+    arena = data + layout.arena;                                              // NOLINT
+
+    auto inArena = [&head, this](std::uint64_t offset, std::uint64_t textSize) {
+        return offset + textSize < head.arenaSize && arena[offset + textSize] == 0;
+    };
+    for (std::uint32_t i = 0; i < head.nameCount; ++i) {
+        const Name& name = names[i];
+        if (!inArena(name.offset, name.size) || name.type >= head.typeCount || name.index < 0
+            || std::uint64_t(name.idOffset) + name.idCount > head.idCount
+            || byElement[i] >= head.nameCount) {
+            throwInvalid();
+        }
+    }
+    for (std::uint32_t i = 0; i < head.typeCount; ++i) {
+        const Type& type = types[i];
+        if (!inArena(type.offset, type.size)
+            || std::uint64_t(type.slotOffset) + type.slotCount > head.slotCount) {
+            throwInvalid();
+        }
+        for (std::uint32_t j = 0; j < type.slotCount; ++j) {
+            std::uint32_t slot = slots[type.slotOffset + j];
+            if (slot > head.nameCount || (j > 0 && slot < slots[type.slotOffset + j - 1])) {
+                throwInvalid();
+            }
+        }
+    }
+}
+
+void CompactElementMap::save(std::ostream& stream) const
+{
+    stream.write(reinterpret_cast<const char*>(header),  // NOLINT
+                 static_cast<std::streamsize>(header->blockSize));
+}
+
+void CompactElementMap::restore(std::istream& stream)
+{
+    Header head {};
+    if (!stream.read(reinterpret_cast<char*>(&head), sizeof(head))  // NOLINT
+        || std::memcmp(head.magic, blockMagic, sizeof(blockMagic)) != 0
+        || head.byteOrder != byteOrderMark
+        || head.blockSize != layoutOf<Header, Name, Type>(head).size) {
+        throwInvalid();
+    }
+
+    try {
+        reset();
+        buffer.resize(head.blockSize / sizeof(std::uint64_t));
+        char* data = reinterpret_cast<char*>(buffer.data());  // NOLINT
+        std::memcpy(data, &head, sizeof(head));
+        if (!stream.read(data + sizeof(head),  // NOLINT
+                         static_cast<std::streamsize>(head.blockSize - sizeof(head)))) {
+            throwInvalid();
+        }
+        attach(data, head.blockSize);
+    }
+    catch (...) {
+        build({}, {});
+        throw;
+    }
+}
+
+void CompactElementMap::restore(const std::string& fileName, std::int64_t offset)
+{
+    auto mapped = std::make_unique<QFile>(QString::fromUtf8(fileName.c_str()));
+    if (!mapped->open(QIODevice::ReadOnly) || offset < 0 || offset >= mapped->size()) {
+        throw Base::FileException("Cannot open file", fileName);
+    }
+    auto size = static_cast<std::size_t>(mapped->size() - offset);
+    const char* data =
+        reinterpret_cast<const char*>(mapped->map(offset, mapped->size() - offset));  // NOLINT
+    if (!data) {
+        throw Base::FileException("Cannot map file", fileName);
+    }
+
+    try {
+        reset();
+        file = std::move(mapped);
+        if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t) != 0) {  // NOLINT
+            // the offset is not aligned, read the block into memory instead
+            buffer.resize(align(size) / sizeof(std::uint64_t));
+            std::memcpy(buffer.data(), data, size);
+            file.reset();
+            data = reinterpret_cast<const char*>(buffer.data());  // NOLINT
+        }
+        attach(data, size);
+    }
+    catch (...) {
+        build({}, {});
+        throw;
+    }
+}
+
+bool CompactElementMap::isMapped() const
+{
+    return file != nullptr;
+}
+
+std::size_t CompactElementMap::blockSize() const
+{
+    return header->blockSize;
+}
+
+unsigned long CompactElementMap::size() const
+{
+    return header->nameCount;
+}
+
+bool CompactElementMap::empty() const
+{
+    return header->nameCount == 0;
+}
+
+const CompactElementMap::Name* CompactElementMap::findName(const MappedName& name) const
+{
+    const Name* end = names + header->nameCount;  // NOLINT
+    auto less = [this](const Name& entry, const MappedName& key) {
+        return compareText(arena + entry.offset, entry.size, key) < 0;  // NOLINT
+    };
+    const Name* it = std::lower_bound(names, end, name, less);
+    if (it == end || compareText(arena + it->offset, it->size, name) != 0) {  // NOLINT
+        return nullptr;
+    }
+    return it;
+}
+
+std::pair<const std::uint32_t*, const std::uint32_t*>
+CompactElementMap::findSlot(const IndexedName& idx) const
+{
+    const Type* end = types + header->typeCount;  // NOLINT
+    auto less = [this](const Type& type, const char* key) {
+        return std::strcmp(arena + type.offset, key) < 0;  // NOLINT
+    };
+    const Type* it = std::lower_bound(types, end, idx.getType(), less);
+    if (it == end || std::strcmp(arena + it->offset, idx.getType()) != 0  // NOLINT
+        || static_cast<std::uint32_t>(idx.getIndex()) + 1 >= it->slotCount) {
+        return {};
+    }
+    const std::uint32_t* slot = slots + it->slotOffset + idx.getIndex();  // NOLINT
+    return {byElement + slot[0], byElement + slot[1]};                   // NOLINT
+}
+
+MappedName CompactElementMap::nameOf(const Name& name) const
+{
+    return MappedName(arena + name.offset, static_cast<int>(name.size));  // NOLINT
+}
+
+IndexedName CompactElementMap::elementOf(const Name& name) const
+{
+    return IndexedName(arena + types[name.type].offset, name.index);  // NOLINT
+}
+
+void CompactElementMap::addIDs(const Name& name, ElementIDRefs& sids) const
+{
+    if (!hasher) {
+        return;
+    }
+    for (std::uint32_t i = 0; i < name.idCount; ++i) {
+        auto sid = hasher->getID(ids[name.idOffset + i]);  // NOLINT
+        if (sid) {
+            sids.push_back(sid);
+        }
+    }
+}
+
+IndexedName CompactElementMap::find(const MappedName& name, ElementIDRefs* sids) const
+{
+    const Name* res = findName(name);
+    if (!res) {
+        return IndexedName();
+    }
+    if (sids) {
+        addIDs(*res, *sids);
+    }
+    return elementOf(*res);
+}
+
+MappedName CompactElementMap::find(const IndexedName& idx, ElementIDRefs* sids) const
+{
+    if (!idx) {
+        return {};
+    }
+    auto range = findSlot(idx);
+    if (range.first == range.second) {
+        return {};
+    }
+    const Name& name = names[*range.first];  // NOLINT
+    if (sids) {
+        addIDs(name, *sids);
+    }
+    return nameOf(name);
+}
+
+std::vector<std::pair<MappedName, ElementIDRefs>>
+CompactElementMap::findAll(const IndexedName& idx) const
+{
+    std::vector<std::pair<MappedName, ElementIDRefs>> res;
+    if (!idx) {
+        return res;
+    }
+    auto range = findSlot(idx);
+    res.reserve(range.second - range.first);
+    for (auto it = range.first; it != range.second; ++it) {  // NOLINT
+        const Name& name = names[*it];                       // NOLINT
+        ElementIDRefs sids;
+        addIDs(name, sids);
+        res.emplace_back(nameOf(name), sids);
+    }
+    return res;
+}
+
+std::vector<MappedElement> CompactElementMap::getAll() const
+{
+    std::vector<MappedElement> res;
+    res.reserve(header->nameCount);
+    for (std::uint32_t i = 0; i < header->nameCount; ++i) {
+        res.emplace_back(nameOf(names[i]), elementOf(names[i]));  // NOLINT
+    }
+    return res;
+}
+
+ElementMapPtr CompactElementMap::toElementMap(long masterTag) const
+{
+    auto map = std::make_shared<ElementMap>();
+    map->hasher = hasher;
+    for (std::uint32_t i = 0; i < header->nameCount; ++i) {
+        const Name& name = names[byElement[i]];  // NOLINT
+        ElementIDRefs sids;
+        addIDs(name, sids);
+        map->setElementName(elementOf(name), nameOf(name), masterTag, &sids);
+    }
+    return map;
+}
+
+}  // namespace Data
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************************************
+ *                                                                                                 *
+ *   Copyright (c) 2026 FreeCAD Project Association                                                *
+ *                                                                                                 *
+ *   This file is part of FreeCAD.                                                                 *
+ *                                                                                                 *
+ *   FreeCAD is free software: you can redistribute it and/or modify it under the terms of the     *
+ *   GNU Lesser General Public License as published by the Free Software Foundation, either        *
+ *   version 2.1 of the License, or (at your option) any later version.                            *
+ *                                                                                                 *
+ *   FreeCAD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;          *
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     *
+ *   See the GNU Lesser General Public License for more details.                                   *
+ *                                                                                                 *
+ *   You should have received a copy of the GNU Lesser General Public License along with           *
+ *   FreeCAD. If not, see <https://www.gnu.org/licenses/>.                                         *
+ *                                                                                                 *
+ **************************************************************************************************/
+
+#ifndef DATA_COMPACTELEMENTMAP_H
+#define DATA_COMPACTELEMENTMAP_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ElementMap.h"
+
+class QFile;
+
+namespace Data
+{
+
+/** Read-only element map stored in a single contiguous block
+ *
+ * ElementMap keeps every mapped name in its own map node and deque entry. A
+ * CompactElementMap holds a snapshot of such a map as flat arrays instead:
+ *
+ * - a string arena with the bytes of all mapped names and element types,
+ * - the names sorted by their bytes, each with the offset and size of its
+ *   text in the arena, its element type and index and its string IDs,
+ * - the element types sorted by name, each with a slot table indexed by the
+ *   element index that points into the names ordered by element.
+ *
+ * Looking up the element of a name is a binary search over the sorted names,
+ * looking up the names of an element is a binary search over the types and a
+ * direct access into the slot table. The block is saved as it is and can be
+ * restored by mapping a file into memory, in which case no per-name memory is
+ * allocated at all.
+ *
+ * The names of child element maps are expanded into the snapshot. The block
+ * is stored in native byte order and rejected on a machine with another one.
+ */
+class AppExport CompactElementMap
+{
+public:
+    CompactElementMap();
+
+    /** Takes a snapshot of all names of \c map
+     *
+     * The names of an element keep the order in which ElementMap returns them,
+     * i.e. the first one is the one returned by find().
+     */
+    explicit CompactElementMap(const ElementMap& map);
+
+    ~CompactElementMap();
+
+    CompactElementMap(const CompactElementMap&) = delete;
+    CompactElementMap& operator=(const CompactElementMap&) = delete;
+
+    /// Writes the block to \c stream
+    void save(std::ostream& stream) const;
+
+    /** Reads a block written by save() from \c stream into memory
+     * @throws Base::RuntimeError if the block is invalid
+     */
+    void restore(std::istream& stream);
+
+    /** Maps the block written by save() at \c offset of the file \c fileName
+     * into memory. The file is kept open until this map is destroyed or
+     * restored again.
+     * @throws Base::FileException if the file cannot be mapped
+     * @throws Base::RuntimeError if the block is invalid
+     */
+    void restore(const std::string& fileName, std::int64_t offset = 0);
+
+    /// Whether the block is mapped from a file
+    bool isMapped() const;
+
+    /// Size of the block in bytes
+    std::size_t blockSize() const;
+
+    unsigned long size() const;
+
+    bool empty() const;
+
+    IndexedName find(const MappedName& name, ElementIDRefs* sids = nullptr) const;
+
+    MappedName find(const IndexedName& idx, ElementIDRefs* sids = nullptr) const;
+
+    std::vector<std::pair<MappedName, ElementIDRefs>> findAll(const IndexedName& idx) const;
+
+    std::vector<MappedElement> getAll() const;
+
+    /// Builds an ElementMap with the names of this map
+    ElementMapPtr toElementMap(long masterTag) const;
+
+    /// String hasher to resolve the stored string IDs
+    App::StringHasherRef hasher;
+
+private:
+    struct Header;
+    struct Name;
+    struct Type;
+    struct Entry;
+
+    void build(const std::vector<Entry>& entries, const std::vector<QByteArray>& typeNames);
+    void attach(const char* data, std::size_t size);
+    void reset();
+
+    const Name* findName(const MappedName& name) const;
+    std::pair<const std::uint32_t*, const std::uint32_t*> findSlot(const IndexedName& idx) const;
+    MappedName nameOf(const Name& name) const;
+    IndexedName elementOf(const Name& name) const;
+    void addIDs(const Name& name, ElementIDRefs& sids) const;
+
+private:
+    std::vector<std::uint64_t> buffer;
+    std::unique_ptr<QFile> file;
+
+    const Header* header = nullptr;
+    const std::int64_t* ids = nullptr;
+    const Name* names = nullptr;
+    const Type* types = nullptr;
+    const std::uint32_t* slots = nullptr;
+    const std::uint32_t* byElement = nullptr;
+    const char* arena = nullptr;
+};
+
+}  // namespace Data
+
+#endif  // DATA_COMPACTELEMENTMAP_H
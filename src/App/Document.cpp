@@ -35,7 +35,10 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <thread>
 #endif
 
 #include <boost/algorithm/string.hpp>
@@ -605,6 +608,8 @@ void Document::clearDocument() // NOLINT
     d->clearRecomputeLog();
     d->objectLabelManager.clear();
     d->objectArray.clear();
+    d->clearDependencyCache();
+    d->recomputeCandidates.clear();
     d->objectMap.clear();
     d->objectNameManager.clear();
     d->objectIdMap.clear();
@@ -903,6 +908,11 @@ Document::Document(const char* documentName)
                       0,
                       PropertyType(Prop_Hidden),
                       "Whether to use hasher on topological naming");
+    ADD_PROPERTY_TYPE(BinaryBrep,
+                      (paramGrp->GetBool("SaveBinaryBrep", false)),
+                      0,
+                      PropertyType(Prop_Hidden),
+                      "Whether to save shapes in the binary format instead of text BRep");
 
     // this creates and sets 'TransientDir' in onChanged()
     ADD_PROPERTY_TYPE(TransientDir,
@@ -1817,9 +1827,10 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        writer.setThreadCount(static_cast<int>(hGrp->GetInt("SaveThreads", 1)));
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false)) {
+        if (BinaryBrep.getValue()) {
             writer.setMode("BinaryBrep");
         }
 
@@ -1940,6 +1951,8 @@ void Document::restore(const char* filename,
     d->clearRecomputeLog();
     d->objectLabelManager.clear();
     d->objectArray.clear();
+    d->clearDependencyCache();
+    d->recomputeCandidates.clear();
     d->objectNameManager.clear();
     d->objectMap.clear();
     d->objectIdMap.clear();
@@ -1971,6 +1984,17 @@ void Document::restore(const char* filename,
         throw Base::FileException("Error reading compression file", filename);
     }
 
+    // Only expose the archive path if it's the document's own file, e.g. not for
+    // recovery files that are removed after opening. Properties that support lazy
+    // loading use it to read their data later on.
+    if (fi.filePath() == Base::FileInfo(FileName.getValue()).filePath()) {
+        reader.setArchiveFileName(fi.filePath());
+    }
+
+    auto hGrp = GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    reader.setThreadCount(static_cast<int>(hGrp->GetInt("RestoreThreads", 1)));
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
@@ -2486,6 +2510,44 @@ Document::getDependencyList(const std::vector<DocumentObject*>& objs, int option
     return ret;
 }
 
+const Document::DependencyCacheStats& Document::getDependencyCacheStats() const
+{
+    return d->depCacheStats;
+}
+
+unsigned long Document::getOutListGeneration() const
+{
+    return d->outListGeneration;
+}
+
+void Document::_onOutListChanged(const DocumentObject* obj)
+{
+    ++d->outListGeneration;
+    if (d->sortedOptions != -1) {
+        d->outListChanged.push_back(obj);
+    }
+}
+
+void Document::_addRecomputeCandidate(const DocumentObject* obj)
+{
+    d->recomputeCandidates.insert(obj);
+}
+
+void Document::setRecomputeProfiling(bool on)
+{
+    d->profiler.setEnabled(on);
+}
+
+bool Document::isRecomputeProfiling() const
+{
+    return d->profiler.isEnabled();
+}
+
+const RecomputeProfiler& Document::getRecomputeProfiler() const
+{
+    return d->profiler;
+}
+
 std::vector<Document*> Document::getDependentDocuments(const bool sort)
 {
     return getDependentDocuments({this}, sort);
@@ -2662,8 +2724,17 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
    */
 
     // alt:
-    auto topoSortedObjects =
-        getDependencyList(objs.empty() ? d->objectArray : objs, DepSort | options);
+    std::vector<DocumentObject*> topoSortedObjects;
+    if (objs.empty()) {
+        // Only the objects that must be recomputed and their dependents are
+        // scheduled, taken from the cached sorted list of the whole document
+        d->getSortedDependencyList(this, DepSort | options);
+        topoSortedObjects = d->getRecomputeCone({});
+    }
+    else {
+        topoSortedObjects = getDependencyList(objs, DepSort | options);
+    }
+    d->depCacheStats.lastRecomputeSize = topoSortedObjects.size();
 
     for (auto obj : topoSortedObjects) {
         obj->setStatus(ObjectStatus::PendingRecompute, true);
@@ -2672,9 +2743,12 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     ParameterGrp::handle hGrp =
         GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
+    bool concurrent = hGrp->GetBool("ParallelRecompute", false);
 
     FC_TIME_INIT(t2);
 
+    d->profiler.begin();
+
     try {
         std::set<DocumentObject*> filter;
         size_t idx = 0;
@@ -2686,6 +2760,14 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                                                                 topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
+            // Only the first pass is scheduled concurrently. The second pass
+            // deals with dependency inversion and must follow the sorted order.
+            if (concurrent && passes == 0) {
+                if (!_recomputeConcurrent(topoSortedObjects, filter, seq.get(), hasError, objectCount)) {
+                    passes = 2;
+                }
+                idx = topoSortedObjects.size();
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
@@ -2724,6 +2806,19 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                     seq->next(true);
                 }
             }
+            // objects touched by the first pass, e.g. on dependency inversion,
+            // may lie outside of the scheduled cone, so collect them again
+            if (objs.empty() && passes == 0) {
+                d->getSortedDependencyList(this, DepSort | options);
+                auto cone = d->getRecomputeCone(topoSortedObjects);
+                for (auto obj : cone) {
+                    obj->setStatus(ObjectStatus::PendingRecompute, true);
+                }
+                if (idx >= topoSortedObjects.size()) {
+                    idx = cone.size();
+                }
+                topoSortedObjects = std::move(cone);
+            }
             // check if all objects are recomputed but still thouched
             for (size_t i = 0; i < topoSortedObjects.size(); ++i) {
                 auto obj = topoSortedObjects[i];
@@ -2750,6 +2845,9 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
 
     FC_TIME_LOG(t2, "Recompute");
 
+    d->profiler.end();
+    d->pruneRecomputeCandidates();
+
     for (auto obj : topoSortedObjects) {
         if (!obj->isAttachedToDocument()) {
             continue;
@@ -2794,6 +2892,217 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     return objectCount;
 }
 
+std::vector<DocumentObject*> DocumentP::getSortedDependencyList(const Document* doc,
+                                                                int options)
+{
+    // The list may contain objects of other documents, so their out lists
+    // must be unchanged, too. Changed out lists of this document are patched.
+    auto isCurrent = [this, doc, options]() {
+        if (sortedOptions != options) {
+            return false;
+        }
+        auto docs = GetApplication().getDocuments();
+        return std::ranges::all_of(sortedGenerations, [doc, &docs](const auto& it) {
+            return std::ranges::find(docs, it.first) != docs.end()
+                && (it.first == doc || it.first->getOutListGeneration() == it.second);
+        });
+    };
+    if (isCurrent()) {
+        if (outListChanged.empty()) {
+            ++depCacheStats.hits;
+            return sortedObjects;
+        }
+        if (patchSortedDependencyList(options)) {
+            ++depCacheStats.patches;
+            return sortedObjects;
+        }
+    }
+
+    Base::TimeElapsed start;
+    // invalidate first in case getDependencyList() throws on cycles
+    clearDependencyCache();
+    auto objects = Document::getDependencyList(objectArray, options);
+    sortedGenerations.emplace_back(doc, doc->getOutListGeneration());
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        auto obj = objects[i];
+        sortedIndex[obj] = i;
+        auto objDoc = obj->getDocument();
+        if (objDoc && objDoc != doc) {
+            sortedExternal.push_back(obj);
+            if (std::ranges::find(sortedGenerations, objDoc, [](const auto& it) {
+                    return it.first;
+                }) == sortedGenerations.end()) {
+                sortedGenerations.emplace_back(objDoc, objDoc->getOutListGeneration());
+            }
+        }
+    }
+    sortedObjects = std::move(objects);
+    sortedOptions = options;
+
+    double elapsed = Base::TimeElapsed::diffTimeF(start);
+    ++depCacheStats.misses;
+    depCacheStats.buildTime += elapsed;
+    depCacheStats.lastBuildTime = elapsed;
+    return sortedObjects;
+}
+
+// Patch the sorted list for the objects whose out list changed since it was
+// built. A removed dependency keeps the order valid. A new dependency on an
+// object sorted after the dependent object only reorders the objects between
+// the two, see reorderSortedRange(). The list must be rebuilt instead if it
+// contains objects of other documents, whose presence depends on the out
+// lists, if a new dependency is not in the list yet or if there is a cycle.
+bool DocumentP::patchSortedDependencyList(int options)
+{
+    std::vector<const DocumentObject*> changed;
+    changed.swap(outListChanged);
+    if (!sortedExternal.empty()) {
+        return false;
+    }
+
+    const int op = ((options & Document::DepNoXLinked) != 0) ? DocumentObject::OutListNoXLinked : 0;
+    for (auto obj : changed) {
+        auto it = sortedIndex.find(obj);
+        if (it == sortedIndex.end()) {
+            return false;
+        }
+        for (auto dep : obj->getOutList(op)) {
+            if (!dep || !dep->isAttachedToDocument()) {
+                continue;
+            }
+            auto jt = sortedIndex.find(dep);
+            if (jt == sortedIndex.end() || dep == obj) {
+                return false;
+            }
+            // the dependencies come first, reordering changes the positions
+            if (jt->second > it->second && !reorderSortedRange(it->second, jt->second, op)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The object at lower now depends on the object at upper. Only objects between
+// the two can be affected (Pearce and Kelly): the object at upper and the ones
+// of the range it depends on are moved before the object at lower and the ones
+// of the range depending on it. Their positions are reused, so all others keep
+// theirs. Returns false on a cycle.
+bool DocumentP::reorderSortedRange(std::size_t lower, std::size_t upper, int op)
+{
+    std::size_t size = upper - lower + 1;
+    auto positionInRange = [&](const DocumentObject* obj, std::size_t end) -> std::size_t {
+        auto it = sortedIndex.find(obj);
+        if (it == sortedIndex.end() || it->second < lower || it->second >= end) {
+            return size;
+        }
+        return it->second - lower;
+    };
+
+    // the objects depending on the one at lower, in order of the list
+    std::vector<char> dependent(size, 0);
+    dependent[0] = 1;
+    for (std::size_t i = 1; i < size; ++i) {
+        for (auto dep : sortedObjects[lower + i]->getOutList(op)) {
+            std::size_t pos = positionInRange(dep, lower + i);
+            if (pos < size && dependent[pos]) {
+                dependent[i] = 1;
+                break;
+            }
+        }
+    }
+    if (dependent[size - 1]) {
+        return false;
+    }
+
+    // the objects the one at upper depends on, in reverse order of the list
+    std::vector<char> required(size, 0);
+    required[size - 1] = 1;
+    for (std::size_t i = size; i-- > 1;) {
+        if (!required[i]) {
+            continue;
+        }
+        for (auto dep : sortedObjects[lower + i]->getOutList(op)) {
+            std::size_t pos = positionInRange(dep, lower + i);
+            if (pos < size) {
+                required[pos] = 1;
+            }
+        }
+    }
+
+    std::vector<std::size_t> slots;
+    std::vector<DocumentObject*> moved;
+    for (const auto& group : {required, dependent}) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (group[i]) {
+                slots.push_back(lower + i);
+                moved.push_back(sortedObjects[lower + i]);
+            }
+        }
+    }
+    std::ranges::sort(slots);
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        sortedObjects[slots[i]] = moved[i];
+        sortedIndex[moved[i]] = slots[i];
+    }
+    return true;
+}
+
+// Extend the already scheduled objects by the objects that must be recomputed
+// plus everything that (recursively) depends on them, in the order of the
+// cached sorted list. Objects outside of this cone would be skipped by the
+// recompute loop anyway. Only the objects touched or changed since the last
+// recompute and the objects of other documents are checked, not the whole list.
+std::vector<DocumentObject*>
+DocumentP::getRecomputeCone(const std::vector<DocumentObject*>& scheduled) const
+{
+    std::unordered_set<DocumentObject*> cone(scheduled.begin(), scheduled.end());
+    std::vector<DocumentObject*> pending;
+    auto addObject = [&](DocumentObject* obj) {
+        if (cone.insert(obj).second) {
+            pending.push_back(obj);
+        }
+    };
+    auto addTouched = [&](DocumentObject* obj) {
+        if (obj->isAttachedToDocument() && (obj->isTouched() || obj->mustRecompute())) {
+            addObject(obj);
+        }
+    };
+    // the candidates are looked up first, so removed objects are never accessed
+    for (auto obj : recomputeCandidates) {
+        auto it = sortedIndex.find(obj);
+        if (it != sortedIndex.end()) {
+            addTouched(sortedObjects[it->second]);
+        }
+    }
+    for (auto obj : sortedExternal) {
+        addTouched(obj);
+    }
+    while (!pending.empty()) {
+        auto obj = pending.back();
+        pending.pop_back();
+        for (auto inObj : obj->getInList()) {
+            if (inObj && sortedIndex.contains(inObj)) {
+                addObject(inObj);
+            }
+        }
+    }
+
+    std::vector<DocumentObject*> ret(cone.begin(), cone.end());
+    std::ranges::sort(ret, {}, [this](DocumentObject* obj) {
+        auto it = sortedIndex.find(obj);
+        return it != sortedIndex.end() ? it->second : sortedIndex.size();
+    });
+    return ret;
+}
+
+void DocumentP::pruneRecomputeCandidates()
+{
+    std::erase_if(recomputeCandidates, [](const DocumentObject* obj) {
+        return !obj->isTouched() && !obj->mustRecompute();
+    });
+}
+
 /*!
   Does almost the same as topologicalSort() until no object with an input degree of zero
   can be found. It then searches for objects with an output degree of zero until neither
@@ -2978,13 +3287,22 @@ const char* Document::getErrorDescription(const DocumentObject* Obj) const
 }
 
 // call the recompute of the Feature and handle the exceptions and errors.
-int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
+int Document::_recomputeFeature(DocumentObject* Feat, // NOLINT
+                                 bool inputsEvaluated,
+                                 const std::exception_ptr& prepareError)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
+    RecomputeProfiler::Record record(d->profiler, Feat);
     DocumentObjectExecReturn* returnCode = nullptr;
     try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        if (prepareError) {
+            std::rethrow_exception(prepareError);
+        }
+        if (!inputsEvaluated) {
+            returnCode =
+                Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        }
         if (returnCode == DocumentObject::StdReturn) {
             returnCode = Feat->recompute();
             if (returnCode == DocumentObject::StdReturn) {
@@ -3035,6 +3353,149 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     return 0;
 }
 
+// Recompute the objects of a sorted dependency list level by level. Objects of
+// the same level do not depend on each other, so the prepareRecompute() of the
+// ones supporting it runs on worker threads while the calling (main) thread
+// recomputes the remaining objects of the level. Everything that changes a
+// property or fires a signal, i.e. expression evaluation, execute(), touching
+// of dependent objects and error filtering, is done in the main thread. An
+// exception thrown by prepareRecompute() is reported there like one thrown by
+// execute().
+bool Document::_recomputeConcurrent(const std::vector<DocumentObject*>& topoSortedObjects,
+                                    std::set<DocumentObject*>& filter,
+                                    Base::SequencerLauncher* seq,
+                                    bool* hasError,
+                                    int& objectCount)
+{
+    ParameterGrp::handle hGrp =
+        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    int numThreads = hGrp->GetInt("RecomputeThreads", 0);
+    if (numThreads <= 0) {
+        numThreads = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // The list is sorted with dependencies first, so the level of each
+    // object's OutList is known once the object itself is visited.
+    std::unordered_map<DocumentObject*, std::size_t> levelMap;
+    std::vector<std::vector<DocumentObject*>> levels;
+    for (auto obj : topoSortedObjects) {
+        std::size_t level = 0;
+        for (auto dep : obj->getOutList()) {
+            auto it = levelMap.find(dep);
+            if (it != levelMap.end()) {
+                level = std::max(level, it->second + 1);
+            }
+        }
+        levelMap[obj] = level;
+        if (level >= levels.size()) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(obj);
+    }
+
+    for (const auto& level : levels) {
+        std::vector<DocumentObject*> workerObjs;
+        std::vector<DocumentObject*> mainObjs;
+        std::unordered_map<DocumentObject*, int> results;
+        for (auto obj : level) {
+            if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+                continue;
+            }
+            // ask the object if it should be recomputed
+            if (!obj->mustRecompute()) {
+                continue;
+            }
+            ++objectCount;
+            results[obj] = 0;
+            if (obj->canRecomputeConcurrently() && _evaluateInputs(obj)) {
+                workerObjs.push_back(obj);
+            }
+            else {
+                mainObjs.push_back(obj);
+            }
+        }
+
+        std::vector<std::future<void>> futures;
+        std::vector<std::exception_ptr> errors(workerObjs.size());
+        std::atomic<std::size_t> next {0};
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < workerObjs.size(); i = next++) {
+                try {
+                    workerObjs[i]->prepareRecompute();
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        int numWorkers = std::min<int>(numThreads, static_cast<int>(workerObjs.size()));
+        futures.reserve(numWorkers);
+        for (int i = 0; i < numWorkers; ++i) {
+            futures.push_back(std::async(std::launch::async, worker));
+        }
+
+        for (auto obj : mainObjs) {
+            results[obj] = _recomputeFeature(obj);
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+        for (std::size_t i = 0; i < workerObjs.size(); ++i) {
+            results[workerObjs[i]] = _recomputeFeature(workerObjs[i], true, errors[i]);
+        }
+
+        for (auto obj : level) {
+            if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+                continue;
+            }
+            auto it = results.find(obj);
+            bool doRecompute = it != results.end();
+            if (doRecompute && it->second != 0) {
+                if (hasError) {
+                    *hasError = true;
+                }
+                if (it->second < 0) {
+                    return false;
+                }
+                // if something happened filter all object in its
+                // inListRecursive from the queue then proceed
+                obj->getInListEx(filter, true);
+                filter.insert(obj);
+                continue;
+            }
+            if (obj->isTouched() || doRecompute) {
+                signalRecomputedObject(*obj);
+                obj->purgeTouched();
+                // set all dependent object touched to force recompute
+                for (auto inObjIt : obj->getInList()) {
+                    inObjIt->enforceRecompute();
+                }
+            }
+            if (seq) {
+                seq->next(true);
+            }
+        }
+    }
+    return true;
+}
+
+bool Document::_evaluateInputs(DocumentObject* Feat)
+{
+    try {
+        DocumentObjectExecReturn* returnCode =
+            Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        if (returnCode == DocumentObject::StdReturn) {
+            return true;
+        }
+        delete returnCode;
+    }
+    catch (...) {
+        // reported when the object is recomputed in the main thread
+    }
+    return false;
+}
+
 bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
 {
     // delete recompute log
@@ -3165,6 +3626,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName, Add
     }
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->clearDependencyCache();
      
      // do no transactions if we do a rollback!
     if (!d->rollback) {
@@ -3293,6 +3755,7 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
     // remove from map
     pcObject->setStatus(ObjectStatus::Remove, false);  // Unset the bit to be on the safe side
     d->objectIdMap.erase(pcObject->_Id);
+    d->recomputeCandidates.erase(pcObject);
     d->objectNameManager.removeExactName(pos->first);
     unregisterLabel(pcObject->Label.getStrValue());
 
@@ -3323,6 +3786,7 @@ void Document::_removeObject(DocumentObject* pcObject, RemoveObjectOptions optio
          ++it) {
         if (*it == pcObject) {
             d->objectArray.erase(it);
+            d->clearDependencyCache();
             break;
         }
     }
@@ -35,14 +35,17 @@
 #include "PropertyStandard.h"
 #include "ExportInfo.h"
 
+#include <exception>
 #include <map>
 #include <vector>
 #include <utility>
 #include <list>
+#include <set>
 #include <string>
 
 namespace Base
 {
+class SequencerLauncher;
 class Writer;
 }
 
@@ -80,6 +83,7 @@ class DocumentObject;
 class DocumentObjectExecReturn;
 class Document;
 class DocumentPy;
+class RecomputeProfiler;
 class Application;
 class Transaction;
 class StringHasher;
@@ -157,6 +161,8 @@ public:
     PropertyBool ShowHidden;
     /// Whether to use hasher on topological naming
     PropertyBool UseHasher;
+    /// Whether to save shapes in the binary format instead of text BRep
+    PropertyBool BinaryBrep;
     //@}
 
     /** @name Signals of the document */
@@ -555,6 +561,33 @@ public:
     static std::vector<DocumentObject*>
     getDependencyList(const std::vector<DocumentObject*>& objs, int options = 0);
 
+    /// Statistics of the cached sorted dependency list used by recompute()
+    struct DependencyCacheStats
+    {
+        /// number of times the cached list was reused
+        unsigned long hits = 0;
+        /// number of times the list had to be rebuilt
+        unsigned long misses = 0;
+        /// number of times the list was patched for changed out lists instead of rebuilt
+        unsigned long patches = 0;
+        /// accumulated time in seconds spent on rebuilding the list
+        double buildTime = 0.0;
+        /// time in seconds spent on the last rebuild
+        double lastBuildTime = 0.0;
+        /// number of objects scheduled by the last recompute
+        std::size_t lastRecomputeSize = 0;
+    };
+    /// Get the statistics of the dependency list cache
+    const DependencyCacheStats& getDependencyCacheStats() const;
+    /// Get a counter that is increased whenever the out list of an object of this document changes
+    unsigned long getOutListGeneration() const;
+
+    /// Enable or disable recording the timing of each object on recompute
+    void setRecomputeProfiling(bool on);
+    bool isRecomputeProfiling() const;
+    /// Get the profile recorded by the last recompute
+    const RecomputeProfiler& getRecomputeProfiler() const;
+
     std::vector<Document*> getDependentDocuments(bool sort = true);
     static std::vector<Document*> getDependentDocuments(std::vector<Document*> docs,
                                                              bool sort);
@@ -675,9 +708,27 @@ protected:
     void onBeforeChangeProperty(const TransactionalObject* Who, const Property* What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject* Who, const Property* What);
+    /// callback from the Document objects after their out list has changed
+    void _onOutListChanged(const DocumentObject* obj);
+    /// callback from the Document objects after they were touched or changed
+    void _addRecomputeCandidate(const DocumentObject* obj);
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
-    int _recomputeFeature(DocumentObject* Feat);
+    /// If inputsEvaluated is true the non-output expressions were already executed.
+    /// If prepareError is set it is reported instead of recomputing the feature.
+    int _recomputeFeature(DocumentObject* Feat,
+                          bool inputsEvaluated = false,
+                          const std::exception_ptr& prepareError = nullptr);
+    /// helper which executes the non-output expressions of a feature
+    /// @return false if an expression failed.
+    bool _evaluateInputs(DocumentObject* Feat);
+    /// helper which recomputes independent objects of a sorted dependency list concurrently
+    /// @return false if aborted by user.
+    bool _recomputeConcurrent(const std::vector<DocumentObject*>& topoSortedObjects,
+                              std::set<DocumentObject*>& filter,
+                              Base::SequencerLauncher* seq,
+                              bool* hasError,
+                              int& objectCount);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -1,6 +1,6 @@
 from PropertyContainer import PropertyContainer
 from DocumentObject import DocumentObject
-from typing import Final, List, Tuple, Sequence
+from typing import Final, List, Tuple, Sequence, Union
 
 
 class Document(PropertyContainer):
@@ -332,6 +332,43 @@ class Document(PropertyContainer):
         """
         ...
 
+    def getDependencyCacheStats(self) -> dict:
+        """
+        getDependencyCacheStats() -> dict
+
+        Return statistics of the cached dependency list used by recompute().
+        The dictionary contains the number of cache 'Hits' and 'Misses', the
+        number of times the list was patched for changed links ('Patches'), the
+        accumulated and last rebuild time in seconds ('BuildTime', 'LastBuildTime')
+        and the number of objects scheduled by the last recompute ('LastRecomputeSize').
+        """
+        ...
+
+    def setRecomputeProfiling(self, on: bool) -> None:
+        """
+        setRecomputeProfiling(on) -> None
+
+        Enable or disable recording the recompute time of each object.
+        The profile of the last recompute is returned by recomputeProfile().
+        """
+        ...
+
+    def recomputeProfile(self, format: str = "dict") -> Union[dict, str]:
+        """
+        recomputeProfile(format='dict') -> dict or str
+
+        Return the profile recorded by the last recompute while profiling was
+        enabled with setRecomputeProfiling().
+        format: 'dict' returns a dictionary, 'json' a JSON string and 'chrome'
+        a string in the Chrome trace event format that can be loaded into
+        chrome://tracing or Perfetto.
+        For each recomputed object the profile lists the wall time, the change
+        of the resident memory, the reason for the recompute and whether the
+        object is on the critical path, i.e. the chain of dependent objects with
+        the longest accumulated recompute time.
+        """
+        ...
+
     def mustExecute(self) -> bool:
         """
         Check if any object must be recomputed
@@ -220,6 +220,7 @@ void DocumentObject::touch(bool noRecompute)
     }
     StatusBits.set(ObjectStatus::Touch);
     if (_pDoc) {
+        _pDoc->_addRecomputeCandidate(this);
         _pDoc->signalTouchedObject(*this);
     }
 }
@@ -872,6 +873,11 @@ void DocumentObject::onChanged(const Property* prop)
         _pDoc->signalRelabelObject(*this);
     }
 
+    // any change may let mustExecute() return true, see Document::recompute()
+    if (_pDoc) {
+        _pDoc->_addRecomputeCandidate(this);
+    }
+
     // set object touched if it is an input property
     if (!testStatus(ObjectStatus::NoTouch) && !(prop->getType() & Prop_Output)
         && !prop->testStatus(Property::Output)) {
@@ -901,6 +907,9 @@ void DocumentObject::clearOutListCache() const
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    if (_pDoc) {
+        _pDoc->_onOutListChanged(this);
+    }
 }
 
 PyObject* DocumentObject::getPyObject()
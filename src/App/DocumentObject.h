@@ -517,6 +517,30 @@ public:
     {
         return false;
     }
+
+    /** Return true if this object implements prepareRecompute()
+     *
+     * Only consulted when parallel recompute is enabled in the document
+     * preferences. Objects returning false (the default) are recomputed
+     * entirely in the main thread.
+     */
+    virtual bool canRecomputeConcurrently() const
+    {
+        return false;
+    }
+    /** Do the expensive part of the next execute() on a worker thread
+     *
+     * Called for objects returning true from canRecomputeConcurrently() after
+     * the expressions of their input properties were evaluated. The method
+     * must not change any property, run Python code or touch GUI resources,
+     * and must only read properties of this object and of objects in its
+     * OutList. The result is kept by the object and applied by execute(),
+     * which is still called in the main thread, so all property changes and
+     * signals stay there. An exception thrown by this method is reported
+     * as a recompute error of the object and execute() is not called.
+     */
+    virtual void prepareRecompute()
+    {}
     /// Handle Label changes, including forcing unique label values,
     /// signalling OnBeforeLabelChange, and arranging to update linked references,
     /// on the assumption that after returning the label will indeed be changed to
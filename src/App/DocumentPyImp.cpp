@@ -31,6 +31,7 @@
 #include "DocumentObject.h"
 #include "DocumentObjectPy.h"
 #include "MergeDocuments.h"
+#include "RecomputeProfiler.h"
 
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
@@ -736,6 +737,86 @@ PyObject* DocumentPy::recompute(PyObject* args)
     PY_CATCH;
 }
 
+PyObject* DocumentPy::getDependencyCacheStats(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    const auto& stats = getDocumentPtr()->getDependencyCacheStats();
+    Py::Dict dict;
+    dict.setItem("Hits", Py::Long(stats.hits));
+    dict.setItem("Misses", Py::Long(stats.misses));
+    dict.setItem("Patches", Py::Long(stats.patches));
+    dict.setItem("BuildTime", Py::Float(stats.buildTime));
+    dict.setItem("LastBuildTime", Py::Float(stats.lastBuildTime));
+    dict.setItem("LastRecomputeSize", Py::Long(static_cast<unsigned long>(stats.lastRecomputeSize)));
+    return Py::new_reference_to(dict);
+}
+
+PyObject* DocumentPy::setRecomputeProfiling(PyObject* args)
+{
+    PyObject* on {};
+    if (!PyArg_ParseTuple(args, "O!", &PyBool_Type, &on)) {
+        return nullptr;
+    }
+    getDocumentPtr()->setRecomputeProfiling(Base::asBoolean(on));
+    Py_Return;
+}
+
+PyObject* DocumentPy::recomputeProfile(PyObject* args)
+{
+    const char* format = "dict";
+    if (!PyArg_ParseTuple(args, "|s", &format)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const auto& profiler = getDocumentPtr()->getRecomputeProfiler();
+        std::string fmt(format);
+        if (fmt == "json" || fmt == "chrome") {
+            std::stringstream str;
+            if (fmt == "json") {
+                profiler.exportJson(str);
+            }
+            else {
+                profiler.exportChromeTrace(str);
+            }
+            return Py::new_reference_to(Py::String(str.str()));
+        }
+        if (fmt != "dict") {
+            PyErr_Format(PyExc_ValueError, "Unknown format '%s'", format);
+            return nullptr;
+        }
+
+        Py::List objects;
+        for (const auto& entry : profiler.getEntries()) {
+            Py::Dict item;
+            item.setItem("Name", Py::String(entry.name));
+            item.setItem("Label", Py::String(entry.label));
+            item.setItem("Reason", Py::String(entry.reason));
+            item.setItem("Start", Py::Float(entry.start));
+            item.setItem("Duration", Py::Float(entry.duration));
+            item.setItem("MemoryDelta", Py::Long(static_cast<long>(entry.memoryDelta)));
+            item.setItem("Thread", Py::Long(entry.thread));
+            item.setItem("Error", Py::Boolean(entry.error));
+            item.setItem("Critical", Py::Boolean(entry.critical));
+            objects.append(item);
+        }
+        Py::List path;
+        for (const auto& name : profiler.getCriticalPath()) {
+            path.append(Py::String(name));
+        }
+        Py::Dict dict;
+        dict.setItem("TotalTime", Py::Float(profiler.getTotalTime()));
+        dict.setItem("CriticalPathTime", Py::Float(profiler.getCriticalPathTime()));
+        dict.setItem("CriticalPath", path);
+        dict.setItem("Objects", objects);
+        return Py::new_reference_to(dict);
+    }
+    PY_CATCH;
+}
+
 PyObject* DocumentPy::mustExecute(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -1,5 +1,6 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <cstring>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -14,8 +15,6 @@
 #include "Document.h"
 #include "DocumentObject.h"
 
-#include <boost/algorithm/string/classification.hpp>
-#include <boost/algorithm/string/split.hpp>
 #include <boost/io/ios_state.hpp>
 
 
@@ -45,6 +44,20 @@ namespace Data
 static std::unordered_map<const ElementMap*, unsigned> _elementMapToId;
 static std::unordered_map<unsigned, ElementMapPtr> _idToElementMap;
 
+// Splits a saved entry in place at '.' so that the tokens can be parsed
+// without allocating a string for each of them.
+static void splitEntry(std::string& entry, std::vector<const char*>& tokens)
+{
+    tokens.clear();
+    tokens.push_back(entry.c_str());
+    for (auto& ch : entry) {
+        if (ch == '.') {
+            ch = '\0';
+            tokens.push_back(&ch + 1);
+        }
+    }
+}
+
 
 void ElementMap::init()
 {
@@ -250,11 +263,13 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef, std::istream
         return map;
     }
 
-    std::vector<std::string> postfixes;
+    // The postfixes are kept as implicitly shared byte arrays, so that all
+    // restored names with the same postfix share a single copy of it.
+    std::vector<QByteArray> postfixes;
     postfixes.reserve(count);
     for (int i = 0; i < count; ++i) {
-        postfixes.emplace_back();
-        stream >> postfixes.back();
+        stream >> tmp;
+        postfixes.emplace_back(tmp.c_str(), static_cast<int>(tmp.size()));
     }
 
     std::vector<ElementMapPtr> childMaps;
@@ -275,7 +290,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef, std::istream
 ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                                   std::istream& stream,
                                   std::vector<ElementMapPtr>& childMaps,
-                                  const std::vector<std::string>& postfixes)
+                                  const std::vector<QByteArray>& postfixes)
 {
     const char* msg = "Invalid element map";
     const int hexBase {16};
@@ -306,7 +321,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
     const char* hasherIDWarn = nullptr;
     const char* postfixWarn = nullptr;
     const char* childSIDWarn = nullptr;
-    std::vector<std::string> tokens;
+    std::vector<const char*> tokens;
 
     for (int i = 0; i < typeCount; ++i) {
         int outerCount = 0;
@@ -357,8 +372,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                 FC_THROWM(Base::RuntimeError, "Invalid element child string id");  // NOLINT
             }
 
-            tokens.clear();
-            boost::split(tokens, tmp, boost::is_any_of("."));
+            splitEntry(tmp, tokens);
             if (tokens.size() > 1) {
                 child.sids.reserve(static_cast<int>(tokens.size()) - 1);
                 for (unsigned k = 1; k < tokens.size(); ++k) {
@@ -366,7 +380,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     // instead of hex by accident. To simplify maintenance
                     // of backward compatibility, it is not corrected, and
                     // just restored as decimal here.
-                    long childID = strtol(tokens[k].c_str(), nullptr, decBase);
+                    long childID = strtol(tokens[k], nullptr, decBase);
                     auto sid = hasherRef->getID(childID);
                     if (!sid) {
                         childSIDWarn = "Missing element child string id";
@@ -401,8 +415,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     ref->next = std::make_unique<MappedNameRef>();
                     ref = ref->next.get();
                 }
-                tokens.clear();
-                boost::split(tokens, tmp, boost::is_any_of("."));
+                splitEntry(tmp, tokens);
                 if (tokens.size() < 2) {
                     FC_THROWM(Base::RuntimeError, "Invalid element entry");  // NOLINT
                 }
@@ -417,29 +430,29 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                             FC_THROWM(Base::RuntimeError, "Invalid element entry");  // NOLINT
                         }
                         ++offset;
-                        long elementNameIndex = strtol(tokens[0].c_str() + 1, nullptr, hexBase);
+                        long elementNameIndex = strtol(tokens[0] + 1, nullptr, hexBase);
                         if (elementNameIndex <= 0 || elementNameIndex > (int)postfixes.size()) {
                             FC_THROWM(Base::RuntimeError, "Invalid element name index");  // NOLINT
                         }
-                        long elementIndex = strtol(tokens[1].c_str(), nullptr, hexBase);
+                        long elementIndex = strtol(tokens[1], nullptr, hexBase);
                         ref->name = MappedName(
-                            IndexedName::fromConst(postfixes[elementNameIndex - 1].c_str(),
+                            IndexedName::fromConst(postfixes[elementNameIndex - 1].constData(),
                                                    static_cast<int>(elementIndex)));
                         break;
                     }
                     case '$':
-                        ref->name = MappedName(tokens[0].c_str() + 1);
+                        ref->name = MappedName(tokens[0] + 1);
                         prefixID = ::App::StringID::fromString(ref->name.dataBytes());
                         break;
                     case ';':
-                        ref->name = MappedName(tokens[0].c_str() + 1);
+                        ref->name = MappedName(tokens[0] + 1);
                         break;
                     default:
                         FC_THROWM(Base::RuntimeError, "Invalid element name marker");  // NOLINT
                 }
 
-                if (tokens[offset] != "0") {
-                    long postfixIndex = strtol(tokens[offset].c_str(), nullptr, hexBase);
+                if (std::strcmp(tokens[offset], "0") != 0) {
+                    long postfixIndex = strtol(tokens[offset], nullptr, hexBase);
                     if (postfixIndex <= 0 || postfixIndex > (int)postfixes.size()) {
                         postfixWarn = "Invalid element postfix index";
                     }
@@ -468,7 +481,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     }
                 }
                 for (int l = offset + 1; l < (int)tokens.size(); ++l) {
-                    long readID = strtol(tokens[l].c_str(), nullptr, hexBase);
+                    long readID = strtol(tokens[l], nullptr, hexBase);
                     auto sid = hasherRef->getID(readID);
                     if (!sid) {
                         hasherIDWarn = "Invalid element name string id";
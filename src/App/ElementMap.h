@@ -231,7 +231,7 @@ private:
     ElementMapPtr restore(::App::StringHasherRef hasherRef,
                           std::istream& stream,
                           std::vector<ElementMapPtr>& childMaps,
-                          const std::vector<std::string>& postfixes);
+                          const std::vector<QByteArray>& postfixes);
 
     /** Associate the MappedName \c name with the IndexedName \c idx.
      * @param name: the name to add
@@ -371,3 +371,44 @@ DocumentObjectExecReturn* FeatureTestAttribute::execute()
     }
     return StdReturn;
 }
+
+// ----------------------------------------------------------------------------
+
+PROPERTY_SOURCE(App::FeatureTestConcurrent, App::DocumentObject)
+
+
+FeatureTestConcurrent::FeatureTestConcurrent()
+{
+    ADD_PROPERTY_TYPE(Source, (nullptr), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(Input, (0.0), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(Value, (0.0), "Test", Prop_Output, "");
+    ADD_PROPERTY_TYPE(Prepared, (false), "Test", Prop_Output, "");
+}
+
+bool FeatureTestConcurrent::canRecomputeConcurrently() const
+{
+    return true;
+}
+
+double FeatureTestConcurrent::compute() const
+{
+    double value = Input.getValue();
+    if (auto source = freecad_cast<FeatureTestConcurrent*>(Source.getValue())) {
+        value += source->Value.getValue();
+    }
+    return value;
+}
+
+void FeatureTestConcurrent::prepareRecompute()
+{
+    preparedBy = std::this_thread::get_id();
+    prepared = compute();
+}
+
+DocumentObjectExecReturn* FeatureTestConcurrent::execute()
+{
+    Prepared.setValue(prepared.has_value());
+    Value.setValue(prepared ? *prepared : compute());
+    prepared.reset();
+    return StdReturn;
+}
@@ -30,6 +30,9 @@
 #include "PropertyPythonObject.h"
 #include "PropertyUnits.h"
 
+#include <optional>
+#include <thread>
+
 
 namespace App
 {
@@ -218,6 +221,35 @@ public:
     App::PropertyString Attribute;
 };
 
+/// Adds Input to the Value of Source, prepared on a worker thread in a parallel recompute
+class FeatureTestConcurrent: public DocumentObject
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(App::FeatureTestConcurrent);
+
+public:
+    FeatureTestConcurrent();
+
+    App::PropertyLink Source;
+    App::PropertyFloat Input;
+    App::PropertyFloat Value;
+    App::PropertyBool Prepared;
+
+    /// the thread which ran the last prepareRecompute()
+    std::thread::id preparedBy;
+
+    /** @name methods override Feature */
+    //@{
+    bool canRecomputeConcurrently() const override;
+    void prepareRecompute() override;
+    DocumentObjectExecReturn* execute() override;
+    //@}
+
+private:
+    double compute() const;
+
+    std::optional<double> prepared;
+};
+
 
 }  // namespace App
 
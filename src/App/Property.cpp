@@ -51,6 +51,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::Property, Base::Persistence)
 // Construction/Destruction
 
 static std::atomic<int64_t> _PropID;
+static std::atomic<std::uint64_t> _ChangeStamp;
 
 // Here is the implementation! Description should take place in the header file!
 Property::Property()
@@ -256,6 +257,7 @@ void Property::touch()
 {
     PropertyCleaner guard(this);
     if (father) {
+        father->_changeStamp = ++_ChangeStamp;
         father->onEarlyChange(this);
         father->onChanged(this);
     }
@@ -271,6 +273,7 @@ void Property::hasSetValue()
 {
     PropertyCleaner guard(this);
     if (father) {
+        father->_changeStamp = ++_ChangeStamp;
         father->onChanged(this);
         if (!testStatus(Busy)) {
             Base::BitsetLocker<decltype(StatusBits)> guard(StatusBits, Busy);
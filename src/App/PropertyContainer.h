@@ -24,7 +24,9 @@
 #ifndef SRC_APP_PROPERTYCONTAINER_H_
 #define SRC_APP_PROPERTYCONTAINER_H_
 
+#include <atomic>
 #include <map>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 #include <string>
@@ -634,6 +636,19 @@ public:
       _propertyPrefix = prefix;
   }
 
+  /**
+   * @brief Get the change stamp of this container.
+   *
+   * Whenever a property of this container is changed or touched, the stamp is
+   * set to the next value of a process wide counter. Comparing stamps is a
+   * cheap way to find out whether any property changed in between.
+   *
+   * @return The change stamp, 0 if no property has been changed yet.
+   */
+  std::uint64_t getChangeStamp() const {
+      return _changeStamp;
+  }
+
   friend class Property;
   friend class DynamicProperty;
 
@@ -749,6 +764,7 @@ protected:
 
 private:
   std::string _propertyPrefix;
+  std::atomic<std::uint64_t> _changeStamp {0};
   static PropertyData propertyData;
 };
 
@@ -92,8 +92,144 @@ struct PropertyExpressionEngine::Private
     // defined in header, hence the private structure here.
     std::vector<boost::signals2::scoped_connection> conns;
     std::unordered_map<std::string, std::vector<ObjectIdentifier>> propMap;
+
+    /// Evaluation order of all bindings, valid until the expressions change
+    std::vector<ObjectIdentifier> evaluationOrder;
+    bool hasEvaluationOrder = false;
+
+    /// The result of the last evaluation of a binding together with the change
+    /// stamps its input objects had at that time. The inputs are kept by their
+    /// ID because they may be deleted in the meantime.
+    struct Evaluation
+    {
+        std::vector<std::pair<long, std::uint64_t>> inputs;
+        App::any value;
+        bool prunable = false;
+    };
+    std::map<ObjectIdentifier, Evaluation> evaluations;
+
+    void clearEvaluationCache()
+    {
+        evaluationOrder.clear();
+        hasEvaluationOrder = false;
+        evaluations.clear();
+    }
+
+    bool isUnchanged(const ObjectIdentifier& path,
+                     const Property* prop,
+                     const DocumentObject* owner) const
+    {
+        auto it = evaluations.find(path);
+        if (it == evaluations.end() || !it->second.prunable) {
+            return false;
+        }
+        for (const auto& input : it->second.inputs) {
+            auto obj = owner->getDocument()->getObjectByID(input.first);
+            if (!obj || obj->getChangeStamp() != input.second) {
+                return false;
+            }
+        }
+        // The bound property may have been changed directly in the meantime
+        return isAnyEqual(it->second.value, prop->getPathValue(path));
+    }
+
+    /// Adds \a obj and the objects it links to, directly or through other links
+    static void addLinkedInputs(DocumentObject* obj, std::set<DocumentObject*>& inputs)
+    {
+        while (obj && inputs.insert(obj).second) {
+            obj = obj->getLinkedObject(false);
+        }
+    }
+
+    void recordEvaluation(const ObjectIdentifier& path,
+                          const Expression& expression,
+                          const DocumentObject* owner,
+                          App::any&& value)
+    {
+        // The change stamp of a link or of the parent of a sub-object does not
+        // change with the values read through it. Therefore the inputs are all
+        // objects passed while reading the value, together with the objects
+        // they link to. They are collected again after each evaluation because
+        // a link may point to another object by now.
+        std::set<DocumentObject*> inputs;
+        bool prunable = true;
+        for (const auto& identifier : expression.getIdentifiers()) {
+            const ObjectIdentifier& var = identifier.first;
+            auto obj = var.getDocumentObject();
+            if (!obj) {
+                prunable = false;
+                break;
+            }
+            addLinkedInputs(obj, inputs);
+            const std::string& subname = var.getSubObjectName();
+            if (!subname.empty()) {
+                for (auto sobj : obj->getSubObjectList(subname.c_str())) {
+                    addLinkedInputs(sobj, inputs);
+                }
+            }
+            for (const auto& dep : var.getDep(true)) {
+                addLinkedInputs(dep.first, inputs);
+            }
+        }
+
+        // Only bindings whose inputs all resolve to objects of the owner
+        // document are pruned. Links to objects that do not exist (yet) or
+        // live in other documents may change without notice.
+        auto& evaluation = evaluations[path];
+        evaluation.inputs.clear();
+        evaluation.prunable = prunable;
+        if (prunable) {
+            for (auto obj : inputs) {
+                if (obj->getDocument() != owner->getDocument()) {
+                    evaluation.prunable = false;
+                    evaluation.inputs.clear();
+                    break;
+                }
+                evaluation.inputs.emplace_back(obj->getID(), obj->getChangeStamp());
+            }
+        }
+        if (evaluation.prunable) {
+            evaluation.value = std::move(value);
+        }
+        else {
+            evaluation.value = App::any();
+        }
+    }
 };
 
+/**
+ * @brief Check whether the binding of \a prop is executed with \a option.
+ */
+
+static bool isExecutedWith(const Property* prop, PropertyExpressionEngine::ExecuteOption option)
+{
+    if (option == PropertyExpressionEngine::ExecuteAll) {
+        return true;
+    }
+    bool is_output = prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
+    if ((is_output && option == PropertyExpressionEngine::ExecuteNonOutput)
+        || (!is_output && option == PropertyExpressionEngine::ExecuteOutput)) {
+        return false;
+    }
+    if (option == PropertyExpressionEngine::ExecuteOnRestore
+        && !prop->testStatus(Property::Transient) && !(prop->getType() & Prop_Transient)
+        && !prop->testStatus(Property::EvalOnRestore)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether bindings whose inputs did not change are skipped in execute().
+ */
+
+static bool skipUnchangedExpressions()
+{
+    static ParameterGrp::handle hGrp =
+        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    return hGrp->GetBool("SkipUnchangedExpressions", true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
 TYPESYSTEM_SOURCE(App::PropertyExpressionEngine, App::PropertyExpressionContainer)
@@ -144,6 +280,10 @@ Property* PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    if (pimpl) {
+        pimpl->clearEvaluationCache();
+    }
+
     App::DocumentObject* owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if (!owner || !owner->isAttachedToDocument() || owner->isRestoring()
         || testFlag(LinkDetached)) {
@@ -604,15 +744,7 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap& exprs,
             if (!prop) {
                 throw Base::RuntimeError("Path does not resolve to a property.");
             }
-            bool is_output =
-                prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
-            if ((is_output && option == ExecuteNonOutput)
-                || (!is_output && option == ExecuteOutput)) {
-                continue;
-            }
-            if (option == ExecuteOnRestore && !prop->testStatus(Property::Transient)
-                && !(prop->getType() & Prop_Transient)
-                && !prop->testStatus(Property::EvalOnRestore)) {
+            if (!isExecutedWith(prop, option)) {
                 continue;
             }
         }
@@ -670,6 +802,47 @@ PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
     return evaluationOrder;
 }
 
+/**
+ * The evaluation order of all expressions is computed once and cached until
+ * the expressions change. The order for a subset of the bindings is taken
+ * from it, because the topological order of a graph is also valid for any of
+ * its subgraphs.
+ */
+
+std::vector<App::ObjectIdentifier>
+PropertyExpressionEngine::getEvaluationOrder(ExecuteOption option)
+{
+    if (!pimpl) {
+        pimpl = std::make_unique<Private>();
+    }
+    if (!pimpl->hasEvaluationOrder) {
+        try {
+            pimpl->evaluationOrder = computeEvaluationOrder(ExecuteAll);
+        }
+        catch (Base::Exception&) {
+            // A cyclic dependency may be limited to bindings not executed with
+            // this option, so let the graph of the selected bindings decide.
+            return computeEvaluationOrder(option);
+        }
+        pimpl->hasEvaluationOrder = true;
+    }
+    if (option == ExecuteAll) {
+        return pimpl->evaluationOrder;
+    }
+
+    std::vector<App::ObjectIdentifier> evaluationOrder;
+    for (const auto& path : pimpl->evaluationOrder) {
+        auto prop = path.getProperty();
+        if (!prop) {
+            throw Base::RuntimeError("Path does not resolve to a property.");
+        }
+        if (isExecutedWith(prop, option)) {
+            evaluationOrder.push_back(path);
+        }
+    }
+    return evaluationOrder;
+}
+
 /**
  * @brief Compute and update values of all registered expressions.
  * @return StdReturn on success.
@@ -731,9 +904,14 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
     resetter r(running);
 
     // Compute evaluation order
-    std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
+    std::vector<App::ObjectIdentifier> evaluationOrder = option == ExecuteOnRestore
+        ? computeEvaluationOrder(option)
+        : getEvaluationOrder(option);
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
 
+    // Skip bindings whose input objects did not change since their last evaluation
+    bool skipUnchanged = option != ExecuteOnRestore && skipUnchangedExpressions();
+
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
     std::clog << "Computing expressions for " << getName() << std::endl;
 #endif
@@ -761,6 +939,9 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
             // Evaluate expression
             std::shared_ptr<App::Expression> expression = expressions[*it].expression;
             if (expression) {
+                if (skipUnchanged && pimpl->isUnchanged(*it, prop, docObj)) {
+                    continue;
+                }
                 value = expression->getValueAsAny();
 
                 // Enable value comparison for all expression bindings to reduce
@@ -777,6 +958,9 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                 // if (option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore))
                 {
                     if (isAnyEqual(value, prop->getPathValue(*it))) {
+                        if (skipUnchanged) {
+                            pimpl->recordEvaluation(*it, *expression, docObj, std::move(value));
+                        }
                         continue;
                     }
                     if (touched) {
@@ -784,6 +968,9 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                     }
                 }
                 prop->setPathValue(*it, value);
+                if (skipUnchanged) {
+                    pimpl->recordEvaluation(*it, *expression, docObj, std::move(value));
+                }
             }
         }
         catch (Base::Exception& e) {
@@ -1209,6 +1396,9 @@ void PropertyExpressionEngine::setExpressions(
 
 void PropertyExpressionEngine::onRelabeledDocument(const App::Document& doc)
 {
+    if (pimpl) {
+        pimpl->clearEvaluationCache();
+    }
     RelabelDocumentExpressionVisitor v(doc);
     for (auto& e : expressions) {
         if (e.second.expression) {
@@ -205,6 +205,7 @@ private:
 #endif
 
     std::vector<App::ObjectIdentifier> computeEvaluationOrder(ExecuteOption option);
+    std::vector<App::ObjectIdentifier> getEvaluationOrder(ExecuteOption option);
 
     void buildGraphStructures(const App::ObjectIdentifier& path,
                               const std::shared_ptr<Expression> expression,
@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************************************
+ *                                                                                                 *
+ *   Copyright (c) 2026 FreeCAD Project Association                                                *
+ *                                                                                                 *
+ *   This file is part of FreeCAD.                                                                 *
+ *                                                                                                 *
+ *   FreeCAD is free software: you can redistribute it and/or modify it under the terms of the     *
+ *   GNU Lesser General Public License as published by the Free Software Foundation, either        *
+ *   version 2.1 of the License, or (at your option) any later version.                            *
+ *                                                                                                 *
+ *   FreeCAD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;          *
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     *
+ *   See the GNU Lesser General Public License for more details.                                   *
+ *                                                                                                 *
+ *   You should have received a copy of the GNU Lesser General Public License along with           *
+ *   FreeCAD. If not, see <https://www.gnu.org/licenses/>.                                         *
+ *                                                                                                 *
+ **************************************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <fstream>
+#include <iomanip>
+#include <unordered_map>
+#endif
+
+#if defined(FC_OS_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(FC_OS_MACOSX)
+#include <mach/mach.h>
+#elif defined(FC_OS_LINUX) || defined(FC_OS_BSD)
+#include <unistd.h>
+#endif
+
+#include "RecomputeProfiler.h"
+#include "DocumentObject.h"
+
+
+using namespace App;
+
+namespace
+{
+
+double seconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+void writeString(std::ostream& str, const std::string& text)
+{
+    str << '"';
+    for (char ch : text) {
+        switch (ch) {
+            case '"':
+                str << "\\\"";
+                break;
+            case '\\':
+                str << "\\\\";
+                break;
+            case '\n':
+                str << "\\n";
+                break;
+            case '\r':
+                str << "\\r";
+                break;
+            case '\t':
+                str << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    str << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(ch) << std::dec << std::setfill(' ');
+                }
+                else {
+                    str << ch;
+                }
+                break;
+        }
+    }
+    str << '"';
+}
+
+std::string recomputeReason(DocumentObject* obj)
+{
+    std::string reason;
+    std::vector<Property*> props;
+    obj->getPropertyList(props);
+    for (auto prop : props) {
+        if (prop->isTouched() && prop->getName()) {
+            reason += reason.empty() ? "Changed: " : ", ";
+            reason += prop->getName();
+        }
+    }
+    if (reason.empty()) {
+        if (obj->testStatus(ObjectStatus::Enforce)) {
+            reason = "Enforced";
+        }
+        else if (obj->isTouched()) {
+            reason = "Touched";
+        }
+        else {
+            reason = "Must execute";
+        }
+    }
+    return reason;
+}
+
+}  // namespace
+
+RecomputeProfiler::Record::Record(RecomputeProfiler& prof, DocumentObject* obj)
+    : profiler(prof.isActive() ? &prof : nullptr)
+    , object(obj)
+{
+    if (this->profiler) {
+        reason = recomputeReason(obj);
+        memory = residentMemory();
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+RecomputeProfiler::Record::~Record()
+{
+    if (!profiler) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    Entry entry;
+    entry.name = object->getNameInDocument() ? object->getNameInDocument() : "";
+    entry.label = object->Label.getValue();
+    entry.reason = std::move(reason);
+    entry.start = seconds(start - profiler->startTime);
+    entry.duration = seconds(now - start);
+    entry.memoryDelta = residentMemory() - memory;
+    entry.error = object->isError();
+    profiler->addEntry(object, std::move(entry));
+}
+
+void RecomputeProfiler::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+void RecomputeProfiler::begin()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    objects.clear();
+    threads.clear();
+    criticalPath.clear();
+    criticalPathTime = 0.0;
+    totalTime = 0.0;
+    threads.emplace(std::this_thread::get_id(), 0);
+    startTime = std::chrono::steady_clock::now();
+    active = enabled;
+}
+
+void RecomputeProfiler::addEntry(DocumentObject* obj, Entry&& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto res = threads.emplace(std::this_thread::get_id(), static_cast<int>(threads.size()));
+    entry.thread = res.first->second;
+    entries.push_back(std::move(entry));
+    objects.push_back(obj);
+}
+
+void RecomputeProfiler::end()
+{
+    if (!active) {
+        return;
+    }
+    active = false;
+    totalTime = seconds(std::chrono::steady_clock::now() - startTime);
+
+    // Entries are recorded after their dependencies, so the longest chain ending
+    // at an entry is known once its dependencies have been visited. An object
+    // recomputed twice (e.g. in a second pass) uses its latest entry.
+    std::unordered_map<DocumentObject*, std::size_t> latest;
+    std::vector<double> finish(entries.size(), 0.0);
+    std::vector<std::size_t> previous(entries.size(), entries.size());
+    std::size_t last = entries.size();
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        double longest = 0.0;
+        for (auto dep : objects[i]->getOutList()) {
+            auto it = latest.find(dep);
+            if (it != latest.end() && finish[it->second] > longest) {
+                longest = finish[it->second];
+                previous[i] = it->second;
+            }
+        }
+        finish[i] = longest + entries[i].duration;
+        latest[objects[i]] = i;
+        if (last == entries.size() || finish[i] > finish[last]) {
+            last = i;
+        }
+    }
+
+    if (last != entries.size()) {
+        criticalPathTime = finish[last];
+        for (std::size_t i = last; i != entries.size(); i = previous[i]) {
+            entries[i].critical = true;
+            criticalPath.insert(criticalPath.begin(), entries[i].name);
+        }
+    }
+    objects.clear();
+}
+
+void RecomputeProfiler::exportJson(std::ostream& str) const
+{
+    str << "{\n  \"totalTime\": " << totalTime << ",\n  \"criticalPathTime\": "
+        << criticalPathTime << ",\n  \"criticalPath\": [";
+    for (std::size_t i = 0; i < criticalPath.size(); ++i) {
+        str << (i ? ", " : "");
+        writeString(str, criticalPath[i]);
+    }
+    str << "],\n  \"objects\": [";
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        str << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(str, entry.name);
+        str << ", \"label\": ";
+        writeString(str, entry.label);
+        str << ", \"reason\": ";
+        writeString(str, entry.reason);
+        str << ", \"start\": " << entry.start << ", \"duration\": " << entry.duration
+            << ", \"memoryDelta\": " << entry.memoryDelta << ", \"thread\": " << entry.thread
+            << ", \"error\": " << (entry.error ? "true" : "false")
+            << ", \"critical\": " << (entry.critical ? "true" : "false") << "}";
+    }
+    str << "\n  ]\n}\n";
+}
+
+void RecomputeProfiler::exportChromeTrace(std::ostream& str) const
+{
+    constexpr double microseconds = 1e6;
+    str << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        str << (i ? ",\n" : "\n") << "{\"name\": ";
+        writeString(str, entry.label);
+        str << ", \"cat\": \"" << (entry.critical ? "recompute,critical" : "recompute")
+            << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << entry.thread
+            << ", \"ts\": " << std::fixed << std::setprecision(3) << entry.start * microseconds
+            << ", \"dur\": " << entry.duration * microseconds << std::defaultfloat
+            << std::setprecision(6) << ", \"args\": {\"object\": ";
+        writeString(str, entry.name);
+        str << ", \"reason\": ";
+        writeString(str, entry.reason);
+        str << ", \"memoryDelta\": " << entry.memoryDelta
+            << ", \"error\": " << (entry.error ? "true" : "false") << "}}";
+    }
+    str << "\n]}\n";
+}
+
+std::int64_t RecomputeProfiler::residentMemory()
+{
+#if defined(FC_OS_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::int64_t>(counters.WorkingSetSize);
+    }
+    return 0;
+#elif defined(FC_OS_MACOSX)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(),
+                  MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info),  // NOLINT
+                  &count)
+        == KERN_SUCCESS) {
+        return static_cast<std::int64_t>(info.resident_size);
+    }
+    return 0;
+#elif defined(FC_OS_LINUX)
+    std::ifstream statm("/proc/self/statm");
+    std::int64_t size = 0;
+    std::int64_t resident = 0;
+    if (statm >> size >> resident) {
+        return resident * static_cast<std::int64_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************************************
+ *                                                                                                 *
+ *   Copyright (c) 2026 FreeCAD Project Association                                                *
+ *                                                                                                 *
+ *   This file is part of FreeCAD.                                                                 *
+ *                                                                                                 *
+ *   FreeCAD is free software: you can redistribute it and/or modify it under the terms of the     *
+ *   GNU Lesser General Public License as published by the Free Software Foundation, either        *
+ *   version 2.1 of the License, or (at your option) any later version.                            *
+ *                                                                                                 *
+ *   FreeCAD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;          *
+ *   without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     *
+ *   See the GNU Lesser General Public License for more details.                                   *
+ *                                                                                                 *
+ *   You should have received a copy of the GNU Lesser General Public License along with           *
+ *   FreeCAD. If not, see <https://www.gnu.org/licenses/>.                                         *
+ *                                                                                                 *
+ **************************************************************************************************/
+
+#ifndef APP_RECOMPUTE_PROFILER_H
+#define APP_RECOMPUTE_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace App
+{
+
+class DocumentObject;
+
+/** Records where the time of Document::recompute() goes
+ *
+ * For every recomputed object the wall time, the change of the resident memory
+ * of the process and the reason for the recompute are recorded. When the
+ * recompute is finished the critical path, i.e. the chain of dependent objects
+ * with the longest accumulated recompute time, is determined.
+ *
+ * @note With concurrent recompute the memory delta of an object includes the
+ * allocations of the objects recomputed at the same time.
+ */
+class AppExport RecomputeProfiler
+{
+public:
+    struct Entry
+    {
+        /// internal name of the object
+        std::string name;
+        std::string label;
+        /// why the object was recomputed, e.g. the names of its touched properties
+        std::string reason;
+        /// start time in seconds relative to the start of the recompute
+        double start {0.0};
+        /// wall time in seconds
+        double duration {0.0};
+        /// change of the resident memory in bytes
+        std::int64_t memoryDelta {0};
+        /// index of the thread the object was recomputed in, 0 is the main thread
+        int thread {0};
+        bool error {false};
+        bool critical {false};
+    };
+
+    /// Helper to time the recompute of a single object
+    class Record
+    {
+    public:
+        Record(RecomputeProfiler& profiler, DocumentObject* obj);
+        ~Record();
+
+        Record(const Record&) = delete;
+        Record(Record&&) = delete;
+        Record& operator=(const Record&) = delete;
+        Record& operator=(Record&&) = delete;
+
+    private:
+        RecomputeProfiler* profiler;
+        DocumentObject* object;
+        std::string reason;
+        std::chrono::steady_clock::time_point start;
+        std::int64_t memory {0};
+    };
+
+    void setEnabled(bool on);
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /// Clears the last profile and starts a new one
+    void begin();
+    /// Finishes the profile and computes the critical path
+    void end();
+    /// Returns true between begin() and end()
+    bool isActive() const
+    {
+        return active;
+    }
+
+    const std::vector<Entry>& getEntries() const
+    {
+        return entries;
+    }
+    /// Names of the objects on the critical path, dependencies first
+    const std::vector<std::string>& getCriticalPath() const
+    {
+        return criticalPath;
+    }
+    double getCriticalPathTime() const
+    {
+        return criticalPathTime;
+    }
+    double getTotalTime() const
+    {
+        return totalTime;
+    }
+
+    /// Writes the profile as JSON object
+    void exportJson(std::ostream& str) const;
+    /// Writes the profile in the Chrome trace event format (chrome://tracing, Perfetto)
+    void exportChromeTrace(std::ostream& str) const;
+
+    /// Returns the resident memory of the process in bytes or 0 if unknown
+    static std::int64_t residentMemory();
+
+private:
+    void addEntry(DocumentObject* obj, Entry&& entry);
+
+private:
+    bool enabled {false};
+    bool active {false};
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<Entry> entries;
+    /// the recorded objects, only valid until end() is called
+    std::vector<DocumentObject*> objects;
+    std::map<std::thread::id, int> threads;
+    std::vector<std::string> criticalPath;
+    double criticalPathTime {0.0};
+    double totalTime {0.0};
+    std::mutex mutex;
+};
+
+}  // namespace App
+
+#endif  // APP_RECOMPUTE_PROFILER_H
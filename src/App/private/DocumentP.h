@@ -30,6 +30,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -43,6 +44,7 @@
 #include <App/DocumentObserver.h>
 #include <App/StringHasher.h>
 #include <App/ExportInfo.h>
+#include <App/RecomputeProfiler.h>
 #include <Base/UniqueNameManager.h>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
@@ -96,8 +98,29 @@ struct DocumentP
     mutable HasherMap hashers;
     std::multimap<const App::DocumentObject*, std::unique_ptr<App::DocumentObjectExecReturn>>
         _RecomputeLog;
+    /// guards _RecomputeLog against concurrent recompute of independent objects
+    std::mutex recomputeLogMutex;
     ExportInfo exportInfo;
 
+    /// Sorted dependency list of all objects, reused until an out list or the
+    /// object array changes. See Document::getOutListGeneration().
+    std::vector<DocumentObject*> sortedObjects;
+    /// position of each object in sortedObjects
+    std::unordered_map<const DocumentObject*, std::size_t> sortedIndex;
+    /// objects of other documents in sortedObjects
+    std::vector<DocumentObject*> sortedExternal;
+    /// the documents of sortedObjects with their out list generation at build time
+    std::vector<std::pair<const Document*, unsigned long>> sortedGenerations;
+    int sortedOptions {-1};
+    Document::DependencyCacheStats depCacheStats;
+    /// increased whenever the out list of an object of this document changes
+    unsigned long outListGeneration {0};
+    /// objects of this document whose out list changed since sortedObjects was built
+    std::vector<const DocumentObject*> outListChanged;
+    /// objects touched or changed since the last recompute, the seeds of the recompute cone
+    std::unordered_set<const DocumentObject*> recomputeCandidates;
+    RecomputeProfiler profiler;
+
     StringHasherRef Hasher {new StringHasher};
 
     Document::PreRecomputeHook _preRecomputeHook;
@@ -120,6 +143,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
@@ -127,6 +151,7 @@ struct DocumentP
 
     void clearRecomputeLog(const App::DocumentObject* obj = nullptr)
     {
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
         if (!obj) {
             _RecomputeLog.clear();
         }
@@ -135,8 +160,27 @@ struct DocumentP
         }
     }
 
+    void clearDependencyCache()
+    {
+        sortedObjects.clear();
+        sortedIndex.clear();
+        sortedExternal.clear();
+        sortedGenerations.clear();
+        sortedOptions = -1;
+        outListChanged.clear();
+    }
+
+    std::vector<App::DocumentObject*> getSortedDependencyList(const Document* doc, int options);
+    bool patchSortedDependencyList(int options);
+    bool reorderSortedRange(std::size_t lower, std::size_t upper, int op);
+    std::vector<App::DocumentObject*>
+    getRecomputeCone(const std::vector<App::DocumentObject*>& scheduled) const;
+    void pruneRecomputeCandidates();
+
     void clearDocument()
     {
+        clearDependencyCache();
+        recomputeCandidates.clear();
         objectLabelManager.clear();
         objectArray.clear();
         for (auto& v : objectMap) {
@@ -74,6 +74,12 @@ void Persistence::SaveDocFile(Writer& /*writer*/) const
 void Persistence::RestoreDocFile(Reader& /*reader*/)
 {}
 
+std::function<void()> Persistence::RestoreDocFileConcurrently(Reader& reader)
+{
+    RestoreDocFile(reader);
+    return {};
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
@@ -24,6 +24,8 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <functional>
+
 #include "BaseClass.h"
 
 namespace Base
@@ -145,6 +147,32 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Return true if SaveDocFile() may be called from a worker thread.
+     * The ZipWriter then serializes the file in parallel to other files.
+     * SaveDocFile() must only read data of this object and must neither
+     * access Python, GUI nor parameter groups. The default returns false.
+     */
+    virtual bool canSaveDocFileConcurrently() const
+    {
+        return false;
+    }
+    /** Return true if the data file of this object may be decoded on a worker thread.
+     * The XMLReader then reads the file into memory and passes it to
+     * RestoreDocFileConcurrently() in parallel to other files. The default returns false.
+     */
+    virtual bool canRestoreDocFileConcurrently() const
+    {
+        return false;
+    }
+    /** Decodes the data file on a worker thread.
+     * It must only decode the data into a temporary and neither access the object
+     * itself nor Python, GUI, console or parameter groups. The returned function is
+     * called by the thread that restores the document, in the order the files were
+     * requested, to apply the decoded data. Files of objects that are not restored
+     * concurrently may have been restored in the meantime.
+     * The default calls RestoreDocFile() and returns an empty function.
+     */
+    virtual std::function<void()> RestoreDocFileConcurrently(Reader& reader);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
@@ -24,10 +24,16 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <map>
 #include <vector>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 #include <xercesc/sax2/Attributes.hpp>
 #endif
@@ -457,6 +463,46 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // project file was created without GUI
         return;
     }
+
+    int threads = ThreadCount;
+    if (threads <= 0) {
+        threads = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // Files of objects that can be restored concurrently are read into memory and
+    // decoded by worker threads. The decoded data is applied in the order of the
+    // files, at the latest when the number of pending files exceeds a limit.
+    struct PendingFile
+    {
+        std::string FileName;
+        std::string EntryName;
+        std::future<std::function<void()>> Result;
+    };
+    std::deque<PendingFile> pending;
+    auto finishFile = [&]() {
+        PendingFile file = std::move(pending.front());
+        pending.pop_front();
+        try {
+            auto apply = file.Result.get();
+            if (apply) {
+                apply();
+            }
+        }
+        catch (...) {
+            Base::Console().error("Reading failed from embedded file: %s\n",
+                                  file.EntryName.c_str());
+            FailedFiles.push_back(file.FileName);
+        }
+    };
+    auto decodeFile = [this](Base::Persistence* object,
+                             const std::string& fileName,
+                             const std::string& data) {
+        std::istringstream str(data);
+        Base::Reader reader(str, fileName, FileVersion);
+        reader.setArchiveFileName(ArchiveFileName);
+        return object->RestoreDocFileConcurrently(reader);
+    };
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -468,11 +514,37 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         }
         // If this condition is true both file names match and we can read-in the data, otherwise
         // no file name for the current entry in the zip was registered.
-        if (jt != FileList.end()) {
+        if (jt != FileList.end() && threads > 1 && jt->Object->canRestoreDocFileConcurrently()) {
+            try {
+                std::string data {std::istreambuf_iterator<char>(zipstream),
+                                  std::istreambuf_iterator<char>()};
+                PendingFile file;
+                file.FileName = jt->FileName;
+                file.EntryName = entry->toString();
+                file.Result = std::async(std::launch::async,
+                                         decodeFile,
+                                         jt->Object,
+                                         jt->FileName,
+                                         std::move(data));
+                pending.push_back(std::move(file));
+            }
+            catch (...) {
+                Base::Console().error("Reading failed from embedded file: %s\n",
+                                      entry->toString().c_str());
+                FailedFiles.push_back(jt->FileName);
+            }
+            if (pending.size() >= static_cast<std::size_t>(threads) * 2) {
+                finishFile();
+            }
+            it = jt + 1;
+        }
+        else if (jt != FileList.end()) {
             try {
                 Base::Reader reader(zipstream, jt->FileName, FileVersion);
+                reader.setArchiveFileName(ArchiveFileName);
                 jt->Object->RestoreDocFile(reader);
                 if (reader.getLocalReader()) {
+                    reader.getLocalReader()->setArchiveFileName(ArchiveFileName);
                     reader.getLocalReader()->readFiles(zipstream);
                 }
             }
@@ -501,6 +573,10 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
             break;
         }
     }
+
+    while (!pending.empty()) {
+        finishFile();
+    }
 }
 
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
@@ -550,6 +626,16 @@ bool Base::XMLReader::doNameMapping() const
     return false;
 }
 
+void Base::XMLReader::setArchiveFileName(const std::string& path)
+{
+    ArchiveFileName = path;
+}
+
+const std::string& Base::XMLReader::getArchiveFileName() const
+{
+    return ArchiveFileName;
+}
+
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Implementation of the SAX DocumentHandler interface
 // ---------------------------------------------------------------------------
@@ -729,3 +815,13 @@ std::shared_ptr<Base::XMLReader> Base::Reader::getLocalReader() const
 {
     return (this->localreader);
 }
+
+std::string Base::Reader::getArchiveFileName() const
+{
+    return this->_archive;
+}
+
+void Base::Reader::setArchiveFileName(const std::string& path)
+{
+    this->_archive = path;
+}
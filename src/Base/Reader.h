@@ -293,6 +293,22 @@ public:
     virtual void addName(const char*, const char*);
     virtual const char* getName(const char*) const;
     virtual bool doNameMapping() const;
+    /** Sets the path of the archive on disk the data files are read from.
+     * Only set when the zip stream comes from a file that stays in place after
+     * restoring, so that persistent objects may re-open their entry later on.
+     */
+    void setArchiveFileName(const std::string& path);
+    /// Returns the archive path or an empty string if not known
+    const std::string& getArchiveFileName() const;
+    /** Set the number of threads used by readFiles()
+     * With more than one thread the files of objects that can be restored
+     * concurrently are decoded by worker threads. A value of zero uses all
+     * available cores.
+     */
+    void setThreadCount(int count)
+    {
+        ThreadCount = count;
+    }
     //@}
 
     /// Schema Version of the document
@@ -399,6 +415,8 @@ public:
 
 private:
     mutable std::vector<std::string> FailedFiles;
+    std::string ArchiveFileName;
+    int ThreadCount {1};
 
     std::bitset<32> StatusBits;
 
@@ -414,10 +432,14 @@ public:
     int getFileVersion() const;
     void initLocalReader(std::shared_ptr<Base::XMLReader>);
     std::shared_ptr<Base::XMLReader> getLocalReader() const;
+    /// Path of the zip archive this entry is read from, empty if unknown
+    std::string getArchiveFileName() const;
+    void setArchiveFileName(const std::string&);
 
 private:
     std::istream& _str;
     std::string _name;
+    std::string _archive;
     int fileVersion;
     std::shared_ptr<Base::XMLReader> localreader;
 };
@@ -29,9 +29,16 @@
 #include <string>
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <thread>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
@@ -269,9 +276,16 @@ std::vector<std::string> Writer::getErrors() const
 
 std::string Writer::addFile(const char* Name, const Base::Persistence* Object)
 {
+    if (ParentWriter) {
+        return ParentWriter->addFile(Name, Object);
+    }
+
     // always check isForceXML() before requesting a file!
     assert(!isForceXML());
 
+    // files may be requested from within SaveDocFile() running in worker threads
+    std::lock_guard<std::mutex> lock(FileListMutex);
+
     FileEntry temp;
     temp.FileName = Name ? Name : "";
     if (FileNameManager.containsName(temp.FileName)) {
@@ -286,6 +300,33 @@ std::string Writer::addFile(const char* Name, const Base::Persistence* Object)
     return temp.FileName;
 }
 
+void Writer::addSharedFile(std::size_t key,
+                           const std::string& FileName,
+                           const Base::Persistence* Object)
+{
+    if (ParentWriter) {
+        ParentWriter->addSharedFile(key, FileName, Object);
+        return;
+    }
+
+    SharedFiles.emplace(key, FileEntry {FileName, Object});
+}
+
+std::vector<std::pair<std::string, const Base::Persistence*>>
+Writer::getSharedFiles(std::size_t key) const
+{
+    if (ParentWriter) {
+        return ParentWriter->getSharedFiles(key);
+    }
+
+    std::vector<std::pair<std::string, const Base::Persistence*>> files;
+    auto range = SharedFiles.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        files.emplace_back(it->second.FileName, it->second.Object);
+    }
+    return files;
+}
+
 void Writer::incInd()
 {
     if (indent < 1020) {
@@ -350,10 +391,23 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
 }
 
 void ZipWriter::writeFiles()
+{
+    int threads = ThreadCount;
+    if (threads <= 0) {
+        threads = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    if (threads == 1) {
+        writeFilesSerial(0);
+    }
+    else {
+        writeFilesConcurrent(0, threads);
+    }
+}
+
+void ZipWriter::writeFilesSerial(std::size_t index)
 {
     // use a while loop because it is possible that while
     // processing the files new ones can be added
-    size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
         putNextEntry(entry.FileName.c_str());
@@ -364,6 +418,228 @@ void ZipWriter::writeFiles()
     }
 }
 
+namespace
+{
+// Writer to serialize a single file into memory. Requests for further files
+// are forwarded to the owning ZipWriter.
+class BufferWriter: public Writer
+{
+public:
+    explicit BufferWriter(Writer* parent)
+    {
+        ParentWriter = parent;
+        setModes(parent->getModes());
+        setFileVersion(parent->getFileVersion());
+        Buffer.imbue(std::locale::classic());
+        Buffer.precision(std::numeric_limits<double>::digits10 + 1);
+        Buffer.setf(std::ios::fixed, std::ios::floatfield);
+    }
+
+    std::ostream& Stream() override
+    {
+        return Buffer;
+    }
+    void writeFiles() override
+    {}
+    std::string getString() const
+    {
+        return Buffer.str();
+    }
+
+private:
+    std::ostringstream Buffer;
+};
+
+struct ZipEntryBuffer
+{
+    std::string FileName;
+    const Persistence* Object {nullptr};
+    bool Concurrent {false};
+    bool Done {false};
+    std::string Data;
+    std::uint32_t Size {0};
+    std::uint32_t Crc {0};
+    std::vector<std::string> Errors;
+    std::exception_ptr Exception;
+};
+
+void serializeEntry(Writer* parent, ZipEntryBuffer& entry)
+{
+    BufferWriter writer(parent);
+    writer.putNextEntry(entry.FileName.c_str());
+    entry.Object->SaveDocFile(writer);
+    entry.Data = writer.getString();
+    entry.Errors = writer.getErrors();
+}
+
+// Replaces the entry data with its raw deflate stream, or leaves it
+// untouched if compression is disabled
+void compressEntry(ZipEntryBuffer& entry, int level)
+{
+    if (entry.Data.size() > std::numeric_limits<std::uint32_t>::max()) {
+        entry.Errors.emplace_back("File too big for zip archive: " + entry.FileName);
+        entry.Data.clear();
+        return;
+    }
+
+    const auto* input = reinterpret_cast<const Bytef*>(entry.Data.data());  // NOLINT
+    auto size = static_cast<uInt>(entry.Data.size());
+    entry.Size = size;
+    entry.Crc = crc32(crc32(0, Z_NULL, 0), input, size);
+    if (level == Z_NO_COMPRESSION) {
+        return;
+    }
+
+    z_stream zs {};
+    // negative window bits to write raw deflate data without zlib header
+    const int memLevel = 8;
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, memLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        entry.Errors.emplace_back("Failed to initialize compression for " + entry.FileName);
+        return;
+    }
+    std::string output(deflateBound(&zs, size), '\0');
+    zs.next_in = const_cast<Bytef*>(input);  // NOLINT
+    zs.avail_in = size;
+    zs.next_out = reinterpret_cast<Bytef*>(output.data());  // NOLINT
+    zs.avail_out = static_cast<uInt>(output.size());
+    int err = deflate(&zs, Z_FINISH);
+    output.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (err != Z_STREAM_END) {
+        entry.Errors.emplace_back("Failed to compress " + entry.FileName);
+        return;
+    }
+    entry.Data.swap(output);
+}
+}  // namespace
+
+void ZipWriter::writeFilesConcurrent(std::size_t index, int threads)
+{
+    // The buffers are written in the order of the requests. Files that can be
+    // saved concurrently are serialized and compressed by worker threads while
+    // the others are serialized by this thread and only compressed by the
+    // workers. No file is started while the finished buffers exceed
+    // MaxBufferSize or while every thread has a file in progress.
+    const zipios::StorageMethod method = Level == Z_NO_COMPRESSION ? zipios::STORED : zipios::DEFLATED;
+    const auto maxRunning = static_cast<std::size_t>(threads);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::unique_ptr<ZipEntryBuffer>> started;
+    std::deque<ZipEntryBuffer*> tasks;
+    std::size_t buffered = 0;
+    std::size_t running = 0;
+    bool stop = false;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            cond.wait(lock, [&]() {
+                return stop || !tasks.empty();
+            });
+            if (tasks.empty()) {
+                return;
+            }
+            ZipEntryBuffer* entry = tasks.front();
+            tasks.pop_front();
+            lock.unlock();
+            try {
+                if (entry->Concurrent) {
+                    serializeEntry(this, *entry);
+                }
+                compressEntry(*entry, Level);
+            }
+            catch (...) {
+                entry->Exception = std::current_exception();
+            }
+            lock.lock();
+            entry->Done = true;
+            buffered += entry->Data.size();
+            --running;
+            cond.notify_all();
+        }
+    };
+
+    // stops and joins the workers also if an exception is thrown
+    struct WorkerPool
+    {
+        std::vector<std::thread> workers;
+        std::function<void()> shutdown;
+        ~WorkerPool()
+        {
+            shutdown();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+    } pool;
+    pool.shutdown = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        cond.notify_all();
+    };
+    for (int i = 0; i < threads; ++i) {
+        pool.workers.emplace_back(worker);
+    }
+
+    auto nextFile = [&]() -> std::unique_ptr<ZipEntryBuffer> {
+        // files may be added by SaveDocFile() in the meantime
+        std::lock_guard<std::mutex> lock(FileListMutex);
+        if (index >= FileList.size()) {
+            return {};
+        }
+        auto entry = std::make_unique<ZipEntryBuffer>();
+        entry->FileName = FileList[index].FileName;
+        entry->Object = FileList[index].Object;
+        entry->Concurrent = entry->Object->canSaveDocFileConcurrently();
+        ++index;
+        return entry;
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        while (running < maxRunning && buffered < MaxBufferSize) {
+            auto entry = nextFile();
+            if (!entry) {
+                break;
+            }
+            ZipEntryBuffer* ptr = entry.get();
+            started.push_back(std::move(entry));
+            ++running;
+            if (!ptr->Concurrent) {
+                lock.unlock();
+                serializeEntry(this, *ptr);
+                lock.lock();
+            }
+            tasks.push_back(ptr);
+            cond.notify_all();
+        }
+        if (started.empty()) {
+            break;
+        }
+
+        cond.wait(lock, [&]() {
+            return started.front()->Done;
+        });
+        std::unique_ptr<ZipEntryBuffer> entry = std::move(started.front());
+        started.pop_front();
+        buffered -= entry->Data.size();
+        lock.unlock();
+        if (entry->Exception) {
+            std::rethrow_exception(entry->Exception);
+        }
+        ZipStream.putRawEntry(entry->FileName,
+                              entry->Data.data(),
+                              static_cast<std::uint32_t>(entry->Data.size()),
+                              entry->Size,
+                              entry->Crc,
+                              method);
+        Errors.insert(Errors.end(), entry->Errors.begin(), entry->Errors.end());
+        Writer::checkErrNo();
+        lock.lock();
+    }
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
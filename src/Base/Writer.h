@@ -24,11 +24,13 @@
 #define SRC_BASE_WRITER_H_
 
 
+#include <map>
 #include <set>
 #include <string>
 #include <sstream>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include <zipios++/zipoutputstream.h>
 
@@ -111,6 +113,18 @@ public:
     void clearModes();
     //@}
 
+    /** @name shared file data
+     * Objects with identical data may reference the file of the first one
+     * instead of writing a copy of their own.
+     */
+    //@{
+    /// register the file \a FileName written for \a Object under the content hash \a key
+    void addSharedFile(std::size_t key, const std::string& FileName, const Base::Persistence* Object);
+    /// get the files and their objects registered under \a key
+    std::vector<std::pair<std::string, const Base::Persistence*>>
+    getSharedFiles(std::size_t key) const;
+    //@}
+
     /** @name Error handling */
     //@{
     void addError(const std::string&);
@@ -169,7 +183,11 @@ protected:
         const Base::Persistence* Object;
     };
     std::vector<FileEntry> FileList;
+    std::multimap<std::size_t, FileEntry> SharedFiles;
     UniqueFileNameManager FileNameManager;
+    /// if set, addFile() requests are forwarded to this writer
+    Writer* ParentWriter {nullptr};
+    std::mutex FileListMutex;
     std::vector<std::string> Errors;
     std::set<std::string> Modes;
 
@@ -219,6 +237,25 @@ public:
     void setLevel(int level)
     {
         ZipStream.setLevel(level);
+        Level = level;
+    }
+    /** Set the number of threads used by writeFiles()
+     * With more than one thread each file is serialized and compressed into
+     * its own buffer and the buffers are then written to the archive in the
+     * order of the requests. A value of zero uses all available cores, the
+     * default of one writes the files directly to the archive.
+     */
+    void setThreadCount(int count)
+    {
+        ThreadCount = count;
+    }
+    /** Set the size of the buffers of finished files waiting to be written
+     * No further file is started while the buffers exceed this size, so the
+     * memory held by writeFiles() is bounded by the size plus one file per thread.
+     */
+    void setMaxBufferSize(std::size_t size)
+    {
+        MaxBufferSize = size;
     }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
@@ -227,8 +264,15 @@ public:
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
+private:
+    void writeFilesSerial(std::size_t index);
+    void writeFilesConcurrent(std::size_t index, int threads);
+
 private:
     zipios::ZipOutputStream ZipStream;
+    int Level {6};
+    int ThreadCount {1};
+    std::size_t MaxBufferSize {std::size_t(256) * 1024 * 1024};
 };
 
 /** The StringWriter class
@@ -40,6 +40,7 @@
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
+#include "Core/OutOfCore.h"
 #include "WildMagic4/Wm4ContBox3.h"
 
 #include "Exporter.h"
@@ -112,6 +113,20 @@ public:
             "volume oriented box containing all points. The return value is a\n"
             "tuple of seven items:\n"
             "    center, u, v, w directions and the lengths of the three vectors.\n");
+        add_varargs_method(
+            "simplifyOutOfCore",
+            &Module::simplifyOutOfCore,
+            "simplifyOutOfCore(inputFile, outputFile, tolerance, reduction, [maxFacets=1000000])\n"
+            "Simplifies a binary STL file that is too large to be loaded at once.\n"
+            "The mesh is processed in chunks of about maxFacets facets and written\n"
+            "to outputFile as binary STL or PLY file.\n");
+        add_varargs_method(
+            "curvatureOutOfCore",
+            &Module::curvatureOutOfCore,
+            "curvatureOutOfCore(inputFile, outputFile, [maxFacets=1000000])\n"
+            "Computes the principal curvatures of the points of a binary STL file that\n"
+            "is too large to be loaded at once. Each line of the text file outputFile\n"
+            "holds 'x y z max min' of one point.\n");
         initialize("The functions in this module allow working with mesh objects.\n"
                    "A set of functions are provided for reading in registered mesh\n"
                    "file formats to either a new or existing document.\n"
@@ -509,6 +524,58 @@ private:
 
         return Py::asObject(new Base::PlacementPy(new Base::Placement(Trafo)));
     }
+    Py::Object simplifyOutOfCore(const Py::Tuple& args)
+    {
+        char* inputName {};
+        char* outputName {};
+        float tolerance {};
+        float reduction {};
+        unsigned long maxFacets = 1000000;
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "etetff|k",
+                              "utf-8",
+                              &inputName,
+                              "utf-8",
+                              &outputName,
+                              &tolerance,
+                              &reduction,
+                              &maxFacets)) {
+            throw Py::Exception();
+        }
+
+        std::string inputFile(inputName);
+        PyMem_Free(inputName);
+        std::string outputFile(outputName);
+        PyMem_Free(outputName);
+
+        MeshCore::MeshOutOfCore mesh(inputFile, maxFacets);
+        mesh.Simplify(tolerance, reduction, outputFile);
+        return Py::None();
+    }
+    Py::Object curvatureOutOfCore(const Py::Tuple& args)
+    {
+        char* inputName {};
+        char* outputName {};
+        unsigned long maxFacets = 1000000;
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "etet|k",
+                              "utf-8",
+                              &inputName,
+                              "utf-8",
+                              &outputName,
+                              &maxFacets)) {
+            throw Py::Exception();
+        }
+
+        std::string inputFile(inputName);
+        PyMem_Free(inputName);
+        std::string outputFile(outputName);
+        PyMem_Free(outputName);
+
+        MeshCore::MeshOutOfCore mesh(inputFile, maxFacets);
+        mesh.ComputeCurvature(outputFile);
+        return Py::None();
+    }
     Py::Object polynomialFit(const Py::Tuple& args)
     {
         PyObject* input {};
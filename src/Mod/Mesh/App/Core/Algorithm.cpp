@@ -24,7 +24,9 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <numeric>
 #endif
 
 #include <Base/Console.h>
@@ -33,6 +35,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -1831,20 +1834,73 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength,
 
 // ----------------------------------------------------
 
-void MeshRefPointToFacets::Rebuild()
+namespace
 {
-    _map.clear();
+constexpr std::size_t AdjacencyBlock = 0x4000;
 
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
+/// Checks if corner \a i is the first corner of \a facet that refers to its point
+bool isFirstCorner(const MeshFacet& facet, int i)
+{
+    for (int j = 0; j < i; j++) {
+        if (facet._aulPoints[j] == facet._aulPoints[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Copies the rows of \a adjacency into the sets of \a map on several threads
+void fillSets(const MeshAdjacency& adjacency, std::vector<std::set<ElementIndex>>& map)
+{
+    map.clear();
+    map.resize(adjacency.Size());
+    parallel_blocks(map.size(), AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshAdjacency::Range row = adjacency[i];
+            map[i].insert(row.begin(), row.end());
+        }
+    });
+}
+
+/** Builds the compressed rows of \a count elements on several threads. \a collect(i, row)
+ * appends the neighbours of element i to \a row, duplicates are removed afterwards.
+ */
+template<class Func>
+void buildRows(std::size_t count,
+               Func collect,
+               std::vector<std::size_t>& offsets,
+               std::vector<ElementIndex>& indices)
+{
+    std::vector<std::vector<ElementIndex>> blocks((count + AdjacencyBlock - 1) / AdjacencyBlock);
+    offsets.assign(count + 1, 0);
+    parallel_blocks(count, AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        std::vector<ElementIndex>& block = blocks[begin / AdjacencyBlock];
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t first = block.size();
+            collect(i, block);
+            std::sort(block.begin() + first, block.end());
+            block.erase(std::unique(block.begin() + first, block.end()), block.end());
+            offsets[i + 1] = block.size() - first;
+        }
+    });
 
-    auto pFBegin = rFacets.begin();
-    for (auto pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+    for (std::size_t i = 0; i < count; i++) {
+        offsets[i + 1] += offsets[i];
     }
+    indices.resize(offsets[count]);
+    parallel_blocks(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto first = indices.begin() + std::ptrdiff_t(offsets[i * AdjacencyBlock]);
+            std::copy(blocks[i].begin(), blocks[i].end(), first);
+            std::vector<ElementIndex>().swap(blocks[i]);
+        }
+    });
+}
+}  // namespace
+
+void MeshRefPointToFacets::Rebuild()
+{
+    fillSets(MeshAdjacency(_rclMesh, MeshAdjacency::PointToFacets), _map);
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
@@ -2004,21 +2060,7 @@ void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
 
 void MeshRefFacetToFacets::Rebuild()
 {
-    _map.clear();
-
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
-
-    MeshRefPointToFacets vertexFace(_rclMesh);
-    auto pFBegin = rFacets.begin();
-    for (auto pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
-        for (PointIndex ptIndex : pFIter->_aulPoints) {
-            const std::set<FacetIndex>& faces = vertexFace[ptIndex];
-            for (FacetIndex face : faces) {
-                _map[pFIter - pFBegin].insert(face);
-            }
-        }
-    }
+    fillSets(MeshAdjacency(_rclMesh, MeshAdjacency::FacetToFacets), _map);
 }
 
 const std::set<FacetIndex>& MeshRefFacetToFacets::operator[](FacetIndex pos) const
@@ -2040,24 +2082,7 @@ std::vector<FacetIndex> MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetI
 
 void MeshRefPointToPoints::Rebuild()
 {
-    _map.clear();
-
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
-
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (const auto& rFacet : rFacets) {
-        PointIndex ulP0 = rFacet._aulPoints[0];
-        PointIndex ulP1 = rFacet._aulPoints[1];
-        PointIndex ulP2 = rFacet._aulPoints[2];
-
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
-    }
+    fillSets(MeshAdjacency(_rclMesh, MeshAdjacency::PointToPoints), _map);
 }
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
@@ -2145,26 +2170,132 @@ void MeshRefNormalToPoints::Rebuild()
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     _norm.resize(rPoints.size());
 
+    // each point sums up the weighted normals of its facets
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (const auto& rFacet : rFacets) {
-        const MeshPoint& p0 = rPoints[rFacet._aulPoints[0]];
-        const MeshPoint& p1 = rPoints[rFacet._aulPoints[1]];
-        const MeshPoint& p2 = rPoints[rFacet._aulPoints[2]];
-        float l2p01 = Base::DistanceP2(p0, p1);
-        float l2p12 = Base::DistanceP2(p1, p2);
-        float l2p20 = Base::DistanceP2(p2, p0);
-
-        Base::Vector3f facenormal = _rclMesh.GetFacet(rFacet).GetNormal();
-        _norm[rFacet._aulPoints[0]] += facenormal * (1.0F / (l2p01 * l2p20));
-        _norm[rFacet._aulPoints[1]] += facenormal * (1.0F / (l2p12 * l2p01));
-        _norm[rFacet._aulPoints[2]] += facenormal * (1.0F / (l2p20 * l2p12));
-    }
-    for (auto& it : _norm) {
-        it.Normalize();
-    }
+    MeshAdjacency pointToFacets(_rclMesh, MeshAdjacency::PointToFacets);
+    parallel_blocks(_norm.size(), AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        for (PointIndex index = begin; index < end; index++) {
+            for (FacetIndex facet : pointToFacets[index]) {
+                const MeshFacet& rFacet = rFacets[facet];
+                Base::Vector3f facenormal = _rclMesh.GetFacet(rFacet).GetNormal();
+                for (int i = 0; i < 3; i++) {
+                    if (rFacet._aulPoints[i] == index) {
+                        const MeshPoint& p0 = rPoints[rFacet._aulPoints[i]];
+                        const MeshPoint& p1 = rPoints[rFacet._aulPoints[(i + 1) % 3]];
+                        const MeshPoint& p2 = rPoints[rFacet._aulPoints[(i + 2) % 3]];
+                        float l2p01 = Base::DistanceP2(p0, p1);
+                        float l2p20 = Base::DistanceP2(p2, p0);
+                        _norm[index] += facenormal * (1.0F / (l2p01 * l2p20));
+                    }
+                }
+            }
+            _norm[index].Normalize();
+        }
+    });
 }
 
 const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
 {
     return _norm[pos];
 }
+
+//----------------------------------------------------------------------------
+
+void MeshAdjacency::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t numPoints = _rclMesh.CountPoints();
+
+    // the facets of the points are sorted by counting on several threads, the facets of a
+    // point are then sorted so they are in ascending order
+    std::vector<std::atomic<std::size_t>> counts(numPoints);
+    parallel_blocks(rFacets.size(), AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& rFacet = rFacets[index];
+            for (int i = 0; i < 3; i++) {
+                if (isFirstCorner(rFacet, i)) {
+                    counts[rFacet._aulPoints[i]].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+
+    // prefix sum of the counts, first per block and then over the blocks
+    std::vector<std::size_t> offsets(numPoints + 1, 0);
+    std::vector<std::size_t> sums((numPoints + AdjacencyBlock - 1) / AdjacencyBlock + 1, 0);
+    parallel_blocks(numPoints, AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        std::size_t sum = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            sum += counts[i].load(std::memory_order_relaxed);
+            offsets[i + 1] = sum;
+        }
+        sums[begin / AdjacencyBlock + 1] = sum;
+    });
+    std::partial_sum(sums.begin(), sums.end(), sums.begin());
+    parallel_blocks(numPoints, AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        std::size_t base = sums[begin / AdjacencyBlock];
+        for (std::size_t i = begin; i < end; i++) {
+            offsets[i + 1] += base;
+            // the next free position of point i
+            counts[i].store(offsets[i + 1] - counts[i].load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<FacetIndex> facets(offsets[numPoints]);
+    parallel_blocks(rFacets.size(), AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& rFacet = rFacets[index];
+            for (int i = 0; i < 3; i++) {
+                if (isFirstCorner(rFacet, i)) {
+                    std::atomic<std::size_t>& pos = counts[rFacet._aulPoints[i]];
+                    facets[pos.fetch_add(1, std::memory_order_relaxed)] = FacetIndex(index);
+                }
+            }
+        }
+    });
+    parallel_blocks(numPoints, AdjacencyBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::sort(facets.begin() + std::ptrdiff_t(offsets[i]),
+                      facets.begin() + std::ptrdiff_t(offsets[i + 1]));
+        }
+    });
+
+    auto facetsOf = [&](PointIndex point) {
+        return Range(facets.data() + offsets[point], facets.data() + offsets[point + 1]);
+    };
+
+    switch (_type) {
+        case PointToPoints:
+            buildRows(
+                numPoints,
+                [&](std::size_t i, std::vector<ElementIndex>& row) {
+                    for (FacetIndex facet : facetsOf(i)) {
+                        for (PointIndex point : rFacets[facet]._aulPoints) {
+                            if (point != i) {
+                                row.push_back(point);
+                            }
+                        }
+                    }
+                },
+                _offsets,
+                _indices);
+            break;
+        case PointToFacets:
+            _offsets = std::move(offsets);
+            _indices = std::move(facets);
+            break;
+        case FacetToFacets:
+            buildRows(
+                rFacets.size(),
+                [&](std::size_t i, std::vector<ElementIndex>& row) {
+                    for (PointIndex point : rFacets[i]._aulPoints) {
+                        Range range = facetsOf(point);
+                        row.insert(row.end(), range.begin(), range.end());
+                    }
+                },
+                _offsets,
+                _indices);
+            break;
+    }
+}
@@ -25,6 +25,7 @@
 
 #include <map>
 #include <set>
+#include <span>
 #include <vector>
 
 #include "Elements.h"
@@ -638,6 +639,54 @@ private:
     std::vector<Base::Vector3f> _norm;
 };
 
+/**
+ * The MeshAdjacency class stores the neighbours of all points or facets of a mesh in compressed
+ * sparse row form: the sorted neighbours of all elements are kept in one array and each element
+ * refers to its part of the array by an offset. Unlike the MeshRef* classes it doesn't allocate
+ * memory per element and is built on several threads, which makes it the preferred structure for
+ * the neighbourhood based algorithms on large meshes.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshAdjacency
+{
+public:
+    enum Type
+    {
+        PointToPoints,  ///< Points sharing an edge with a point
+        PointToFacets,  ///< Facets indexing a point
+        FacetToFacets   ///< Facets sharing at least one point with a facet, including itself
+    };
+    using Range = std::span<const ElementIndex>;
+
+    /// Construction
+    MeshAdjacency(const MeshKernel& rclM, Type type)
+        : _rclMesh(rclM)
+        , _type(type)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the number of elements
+    std::size_t Size() const
+    {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+    /// Returns the sorted neighbours of the point or facet with index \a pos
+    Range operator[](ElementIndex pos) const
+    {
+        return {_indices.data() + _offsets[pos], _indices.data() + _offsets[pos + 1]};
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    Type _type;
+    std::vector<std::size_t> _offsets;
+    std::vector<ElementIndex> _indices;
+};
+
 }  // namespace MeshCore
 
 #endif  // MESH_ALGORITHM_H
@@ -0,0 +1,1626 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#endif
+
+#include <Base/Converter.h>
+#include <Base/Tools2D.h>
+
+#include "Boolean.h"
+#include "Functional.h"
+#include "Grid.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+/// Number of facets handled as one block on a thread
+constexpr std::size_t BlockFacets = 0x4000;
+/// Number of cut facets triangulated as one block on a thread
+constexpr std::size_t BlockCuts = 0x40;
+/// Number of winding number queries handled as one block on a thread
+constexpr std::size_t BlockQueries = 0x40;
+/// Distance relative to its radius from which a cluster of facets is approximated by its dipole
+constexpr double FarField = 3.0;
+/// Number of winding number queries below which the facets are not clustered
+constexpr std::size_t FewQueries = 0x10;
+
+using Vec = Base::Vector3d;
+
+Vec toVec(const Base::Vector3f& pnt)
+{
+    return Base::convertTo<Vec>(pnt);
+}
+
+/// The location of a point on the facets of one mesh
+struct Feature
+{
+    /// Ordered by precedence when points get merged
+    enum Kind
+    {
+        None,
+        Facet,
+        Edge,
+        Vertex
+    };
+
+    Kind kind {None};
+    unsigned long index {0};  // facet for Facet and Edge, point for Vertex
+    unsigned short side {0};  // side of the facet for Edge
+};
+
+Feature makeFeature(Feature::Kind kind, unsigned long index, int side = 0)
+{
+    Feature feature;
+    feature.kind = kind;
+    feature.index = index;
+    feature.side = static_cast<unsigned short>(side);
+    return feature;
+}
+
+struct CutPoint
+{
+    Base::Vector3f pnt;
+    std::array<Feature, 2> feature;
+};
+
+/// A segment of an intersection curve of facet[0] of the first and facet[1] of the second mesh
+struct CutSegment
+{
+    std::array<FacetIndex, 2> facet {};
+    std::array<CutPoint, 2> point;
+    /// For coplanar facets the segment is an edge of one facet that cuts the facet of \a owner
+    bool coplanar {false};
+    int owner {0};
+};
+
+struct Plane
+{
+    Vec normal;
+    double dist {0.0};
+
+    double distance(const Vec& pnt) const
+    {
+        return normal * pnt - dist;
+    }
+    bool isValid() const
+    {
+        return normal.Sqr() > 0.0;
+    }
+};
+
+/// Projects points onto the coordinate plane most parallel to a plane, keeping the orientation
+class Projection
+{
+public:
+    explicit Projection(const Vec& normal)
+    {
+        double x = std::fabs(normal.x);
+        double y = std::fabs(normal.y);
+        double z = std::fabs(normal.z);
+        if (x >= y && x >= z) {
+            axis = 0;
+            flip = normal.x < 0.0;
+        }
+        else if (y >= z) {
+            axis = 1;
+            flip = normal.y < 0.0;
+        }
+        else {
+            axis = 2;
+            flip = normal.z < 0.0;
+        }
+    }
+
+    Base::Vector2d operator()(const Vec& pnt) const
+    {
+        Base::Vector2d res;
+        switch (axis) {
+            case 0:
+                res = Base::Vector2d(pnt.y, pnt.z);
+                break;
+            case 1:
+                res = Base::Vector2d(pnt.z, pnt.x);
+                break;
+            default:
+                res = Base::Vector2d(pnt.x, pnt.y);
+                break;
+        }
+        if (flip) {
+            std::swap(res.x, res.y);
+        }
+        return res;
+    }
+
+private:
+    int axis {2};
+    bool flip {false};
+};
+
+/// Twice the signed area of the triangle (a, b, c), positive if counterclockwise
+double orient(const Base::Vector2d& a, const Base::Vector2d& b, const Base::Vector2d& c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+/// The input meshes and the planes of their facets
+struct Input
+{
+    std::array<const MeshKernel*, 2> kernel {};
+    std::array<std::vector<Plane>, 2> planes;
+    double eps {0.0};
+
+    const MeshFacet& facet(int mesh, FacetIndex index) const
+    {
+        return kernel[mesh]->GetFacets()[index];
+    }
+    const Base::Vector3f& point(int mesh, PointIndex index) const
+    {
+        return kernel[mesh]->GetPoints()[index];
+    }
+};
+
+std::vector<Plane> facetPlanes(const MeshKernel& kernel)
+{
+    const MeshFacetArray& facets = kernel.GetFacets();
+    const MeshPointArray& points = kernel.GetPoints();
+    std::vector<Plane> planes(facets.size());
+    parallel_blocks(facets.size(), BlockFacets, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[i];
+            Vec p0 = toVec(points[facet._aulPoints[0]]);
+            Vec p1 = toVec(points[facet._aulPoints[1]]);
+            Vec p2 = toVec(points[facet._aulPoints[2]]);
+            Vec normal = (p1 - p0) % (p2 - p0);
+            double len = normal.Length();
+            if (len > 0.0) {
+                normal /= len;
+                planes[i].normal = normal;
+                planes[i].dist = normal * p0;
+            }
+        }
+    });
+    return planes;
+}
+
+/** Collects the corners and edge points of facet \a f of \a mesh that lie on \a plane of facet
+ * \a other of the other mesh. Returns true if the whole facet lies on the plane.
+ */
+bool pointsOnPlane(const Input& input,
+                   int mesh,
+                   FacetIndex f,
+                   const Plane& plane,
+                   FacetIndex other,
+                   std::array<CutPoint, 3>& cut,
+                   int& count)
+{
+    const MeshFacet& facet = input.facet(mesh, f);
+    std::array<double, 3> dist {};
+    for (int i = 0; i < 3; i++) {
+        dist[i] = plane.distance(toVec(input.point(mesh, facet._aulPoints[i])));
+        if (std::fabs(dist[i]) <= input.eps) {
+            dist[i] = 0.0;
+        }
+    }
+
+    count = 0;
+    for (int i = 0; i < 3; i++) {
+        PointIndex p = facet._aulPoints[i];
+        PointIndex q = facet._aulPoints[(i + 1) % 3];
+        double dp = dist[i];
+        double dq = dist[(i + 1) % 3];
+        CutPoint& pnt = cut[count];
+        pnt.feature[1 - mesh] = makeFeature(Feature::Facet, other);
+        if (dp == 0.0) {
+            pnt.pnt = input.point(mesh, p);
+            pnt.feature[mesh] = makeFeature(Feature::Vertex, p);
+            count++;
+        }
+        else if (dp * dq < 0.0) {
+            // start at the lower point index so that both facets of the edge get the same point
+            if (q < p) {
+                std::swap(p, q);
+                std::swap(dp, dq);
+            }
+            Vec a = toVec(input.point(mesh, p));
+            Vec b = toVec(input.point(mesh, q));
+            pnt.pnt = Base::convertTo<Base::Vector3f>(a + (b - a) * (dp / (dp - dq)));
+            pnt.feature[mesh] = makeFeature(Feature::Edge, f, i);
+            count++;
+        }
+    }
+
+    return dist[0] == 0.0 && dist[1] == 0.0 && dist[2] == 0.0;
+}
+
+/// Clips the edges of facet \a f of \a mesh to the coplanar facet \a g of the other mesh
+void clipCoplanar(const Input& input,
+                  int mesh,
+                  FacetIndex f,
+                  FacetIndex g,
+                  std::vector<CutSegment>& segments)
+{
+    int other = 1 - mesh;
+    const MeshFacet& facet = input.facet(mesh, f);
+    const MeshFacet& target = input.facet(other, g);
+    Projection proj(input.planes[other][g].normal);
+    std::array<Base::Vector2d, 3> corner;
+    for (int i = 0; i < 3; i++) {
+        corner[i] = proj(toVec(input.point(other, target._aulPoints[i])));
+    }
+
+    for (int i = 0; i < 3; i++) {
+        PointIndex p = facet._aulPoints[i];
+        PointIndex q = facet._aulPoints[(i + 1) % 3];
+        if (q < p) {
+            std::swap(p, q);
+        }
+        Vec a = toVec(input.point(mesh, p));
+        Vec b = toVec(input.point(mesh, q));
+        Base::Vector2d a2 = proj(a);
+        Base::Vector2d b2 = proj(b);
+
+        double t0 = 0.0;
+        double t1 = 1.0;
+        int side0 = -1;
+        int side1 = -1;
+        bool outside = false;
+        for (int k = 0; k < 3 && !outside; k++) {
+            const Base::Vector2d& c = corner[k];
+            const Base::Vector2d& d = corner[(k + 1) % 3];
+            double len = (d - c).Length();
+            if (len == 0.0) {
+                outside = true;
+                break;
+            }
+            double fa = orient(c, d, a2) / len;
+            double fb = orient(c, d, b2) / len;
+            if (fa < -input.eps && fb < -input.eps) {
+                outside = true;
+            }
+            else if (fa < -input.eps) {
+                double t = fa / (fa - fb);
+                if (t > t0) {
+                    t0 = t;
+                    side0 = k;
+                }
+            }
+            else if (fb < -input.eps) {
+                double t = fa / (fa - fb);
+                if (t < t1) {
+                    t1 = t;
+                    side1 = k;
+                }
+            }
+        }
+        if (outside || (t1 - t0) * (b - a).Length() <= input.eps) {
+            continue;
+        }
+
+        auto makePoint = [&](double t, int side, PointIndex corner) {
+            CutPoint pnt;
+            if (side < 0) {
+                pnt.pnt = input.point(mesh, corner);
+                pnt.feature[mesh] = makeFeature(Feature::Vertex, corner);
+                pnt.feature[other] = makeFeature(Feature::Facet, g);
+            }
+            else {
+                pnt.pnt = Base::convertTo<Base::Vector3f>(a + (b - a) * t);
+                pnt.feature[mesh] = makeFeature(Feature::Edge, f, i);
+                pnt.feature[other] = makeFeature(Feature::Edge, g, side);
+            }
+            return pnt;
+        };
+
+        CutSegment seg;
+        seg.facet[mesh] = f;
+        seg.facet[other] = g;
+        seg.point[0] = makePoint(t0, side0, p);
+        seg.point[1] = makePoint(t1, side1, q);
+        seg.coplanar = true;
+        seg.owner = other;
+        segments.push_back(seg);
+    }
+}
+
+/// Adds the intersection of facet \a f0 of the first and \a f1 of the second mesh
+void intersectFacets(const Input& input,
+                     FacetIndex f0,
+                     FacetIndex f1,
+                     std::vector<CutSegment>& segments)
+{
+    const Plane& plane0 = input.planes[0][f0];
+    const Plane& plane1 = input.planes[1][f1];
+    if (!plane0.isValid() || !plane1.isValid()) {
+        return;
+    }
+
+    std::array<CutPoint, 3> cut0;
+    std::array<CutPoint, 3> cut1;
+    int count0 = 0;
+    int count1 = 0;
+    bool coplanar0 = pointsOnPlane(input, 0, f0, plane1, f1, cut0, count0);
+    if (count0 == 0) {
+        return;
+    }
+    bool coplanar1 = pointsOnPlane(input, 1, f1, plane0, f0, cut1, count1);
+    if (count1 == 0) {
+        return;
+    }
+    if (coplanar0 || coplanar1) {
+        clipCoplanar(input, 0, f0, f1, segments);
+        clipCoplanar(input, 1, f1, f0, segments);
+        return;
+    }
+
+    // both point sets lie on the intersection line of the planes
+    Vec dir = plane0.normal % plane1.normal;
+    double len = dir.Length();
+    if (len == 0.0) {
+        return;
+    }
+    dir /= len;
+
+    auto range = [&dir](const std::array<CutPoint, 3>& cut, int count) {
+        std::pair<int, int> minmax(0, 0);
+        for (int i = 1; i < count; i++) {
+            if (dir * toVec(cut[i].pnt) < dir * toVec(cut[minmax.first].pnt)) {
+                minmax.first = i;
+            }
+            if (dir * toVec(cut[i].pnt) > dir * toVec(cut[minmax.second].pnt)) {
+                minmax.second = i;
+            }
+        }
+        return minmax;
+    };
+
+    auto range0 = range(cut0, count0);
+    auto range1 = range(cut1, count1);
+    double min0 = dir * toVec(cut0[range0.first].pnt);
+    double max0 = dir * toVec(cut0[range0.second].pnt);
+    double min1 = dir * toVec(cut1[range1.first].pnt);
+    double max1 = dir * toVec(cut1[range1.second].pnt);
+    if (std::min(max0, max1) - std::max(min0, min1) <= input.eps) {
+        return;
+    }
+
+    // an end shared by both facets keeps its location on both meshes
+    auto endPoint = [&input](const CutPoint& pnt0, double t0, const CutPoint& pnt1, double t1) {
+        CutPoint pnt = t0 >= t1 ? pnt0 : pnt1;
+        if (std::fabs(t0 - t1) <= input.eps) {
+            pnt.feature[0] = pnt0.feature[0];
+            pnt.feature[1] = pnt1.feature[1];
+        }
+        return pnt;
+    };
+
+    CutSegment seg;
+    seg.facet = {f0, f1};
+    seg.point[0] = endPoint(cut0[range0.first], min0, cut1[range1.first], min1);
+    seg.point[1] = endPoint(cut0[range0.second], -max0, cut1[range1.second], -max1);
+
+    // for almost parallel planes the line is ill-conditioned, so both ends must really lie on
+    // the intervals of both facets
+    auto onInterval = [&input](const CutPoint& pnt, const CutPoint& from, const CutPoint& to) {
+        Vec a = toVec(from.pnt);
+        Vec dir = toVec(to.pnt) - a;
+        Vec diff = toVec(pnt.pnt) - a;
+        double len2 = dir.Sqr();
+        double t = len2 > 0.0 ? std::clamp((diff * dir) / len2, 0.0, 1.0) : 0.0;
+        return (diff - dir * t).Length() <= input.eps;
+    };
+    for (const CutPoint& pnt : seg.point) {
+        if (!onInterval(pnt, cut0[range0.first], cut0[range0.second])
+            || !onInterval(pnt, cut1[range1.first], cut1[range1.second])) {
+            return;
+        }
+    }
+    segments.push_back(seg);
+}
+
+/// Returns the intersection segments of all facet pairs of both meshes
+std::vector<CutSegment> intersectMeshes(const Input& input)
+{
+    const MeshKernel& kernel0 = *input.kernel[0];
+    const MeshKernel& kernel1 = *input.kernel[1];
+    std::vector<CutSegment> segments;
+    if (kernel0.CountFacets() == 0 || kernel1.CountFacets() == 0) {
+        return segments;
+    }
+
+    MeshFacetGrid grid(kernel1);
+    Base::BoundBox3f box1 = kernel1.GetBoundBox();
+    box1.Enlarge(static_cast<float>(input.eps));
+
+    std::size_t numFacets = kernel0.CountFacets();
+    std::vector<std::vector<CutSegment>> blocks((numFacets + BlockFacets - 1) / BlockFacets);
+    parallel_blocks(numFacets, BlockFacets, [&](std::size_t begin, std::size_t end) {
+        std::vector<CutSegment>& found = blocks[begin / BlockFacets];
+        std::vector<ElementIndex> candidates;
+        for (std::size_t i = begin; i < end; i++) {
+            Base::BoundBox3f box = kernel0.GetFacet(i).GetBoundBox();
+            box.Enlarge(static_cast<float>(input.eps));
+            if (!(box && box1)) {
+                continue;
+            }
+            grid.Inside(box, candidates);
+            for (ElementIndex j : candidates) {
+                if (box && kernel1.GetFacet(j).GetBoundBox()) {
+                    intersectFacets(input, i, j, found);
+                }
+            }
+        }
+    });
+
+    for (auto& block : blocks) {
+        segments.insert(segments.end(), block.begin(), block.end());
+    }
+    return segments;
+}
+
+/// The facets of a grid cell, approximated by a dipole for points far away
+struct FacetCluster
+{
+    std::vector<FacetIndex> facets;
+    Vec center;  /**< area-weighted centre of the facets */
+    Vec dipole;  /**< sum of the area-weighted normals of the facets */
+    double radius {0.0};
+};
+
+/// Returns the solid angle of the triangle \a p0, \a p1, \a p2 seen from \a pnt
+double solidAngle(const Vec& p0, const Vec& p1, const Vec& p2, const Vec& pnt)
+{
+    Vec a = p0 - pnt;
+    Vec b = p1 - pnt;
+    Vec c = p2 - pnt;
+    double la = a.Length();
+    double lb = b.Length();
+    double lc = c.Length();
+    double det = a * (b % c);
+    double div = la * lb * lc + (a * b) * lc + (b * c) * la + (c * a) * lb;
+    return 2.0 * std::atan2(det, div);
+}
+
+/// Groups the facets by the cell of the facet grid their centre lies in
+std::vector<FacetCluster> clusterFacets(const MeshKernel& kernel)
+{
+    const MeshFacetArray& facets = kernel.GetFacets();
+    const MeshPointArray& points = kernel.GetPoints();
+    MeshFacetGrid grid(kernel);
+    unsigned long ctX {};
+    unsigned long ctY {};
+    unsigned long ctZ {};
+    grid.GetCtGrids(ctX, ctY, ctZ);
+
+    std::vector<FacetCluster> clusters(ctX * ctY * ctZ);
+    for (FacetIndex i = 0; i < facets.size(); i++) {
+        unsigned long x {};
+        unsigned long y {};
+        unsigned long z {};
+        grid.Position(kernel.GetFacet(facets[i]).GetGravityPoint(), x, y, z);
+        clusters[grid.GetIndexToPosition(x, y, z)].facets.push_back(i);
+    }
+    clusters.erase(std::remove_if(clusters.begin(),
+                                  clusters.end(),
+                                  [](const FacetCluster& cluster) {
+                                      return cluster.facets.empty();
+                                  }),
+                   clusters.end());
+
+    parallel_blocks(clusters.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; c++) {
+            FacetCluster& cluster = clusters[c];
+            double area = 0.0;
+            Vec centroid;
+            for (FacetIndex i : cluster.facets) {
+                const MeshFacet& facet = facets[i];
+                Vec p0 = toVec(points[facet._aulPoints[0]]);
+                Vec p1 = toVec(points[facet._aulPoints[1]]);
+                Vec p2 = toVec(points[facet._aulPoints[2]]);
+                Vec normal = ((p1 - p0) % (p2 - p0)) * 0.5;
+                double weight = normal.Length();
+                cluster.dipole += normal;
+                cluster.center += (p0 + p1 + p2) * (weight / 3.0);
+                centroid += (p0 + p1 + p2) / 3.0;
+                area += weight;
+            }
+            if (area > 0.0) {
+                cluster.center /= area;
+            }
+            else {
+                cluster.center = centroid / double(cluster.facets.size());
+            }
+            for (FacetIndex i : cluster.facets) {
+                for (PointIndex pnt : facets[i]._aulPoints) {
+                    double dist = Base::Distance(cluster.center, toVec(points[pnt]));
+                    cluster.radius = std::max(cluster.radius, dist);
+                }
+            }
+        }
+    });
+    return clusters;
+}
+
+/**
+ * Returns the generalized winding numbers of the mesh at the points \a pnts. The solid angles
+ * of the facets are summed up for the clusters near a point only. A cluster farther away than
+ * FarField times its radius contributes the solid angle of its dipole.
+ */
+std::vector<double> windingNumbers(const MeshKernel& kernel, const std::vector<Vec>& pnts)
+{
+    std::vector<double> winding(pnts.size(), 0.0);
+    if (kernel.CountFacets() == 0 || pnts.empty()) {
+        return winding;
+    }
+
+    const MeshFacetArray& facets = kernel.GetFacets();
+    const MeshPointArray& points = kernel.GetPoints();
+    // for a few points summing up all facets is faster than building the clusters
+    std::vector<FacetCluster> clusters;
+    if (pnts.size() < FewQueries) {
+        clusters.resize(1);
+        clusters[0].facets.resize(facets.size());
+        std::iota(clusters[0].facets.begin(), clusters[0].facets.end(), FacetIndex(0));
+        clusters[0].radius = std::numeric_limits<double>::infinity();
+    }
+    else {
+        clusters = clusterFacets(kernel);
+    }
+    parallel_blocks(pnts.size(), BlockQueries, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t j = begin; j < end; j++) {
+            double sum = 0.0;
+            for (const FacetCluster& cluster : clusters) {
+                Vec dir = cluster.center - pnts[j];
+                double dist = dir.Length();
+                if (dist > FarField * cluster.radius) {
+                    sum += (cluster.dipole * dir) / (dist * dist * dist);
+                    continue;
+                }
+                for (FacetIndex i : cluster.facets) {
+                    const MeshFacet& facet = facets[i];
+                    sum += solidAngle(toVec(points[facet._aulPoints[0]]),
+                                      toVec(points[facet._aulPoints[1]]),
+                                      toVec(points[facet._aulPoints[2]]),
+                                      pnts[j]);
+                }
+            }
+            winding[j] = sum / (4.0 * std::numbers::pi);
+        }
+    });
+    return winding;
+}
+
+/// A segment of an intersection curve that must become an edge of the pieces of a facet
+struct Constraint
+{
+    PointIndex pnt[2];
+    FacetIndex other;
+    bool coplanar;
+};
+
+/// The points and constraints a facet is cut with
+struct FacetCut
+{
+    std::vector<PointIndex> points;
+    std::vector<Constraint> constraints;
+    std::vector<FacetIndex> coplanar;
+};
+
+/// The triangulation of a cut facet in the projection onto a coordinate plane
+class FacetTriangulation
+{
+public:
+    FacetTriangulation(const Projection& proj, double eps)
+        : proj(proj)
+        , eps(eps)
+    {}
+
+    int addPoint(PointIndex id, const Vec& pnt)
+    {
+        auto it = local.find(id);
+        if (it != local.end()) {
+            return it->second;
+        }
+        int index = static_cast<int>(ids.size());
+        local[id] = index;
+        ids.push_back(id);
+        points.push_back(proj(pnt));
+        return index;
+    }
+    int localIndex(PointIndex id) const
+    {
+        auto it = local.find(id);
+        return it != local.end() ? it->second : -1;
+    }
+    void setCorners(int p0, int p1, int p2)
+    {
+        triangles.push_back({p0, p1, p2});
+    }
+
+    /// Splits the boundary edge from \a from to \a to at the point \a pnt
+    void splitBoundary(int from, int to, int pnt)
+    {
+        int t = findEdge(from, to);
+        if (t < 0) {
+            return;
+        }
+        auto [k, w] = thirdPoint(t, from);
+        (void)k;
+        triangles[t] = {from, pnt, w};
+        triangles.push_back({pnt, to, w});
+        legalize(pnt);
+    }
+
+    /// Inserts a point lying inside the facet
+    void insertInterior(int pnt)
+    {
+        const Base::Vector2d& p = points[pnt];
+        int best = -1;
+        int bestSide = 0;
+        double bestDist = -std::numeric_limits<double>::max();
+        for (int t = 0; t < static_cast<int>(triangles.size()); t++) {
+            for (int i = 0; i < 3; i++) {
+                if (triangles[t][i] == pnt) {
+                    return;
+                }
+            }
+            double minDist = std::numeric_limits<double>::max();
+            int minSide = 0;
+            for (int i = 0; i < 3; i++) {
+                const Base::Vector2d& a = points[triangles[t][i]];
+                const Base::Vector2d& b = points[triangles[t][(i + 1) % 3]];
+                double len = (b - a).Length();
+                double dist = len > 0.0 ? orient(a, b, p) / len : 0.0;
+                if (dist < minDist) {
+                    minDist = dist;
+                    minSide = i;
+                }
+            }
+            if (minDist > bestDist) {
+                bestDist = minDist;
+                best = t;
+                bestSide = minSide;
+            }
+        }
+        if (best < 0) {
+            return;
+        }
+
+        std::array<int, 3> tri = triangles[best];
+        int u = tri[bestSide];
+        int v = tri[(bestSide + 1) % 3];
+        int w = tri[(bestSide + 2) % 3];
+        int opposite = bestDist <= eps ? findEdge(v, u) : -1;
+        if (opposite >= 0) {
+            // the point lies on an inner edge, split both triangles of the edge
+            int x = thirdPoint(opposite, v).second;
+            triangles[best] = {u, pnt, w};
+            triangles.push_back({pnt, v, w});
+            triangles[opposite] = {v, pnt, x};
+            triangles.push_back({pnt, u, x});
+        }
+        else {
+            triangles[best] = {u, v, pnt};
+            triangles.push_back({v, w, pnt});
+            triangles.push_back({w, u, pnt});
+        }
+        legalize(pnt);
+    }
+
+    /// Makes the segment from \a a to \a b an edge of the triangulation by flipping edges
+    void insertConstraint(int a, int b)
+    {
+        if (hasEdge(a, b)) {
+            return;
+        }
+
+        std::deque<std::pair<int, int>> crossing;
+        for (const auto& tri : triangles) {
+            for (int i = 0; i < 3; i++) {
+                int u = tri[i];
+                int v = tri[(i + 1) % 3];
+                if ((u < v || findEdge(v, u) < 0) && crosses(a, b, u, v)) {
+                    crossing.emplace_back(u, v);
+                }
+            }
+        }
+
+        // Each flip either removes a crossing edge or moves it to the back of the queue
+        std::size_t limit = 16 * (crossing.size() + 1) * (crossing.size() + 1);
+        for (std::size_t iter = 0; !crossing.empty() && iter < limit; iter++) {
+            auto [u, v] = crossing.front();
+            crossing.pop_front();
+            int t1 = findEdge(u, v);
+            int t2 = findEdge(v, u);
+            if (t1 < 0 || t2 < 0) {
+                continue;
+            }
+            int w1 = thirdPoint(t1, u).second;
+            int w2 = thirdPoint(t2, v).second;
+            const Base::Vector2d& p1 = points[w1];
+            const Base::Vector2d& p2 = points[w2];
+            if (orient(p1, p2, points[u]) * orient(p1, p2, points[v]) >= 0.0) {
+                // the quadrilateral is not convex
+                crossing.emplace_back(u, v);
+                continue;
+            }
+            triangles[t1] = {u, w2, w1};
+            triangles[t2] = {v, w1, w2};
+            if (crosses(a, b, w1, w2)) {
+                crossing.emplace_back(w1, w2);
+            }
+        }
+    }
+
+    /// Returns the points lying on the segment from \a a to \a b ordered from \a a to \a b
+    std::vector<int> pointsOnSegment(int a, int b) const
+    {
+        const Base::Vector2d& pa = points[a];
+        const Base::Vector2d& pb = points[b];
+        Base::Vector2d dir = pb - pa;
+        double len = dir.Length();
+        std::vector<std::pair<double, int>> inner;
+        if (len > 0.0) {
+            for (int i = 0; i < static_cast<int>(points.size()); i++) {
+                if (i == a || i == b) {
+                    continue;
+                }
+                double t = ((points[i] - pa) * dir) / (len * len);
+                double dist = std::fabs(orient(pa, pb, points[i])) / len;
+                if (dist <= eps && t * len > eps && (1.0 - t) * len > eps) {
+                    inner.emplace_back(t, i);
+                }
+            }
+        }
+        std::sort(inner.begin(), inner.end());
+
+        std::vector<int> chain;
+        chain.push_back(a);
+        for (const auto& it : inner) {
+            chain.push_back(it.second);
+        }
+        chain.push_back(b);
+        return chain;
+    }
+
+    std::vector<std::array<PointIndex, 3>> result() const
+    {
+        std::vector<std::array<PointIndex, 3>> tria;
+        tria.reserve(triangles.size());
+        for (const auto& tri : triangles) {
+            tria.push_back({ids[tri[0]], ids[tri[1]], ids[tri[2]]});
+        }
+        return tria;
+    }
+
+    PointIndex globalIndex(int index) const
+    {
+        return ids[index];
+    }
+
+private:
+    /// Flips the edges around the new point \a pnt until the triangulation is Delaunay
+    void legalize(int pnt)
+    {
+        std::vector<std::pair<int, int>> stack;
+        for (const auto& tri : triangles) {
+            for (int i = 0; i < 3; i++) {
+                if (tri[i] == pnt) {
+                    stack.emplace_back(tri[(i + 1) % 3], tri[(i + 2) % 3]);
+                }
+            }
+        }
+        while (!stack.empty()) {
+            auto [u, v] = stack.back();
+            stack.pop_back();
+            int t1 = findEdge(u, v);
+            int t2 = findEdge(v, u);
+            if (t1 < 0 || t2 < 0 || thirdPoint(t1, u).second != pnt) {
+                continue;
+            }
+            int x = thirdPoint(t2, v).second;
+            const Base::Vector2d& p = points[pnt];
+            const Base::Vector2d& q = points[x];
+            if (!inCircle(u, v, pnt, x)
+                || orient(p, q, points[u]) * orient(p, q, points[v]) >= 0.0) {
+                continue;
+            }
+            triangles[t1] = {u, x, pnt};
+            triangles[t2] = {v, pnt, x};
+            stack.emplace_back(u, x);
+            stack.emplace_back(x, v);
+        }
+    }
+    /// Checks if \a d lies inside the circumcircle of the counterclockwise triangle (a, b, c)
+    bool inCircle(int a, int b, int c, int d) const
+    {
+        const Base::Vector2d& pd = points[d];
+        Base::Vector2d pa = points[a] - pd;
+        Base::Vector2d pb = points[b] - pd;
+        Base::Vector2d pc = points[c] - pd;
+        double det = pa.Sqr() * (pb.x * pc.y - pc.x * pb.y)
+            + pb.Sqr() * (pc.x * pa.y - pa.x * pc.y) + pc.Sqr() * (pa.x * pb.y - pb.x * pa.y);
+        return det > 0.0;
+    }
+    int findEdge(int u, int v) const
+    {
+        for (int t = 0; t < static_cast<int>(triangles.size()); t++) {
+            const auto& tri = triangles[t];
+            for (int i = 0; i < 3; i++) {
+                if (tri[i] == u && tri[(i + 1) % 3] == v) {
+                    return t;
+                }
+            }
+        }
+        return -1;
+    }
+    bool hasEdge(int u, int v) const
+    {
+        return findEdge(u, v) >= 0 || findEdge(v, u) >= 0;
+    }
+    /// Returns the position of \a u in triangle \a t and the point following its successor
+    std::pair<int, int> thirdPoint(int t, int u) const
+    {
+        const auto& tri = triangles[t];
+        for (int i = 0; i < 3; i++) {
+            if (tri[i] == u) {
+                return {i, tri[(i + 2) % 3]};
+            }
+        }
+        return {0, tri[2]};
+    }
+    /// Checks if the segments (a, b) and (u, v) cross each other in their interior
+    bool crosses(int a, int b, int u, int v) const
+    {
+        if (a == u || a == v || b == u || b == v) {
+            return false;
+        }
+        const Base::Vector2d& pa = points[a];
+        const Base::Vector2d& pb = points[b];
+        const Base::Vector2d& pu = points[u];
+        const Base::Vector2d& pv = points[v];
+        return orient(pa, pb, pu) * orient(pa, pb, pv) < 0.0
+            && orient(pu, pv, pa) * orient(pu, pv, pb) < 0.0;
+    }
+
+private:
+    Projection proj;
+    double eps;
+    std::vector<Base::Vector2d> points;
+    std::vector<PointIndex> ids;
+    std::unordered_map<PointIndex, int> local;
+    std::vector<std::array<int, 3>> triangles;
+};
+
+/// The location of a piece of a facet relative to the other mesh
+enum class Location
+{
+    Inside,
+    Outside,
+    SameSide,      // lies on a facet of the other mesh with the same orientation
+    OppositeSide,  // lies on a facet of the other mesh with the opposite orientation
+};
+
+struct Piece
+{
+    std::array<PointIndex, 3> pnt;
+    FacetIndex facet;
+    Location location;
+};
+
+/// Cuts two meshes along their intersection curves and classifies the pieces
+class Corefinement
+{
+public:
+    Corefinement(const MeshKernel& mesh1, const MeshKernel& mesh2, double eps)
+    {
+        input.kernel = {&mesh1, &mesh2};
+        input.eps = eps;
+        input.planes[0] = facetPlanes(mesh1);
+        input.planes[1] = facetPlanes(mesh2);
+        offset = {0, mesh1.CountPoints(), mesh1.CountPoints() + mesh2.CountPoints()};
+    }
+
+    void cut()
+    {
+        segments = intersectMeshes(input);
+        weld();
+        collectCuts();
+        triangulate(0);
+        triangulate(1);
+    }
+
+    /// Returns the pieces of the facets of \a mesh with their location
+    std::vector<Piece> classify(int mesh) const;
+
+    /// Returns the coordinates of the merged point \a id
+    Base::Vector3f coordinate(PointIndex id) const
+    {
+        if (id < offset[1]) {
+            return input.point(0, id);
+        }
+        if (id < offset[2]) {
+            return input.point(1, id - offset[1]);
+        }
+        id -= offset[2];
+        return segments[id / 2].point[id % 2].pnt;
+    }
+
+private:
+    PointIndex cutPointId(std::size_t segment, int end) const
+    {
+        return offset[2] + 2 * segment + end;
+    }
+    PointIndex find(PointIndex id)
+    {
+        while (parent[id] != id) {
+            parent[id] = parent[parent[id]];
+            id = parent[id];
+        }
+        return id;
+    }
+    void unite(PointIndex a, PointIndex b)
+    {
+        a = find(a);
+        b = find(b);
+        // never merge two points of the same mesh
+        if (a == b || (vertexMask[a] & vertexMask[b]) != 0) {
+            return;
+        }
+        if (b < a) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        vertexMask[a] |= vertexMask[b];
+    }
+    void weld();
+    void collectCuts();
+    void triangulate(int mesh);
+    /// Returns the side of \a facet of \a mesh the edge \a feature lies on or -1
+    int sideOf(int mesh, FacetIndex facet, const Feature& feature) const;
+
+private:
+    Input input;
+    std::array<PointIndex, 3> offset {};
+    std::vector<CutSegment> segments;
+    /// The merged point of each point
+    std::vector<PointIndex> parent;
+    std::vector<unsigned char> vertexMask;
+    std::unordered_map<PointIndex, std::array<Feature, 2>> features;
+    std::array<std::unordered_map<FacetIndex, FacetCut>, 2> cuts;
+    std::array<std::unordered_map<FacetIndex, std::vector<std::array<PointIndex, 3>>>, 2> pieces;
+    std::array<std::vector<Constraint>, 2> constraints;
+};
+
+void Corefinement::weld()
+{
+    PointIndex total = offset[2] + 2 * segments.size();
+    parent.resize(total);
+    for (PointIndex i = 0; i < total; i++) {
+        parent[i] = i;
+    }
+    vertexMask.assign(total, 0);
+    std::fill(vertexMask.begin(), vertexMask.begin() + offset[1], 1);
+    std::fill(vertexMask.begin() + offset[1], vertexMask.begin() + offset[2], 2);
+
+    // the points of the curves and the corners of the cut facets
+    std::vector<PointIndex> candidates;
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        for (int mesh = 0; mesh < 2; mesh++) {
+            const MeshFacet& facet = input.facet(mesh, segments[i].facet[mesh]);
+            for (PointIndex p : facet._aulPoints) {
+                candidates.push_back(offset[mesh] + p);
+            }
+        }
+        candidates.push_back(cutPointId(i, 0));
+        candidates.push_back(cutPointId(i, 1));
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // sort the points into cells of size eps, points closer than eps are in adjacent cells
+    using Cell = std::array<long long, 3>;
+    double size = input.eps > 0.0 ? input.eps : 1.0;
+    auto cellOf = [size](const Base::Vector3f& pnt) {
+        return Cell {static_cast<long long>(std::floor(pnt.x / size)),
+                     static_cast<long long>(std::floor(pnt.y / size)),
+                     static_cast<long long>(std::floor(pnt.z / size))};
+    };
+    std::vector<std::pair<Cell, PointIndex>> cells;
+    cells.reserve(candidates.size());
+    for (PointIndex id : candidates) {
+        cells.emplace_back(cellOf(coordinate(id)), id);
+    }
+    std::sort(cells.begin(), cells.end());
+
+    double maxDist2 = input.eps * input.eps;
+    for (const auto& [cell, id] : cells) {
+        Vec pnt = toVec(coordinate(id));
+        for (long long dx = -1; dx <= 1; dx++) {
+            for (long long dy = -1; dy <= 1; dy++) {
+                for (long long dz = -1; dz <= 1; dz++) {
+                    Cell next {cell[0] + dx, cell[1] + dy, cell[2] + dz};
+                    auto it = std::lower_bound(cells.begin(),
+                                               cells.end(),
+                                               std::make_pair(next, PointIndex(0)));
+                    for (; it != cells.end() && it->first == next; ++it) {
+                        if (it->second > id
+                            && Base::DistanceP2(pnt, toVec(coordinate(it->second))) <= maxDist2) {
+                            unite(id, it->second);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // the merged point keeps the most specific location on each mesh
+    auto merge = [this](PointIndex id, const std::array<Feature, 2>& feature) {
+        auto& merged = features[find(id)];
+        for (int mesh = 0; mesh < 2; mesh++) {
+            if (feature[mesh].kind > merged[mesh].kind) {
+                merged[mesh] = feature[mesh];
+            }
+        }
+    };
+    for (PointIndex id : candidates) {
+        if (id < offset[2]) {
+            int mesh = id < offset[1] ? 0 : 1;
+            std::array<Feature, 2> feature;
+            feature[mesh] = makeFeature(Feature::Vertex, id - offset[mesh]);
+            merge(id, feature);
+        }
+        else {
+            PointIndex index = id - offset[2];
+            merge(id, segments[index / 2].point[index % 2].feature);
+        }
+    }
+
+    // resolve all merged points so that the parent array can be shared by the threads
+    for (PointIndex i = 0; i < total; i++) {
+        find(i);
+    }
+}
+
+void Corefinement::collectCuts()
+{
+    for (const auto& [id, feature] : features) {
+        for (int mesh = 0; mesh < 2; mesh++) {
+            const Feature& where = feature[mesh];
+            if (where.kind == Feature::Facet) {
+                cuts[mesh][where.index].points.push_back(id);
+            }
+            else if (where.kind == Feature::Edge) {
+                cuts[mesh][where.index].points.push_back(id);
+                FacetIndex neighbour = input.facet(mesh, where.index)._aulNeighbours[where.side];
+                if (neighbour != FACET_INDEX_MAX) {
+                    cuts[mesh][neighbour].points.push_back(id);
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        const CutSegment& seg = segments[i];
+        PointIndex a = parent[cutPointId(i, 0)];
+        PointIndex b = parent[cutPointId(i, 1)];
+        if (a == b) {
+            continue;
+        }
+        for (int mesh = 0; mesh < 2; mesh++) {
+            if (!seg.coplanar || seg.owner == mesh) {
+                Constraint constraint {{a, b}, seg.facet[1 - mesh], seg.coplanar};
+                cuts[mesh][seg.facet[mesh]].constraints.push_back(constraint);
+            }
+            if (seg.coplanar) {
+                cuts[mesh][seg.facet[mesh]].coplanar.push_back(seg.facet[1 - mesh]);
+            }
+        }
+    }
+}
+
+int Corefinement::sideOf(int mesh, FacetIndex facet, const Feature& feature) const
+{
+    if (feature.kind != Feature::Edge) {
+        return -1;
+    }
+    if (feature.index == facet) {
+        return feature.side;
+    }
+    const MeshFacet& edgeFacet = input.facet(mesh, feature.index);
+    PointIndex p = edgeFacet._aulPoints[feature.side];
+    PointIndex q = edgeFacet._aulPoints[(feature.side + 1) % 3];
+    const MeshFacet& face = input.facet(mesh, facet);
+    for (int i = 0; i < 3; i++) {
+        PointIndex u = face._aulPoints[i];
+        PointIndex v = face._aulPoints[(i + 1) % 3];
+        if ((u == p && v == q) || (u == q && v == p)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void Corefinement::triangulate(int mesh)
+{
+    std::vector<std::pair<FacetIndex, const FacetCut*>> todo;
+    todo.reserve(cuts[mesh].size());
+    for (const auto& it : cuts[mesh]) {
+        todo.emplace_back(it.first, &it.second);
+    }
+    std::sort(todo.begin(), todo.end());
+
+    std::vector<std::vector<std::array<PointIndex, 3>>> triangles(todo.size());
+    std::vector<std::vector<Constraint>> edges(todo.size());
+    parallel_blocks(todo.size(), BlockCuts, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            FacetIndex index = todo[i].first;
+            const FacetCut& cut = *todo[i].second;
+            const MeshFacet& facet = input.facet(mesh, index);
+            FacetTriangulation tria(Projection(input.planes[mesh][index].normal), input.eps);
+
+            std::array<int, 3> corner {};
+            std::array<Vec, 3> pnt;
+            for (int k = 0; k < 3; k++) {
+                PointIndex id = parent[offset[mesh] + facet._aulPoints[k]];
+                pnt[k] = toVec(coordinate(id));
+                corner[k] = tria.addPoint(id, pnt[k]);
+            }
+            if (corner[0] == corner[1] || corner[1] == corner[2] || corner[2] == corner[0]) {
+                continue;
+            }
+            tria.setCorners(corner[0], corner[1], corner[2]);
+
+            // split the sides first, ordered along each side
+            std::array<std::vector<std::pair<double, PointIndex>>, 3> onSide;
+            std::vector<PointIndex> interior;
+            std::vector<PointIndex> points = cut.points;
+            std::sort(points.begin(), points.end());
+            points.erase(std::unique(points.begin(), points.end()), points.end());
+            for (PointIndex id : points) {
+                if (tria.localIndex(id) >= 0) {
+                    continue;
+                }
+                int side = sideOf(mesh, index, features.at(id)[mesh]);
+                if (side < 0) {
+                    interior.push_back(id);
+                }
+                else {
+                    Vec dir = pnt[(side + 1) % 3] - pnt[side];
+                    double t = (toVec(coordinate(id)) - pnt[side]) * dir / dir.Sqr();
+                    onSide[side].emplace_back(std::clamp(t, 0.0, 1.0), id);
+                }
+            }
+            for (int k = 0; k < 3; k++) {
+                // the points are put exactly onto the side to keep the order along the side
+                std::sort(onSide[k].begin(), onSide[k].end());
+                int from = corner[k];
+                Vec dir = pnt[(k + 1) % 3] - pnt[k];
+                for (const auto& it : onSide[k]) {
+                    int next = tria.addPoint(it.second, pnt[k] + dir * it.first);
+                    tria.splitBoundary(from, corner[(k + 1) % 3], next);
+                    from = next;
+                }
+            }
+            for (PointIndex id : interior) {
+                tria.insertInterior(tria.addPoint(id, toVec(coordinate(id))));
+            }
+
+            // then make the segments of the intersection curves edges of the triangulation
+            for (const Constraint& constraint : cut.constraints) {
+                std::array<int, 2> ends {};
+                for (int k = 0; k < 2; k++) {
+                    ends[k] = tria.localIndex(constraint.pnt[k]);
+                    if (ends[k] < 0) {
+                        PointIndex id = constraint.pnt[k];
+                        ends[k] = tria.addPoint(id, toVec(coordinate(id)));
+                        tria.insertInterior(ends[k]);
+                    }
+                }
+                std::vector<int> chain = tria.pointsOnSegment(ends[0], ends[1]);
+                for (std::size_t k = 0; k + 1 < chain.size(); k++) {
+                    tria.insertConstraint(chain[k], chain[k + 1]);
+                    Constraint part = constraint;
+                    part.pnt[0] = tria.globalIndex(chain[k]);
+                    part.pnt[1] = tria.globalIndex(chain[k + 1]);
+                    edges[i].push_back(part);
+                }
+            }
+
+            triangles[i] = tria.result();
+        }
+    });
+
+    for (std::size_t i = 0; i < todo.size(); i++) {
+        pieces[mesh][todo[i].first] = std::move(triangles[i]);
+        constraints[mesh].insert(constraints[mesh].end(), edges[i].begin(), edges[i].end());
+    }
+}
+
+std::vector<Piece> Corefinement::classify(int mesh) const
+{
+    const MeshFacetArray& facets = input.kernel[mesh]->GetFacets();
+    const std::vector<Plane>& otherPlanes = input.planes[1 - mesh];
+
+    std::vector<Piece> result;
+    result.reserve(facets.size());
+    auto addPiece = [&result](const std::array<PointIndex, 3>& pnt, FacetIndex facet) {
+        if (pnt[0] != pnt[1] && pnt[1] != pnt[2] && pnt[2] != pnt[0]) {
+            result.push_back({pnt, facet, Location::Outside});
+        }
+    };
+    for (FacetIndex i = 0; i < facets.size(); i++) {
+        auto it = pieces[mesh].find(i);
+        if (it != pieces[mesh].end()) {
+            for (const auto& pnt : it->second) {
+                addPiece(pnt, i);
+            }
+        }
+        else {
+            std::array<PointIndex, 3> pnt {};
+            for (int k = 0; k < 3; k++) {
+                pnt[k] = parent[offset[mesh] + facets[i]._aulPoints[k]];
+            }
+            addPiece(pnt, i);
+        }
+    }
+
+    auto centerOf = [this](const Piece& piece) {
+        Vec center;
+        for (PointIndex id : piece.pnt) {
+            center += toVec(coordinate(id));
+        }
+        return center / 3.0;
+    };
+
+    // pieces lying on a coplanar facet of the other mesh
+    std::vector<bool> coplanar(result.size(), false);
+    for (std::size_t i = 0; i < result.size(); i++) {
+        auto it = cuts[mesh].find(result[i].facet);
+        if (it == cuts[mesh].end() || it->second.coplanar.empty()) {
+            continue;
+        }
+        Vec center = centerOf(result[i]);
+        for (FacetIndex other : it->second.coplanar) {
+            const Plane& plane = otherPlanes[other];
+            Projection proj(plane.normal);
+            Base::Vector2d pnt = proj(center);
+            const MeshFacet& facet = input.facet(1 - mesh, other);
+            bool inside = true;
+            for (int k = 0; k < 3 && inside; k++) {
+                PointIndex p = facet._aulPoints[k];
+                PointIndex q = facet._aulPoints[(k + 1) % 3];
+                Base::Vector2d a = proj(toVec(input.point(1 - mesh, p)));
+                Base::Vector2d b = proj(toVec(input.point(1 - mesh, q)));
+                inside = orient(a, b, pnt) > 0.0;
+            }
+            if (inside) {
+                bool same = input.planes[mesh][result[i].facet].normal * plane.normal > 0.0;
+                result[i].location = same ? Location::SameSide : Location::OppositeSide;
+                coplanar[i] = true;
+                break;
+            }
+        }
+    }
+
+    // connect the pieces sharing an edge that is not part of an intersection curve
+    using EdgeKey = std::pair<PointIndex, PointIndex>;
+    auto keyOf = [](PointIndex a, PointIndex b) {
+        return a < b ? EdgeKey(a, b) : EdgeKey(b, a);
+    };
+    std::vector<EdgeKey> curves;
+    curves.reserve(constraints[mesh].size());
+    for (const Constraint& constraint : constraints[mesh]) {
+        curves.push_back(keyOf(constraint.pnt[0], constraint.pnt[1]));
+    }
+    std::vector<std::size_t> curveOrder(curves.size());
+    for (std::size_t i = 0; i < curveOrder.size(); i++) {
+        curveOrder[i] = i;
+    }
+    std::sort(curveOrder.begin(), curveOrder.end(), [&curves](std::size_t a, std::size_t b) {
+        return curves[a] < curves[b];
+    });
+    std::vector<EdgeKey> sortedCurves;
+    sortedCurves.reserve(curves.size());
+    for (std::size_t i : curveOrder) {
+        sortedCurves.push_back(curves[i]);
+    }
+
+    std::vector<std::pair<EdgeKey, std::size_t>> edges;
+    edges.reserve(3 * result.size());
+    for (std::size_t i = 0; i < result.size(); i++) {
+        if (!coplanar[i]) {
+            for (int k = 0; k < 3; k++) {
+                edges.emplace_back(keyOf(result[i].pnt[k], result[i].pnt[(k + 1) % 3]), i);
+            }
+        }
+    }
+    parallel_sort(edges.begin(),
+                  edges.end(),
+                  std::less<>(),
+                  static_cast<int>(std::max(1U, std::thread::hardware_concurrency())));
+
+    std::vector<std::size_t> region(result.size());
+    for (std::size_t i = 0; i < region.size(); i++) {
+        region[i] = i;
+    }
+    auto findRegion = [&region](std::size_t i) {
+        while (region[i] != i) {
+            region[i] = region[region[i]];
+            i = region[i];
+        }
+        return i;
+    };
+    for (std::size_t i = 0; i < edges.size();) {
+        std::size_t j = i + 1;
+        while (j < edges.size() && edges[j].first == edges[i].first) {
+            j++;
+        }
+        if (!std::binary_search(sortedCurves.begin(), sortedCurves.end(), edges[i].first)) {
+            for (std::size_t k = i + 1; k < j; k++) {
+                std::size_t a = findRegion(edges[i].second);
+                std::size_t b = findRegion(edges[k].second);
+                region[std::max(a, b)] = std::min(a, b);
+            }
+        }
+        i = j;
+    }
+
+    // a piece next to a curve lies on one side of the plane of the facet that cut it
+    std::vector<int> inside(result.size(), 0);
+    std::vector<int> outside(result.size(), 0);
+    std::vector<std::size_t> largest(result.size(), 0);
+    std::vector<double> area(result.size(), -1.0);
+    double minDist = 0.01 * input.eps;
+    for (std::size_t i = 0; i < result.size(); i++) {
+        if (coplanar[i]) {
+            continue;
+        }
+        std::size_t root = findRegion(i);
+        Vec p0 = toVec(coordinate(result[i].pnt[0]));
+        Vec p1 = toVec(coordinate(result[i].pnt[1]));
+        Vec p2 = toVec(coordinate(result[i].pnt[2]));
+        double size = ((p1 - p0) % (p2 - p0)).Length();
+        if (size > area[root]) {
+            area[root] = size;
+            largest[root] = i;
+        }
+        if (pieces[mesh].find(result[i].facet) == pieces[mesh].end()) {
+            continue;
+        }
+
+        Vec center = centerOf(result[i]);
+        for (int k = 0; k < 3; k++) {
+            EdgeKey key = keyOf(result[i].pnt[k], result[i].pnt[(k + 1) % 3]);
+            auto range = std::equal_range(sortedCurves.begin(), sortedCurves.end(), key);
+            for (auto it = range.first; it != range.second; ++it) {
+                const Constraint& constraint =
+                    constraints[mesh][curveOrder[it - sortedCurves.begin()]];
+                if (constraint.coplanar) {
+                    continue;
+                }
+                double dist = otherPlanes[constraint.other].distance(center);
+                if (dist < -minDist) {
+                    inside[i]++;
+                }
+                else if (dist > minDist) {
+                    outside[i]++;
+                }
+            }
+        }
+    }
+
+    std::vector<int> regionInside(result.size(), 0);
+    std::vector<int> regionOutside(result.size(), 0);
+    for (std::size_t i = 0; i < result.size(); i++) {
+        std::size_t root = findRegion(i);
+        regionInside[root] += inside[i];
+        regionOutside[root] += outside[i];
+    }
+
+    // 1: inside, -1: outside, 0: not yet known
+    std::vector<signed char> state(result.size(), 0);
+    std::vector<std::size_t> front;
+    bool conflicts = false;
+    for (std::size_t i = 0; i < result.size(); i++) {
+        std::size_t root = findRegion(i);
+        if (coplanar[i] || (regionInside[root] == 0 && regionOutside[root] == 0)) {
+            continue;
+        }
+        if (regionOutside[root] == 0) {
+            state[i] = 1;
+        }
+        else if (regionInside[root] == 0) {
+            state[i] = -1;
+        }
+        else if ((inside[i] == 0) != (outside[i] == 0)) {
+            // A curve that did not become an edge connects both sides, the pieces of the
+            // region take the state of the nearest piece with a vote
+            state[i] = inside[i] > 0 ? 1 : -1;
+            front.push_back(i);
+            conflicts = true;
+        }
+        else {
+            conflicts = true;
+        }
+    }
+    if (conflicts) {
+        std::vector<std::vector<std::size_t>> neighbours(result.size());
+        for (std::size_t i = 0; i < edges.size();) {
+            std::size_t j = i + 1;
+            while (j < edges.size() && edges[j].first == edges[i].first) {
+                j++;
+            }
+            if (!std::binary_search(sortedCurves.begin(), sortedCurves.end(), edges[i].first)) {
+                for (std::size_t k = i; k < j; k++) {
+                    for (std::size_t l = i; l < j; l++) {
+                        if (k != l) {
+                            neighbours[edges[k].second].push_back(edges[l].second);
+                        }
+                    }
+                }
+            }
+            i = j;
+        }
+        for (std::size_t next = 0; next < front.size(); next++) {
+            std::size_t piece = front[next];
+            for (std::size_t neighbour : neighbours[piece]) {
+                if (state[neighbour] == 0) {
+                    state[neighbour] = state[piece];
+                    front.push_back(neighbour);
+                }
+            }
+        }
+    }
+
+    // the remaining regions and pieces are decided by the winding number of the other mesh
+    std::vector<std::size_t> undecided;
+    std::vector<Vec> queries;
+    for (std::size_t i = 0; i < result.size(); i++) {
+        std::size_t root = findRegion(i);
+        if (coplanar[i] || state[i] != 0) {
+            continue;
+        }
+        if (regionInside[root] == 0 && regionOutside[root] == 0) {
+            if (root == i) {
+                undecided.push_back(i);
+                queries.push_back(centerOf(result[largest[i]]));
+            }
+        }
+        else {
+            undecided.push_back(i);
+            queries.push_back(centerOf(result[i]));
+        }
+    }
+    std::vector<double> winding = windingNumbers(*input.kernel[1 - mesh], queries);
+    for (std::size_t i = 0; i < undecided.size(); i++) {
+        state[undecided[i]] = winding[i] > 0.5 ? 1 : -1;
+    }
+
+    for (std::size_t i = 0; i < result.size(); i++) {
+        if (!coplanar[i]) {
+            signed char value = state[i] != 0 ? state[i] : state[findRegion(i)];
+            result[i].location = value > 0 ? Location::Inside : Location::Outside;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace
+
+
+MeshBoolean::MeshBoolean(const MeshKernel& mesh1,
+                         const MeshKernel& mesh2,
+                         MeshKernel& result,
+                         SetOperations::OperationType opType,
+                         float minDistanceToPoint)
+    : _mesh1(mesh1)
+    , _mesh2(mesh2)
+    , _resultMesh(result)
+    , _operationType(opType)
+    , _minDistanceToPoint(minDistanceToPoint)
+{}
+
+void MeshBoolean::Do()
+{
+    Corefinement core(_mesh1, _mesh2, _minDistanceToPoint);
+    core.cut();
+
+    // the pieces of each mesh to keep, the pieces of the second mesh are flipped for a difference
+    std::array<std::vector<Location>, 2> keep;
+    bool flip = false;
+    switch (_operationType) {
+        case SetOperations::Union:
+            keep[0] = {Location::Outside, Location::SameSide};
+            keep[1] = {Location::Outside};
+            break;
+        case SetOperations::Intersect:
+            keep[0] = {Location::Inside, Location::SameSide};
+            keep[1] = {Location::Inside};
+            break;
+        case SetOperations::Difference:
+            keep[0] = {Location::Outside, Location::OppositeSide};
+            keep[1] = {Location::Inside};
+            flip = true;
+            break;
+        case SetOperations::Inner:
+            keep[0] = {Location::Inside, Location::SameSide};
+            break;
+        case SetOperations::Outer:
+            keep[0] = {Location::Outside, Location::OppositeSide};
+            break;
+    }
+
+    MeshPointArray points;
+    MeshFacetArray facets;
+    std::unordered_map<PointIndex, PointIndex> pointIndex;
+    auto indexOf = [&](PointIndex id) {
+        auto it = pointIndex.find(id);
+        if (it != pointIndex.end()) {
+            return it->second;
+        }
+        PointIndex index = points.size();
+        pointIndex[id] = index;
+        points.push_back(core.coordinate(id));
+        return index;
+    };
+
+    for (int mesh = 0; mesh < 2; mesh++) {
+        if (keep[mesh].empty()) {
+            continue;
+        }
+        for (const Piece& piece : core.classify(mesh)) {
+            if (std::find(keep[mesh].begin(), keep[mesh].end(), piece.location)
+                == keep[mesh].end()) {
+                continue;
+            }
+            MeshFacet facet;
+            facet._aulPoints[0] = indexOf(piece.pnt[0]);
+            facet._aulPoints[1] = indexOf(piece.pnt[1]);
+            facet._aulPoints[2] = indexOf(piece.pnt[2]);
+            if (mesh == 1 && flip) {
+                std::swap(facet._aulPoints[1], facet._aulPoints[2]);
+            }
+            facets.push_back(facet);
+        }
+    }
+
+    _resultMesh.Adopt(points, facets, true);
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_BOOLEAN_H
+#define MESH_BOOLEAN_H
+
+#include "SetOperations.h"
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshBoolean class computes the set operations of two closed meshes by corefinement.
+ *
+ * Both meshes are cut along their intersection curves: the facets crossed by a curve are
+ * triangulated again so that their pieces share the points and edges of the curve with the
+ * pieces of the other mesh. A piece next to a cut lies on one side of the plane of the facet
+ * that cut it, which tells whether it is inside or outside the other mesh. The pieces connected
+ * without crossing a cut share this state. Pieces that cannot be decided this way, e.g. meshes
+ * that do not intersect at all, are classified by the winding number of the other mesh.
+ * Pieces lying on a facet of the other mesh (coplanar facets) are kept at most once, depending
+ * on the orientation of both facets.
+ *
+ * The search for intersecting facets, the triangulation of the cut facets and the winding
+ * numbers are computed on several threads.
+ */
+class MeshExport MeshBoolean
+{
+public:
+    /// Construction
+    MeshBoolean(const MeshKernel& mesh1,
+                const MeshKernel& mesh2,
+                MeshKernel& result,
+                SetOperations::OperationType opType,
+                float minDistanceToPoint = 1e-5F);
+
+    /** Computes the result mesh. Points of the intersection curves closer than
+     * minDistanceToPoint to each other or to a point of the meshes are merged.
+     */
+    void Do();
+
+private:
+    const MeshKernel& _mesh1;                    /** Mesh for set operations source 1 */
+    const MeshKernel& _mesh2;                    /** Mesh for set operations source 2 */
+    MeshKernel& _resultMesh;                     /** Result mesh */
+    SetOperations::OperationType _operationType; /** Set Operation Type */
+    float _minDistanceToPoint;                   /** Minimal distance to facet corner points */
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BOOLEAN_H
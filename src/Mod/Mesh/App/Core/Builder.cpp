@@ -24,6 +24,9 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <cstring>
+#include <future>
+#include <thread>
 #endif
 
 #include <Base/Exception.h>
@@ -229,6 +232,7 @@ void MeshBuilder::RemoveUnreferencedPoints()
 
 void MeshBuilder::Finish(bool freeMemory)
 {
+    _meshKernel._ulStamp++;
     // now we can resize the vertex array to the exact size and copy the vertices with their correct
     // positions in the array
     PointIndex i = 0;
@@ -358,6 +362,45 @@ void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
     }
 }
 
+void MeshFastBuilder::AddFacets(const char* data, size_type count, std::size_t stride)
+{
+    QVector<Private::Vertex>& verts = p->verts;
+    size_type offset = verts.size();
+    verts.resize(offset + 3 * count);
+    Private::Vertex* facetVerts = verts.data() + offset;
+
+    auto decode = [data, stride, facetVerts](size_type begin, size_type end) {
+        // the last point of a record comes first
+        const int order[3] = {2, 0, 1};
+        float coords[9];
+        for (size_type i = begin; i < end; ++i) {
+            std::memcpy(coords, data + static_cast<std::size_t>(i) * stride, sizeof(coords));
+            for (int j = 0; j < 3; j++) {
+                Private::Vertex& v = facetVerts[3 * i + j];
+                v.x = coords[3 * order[j]];
+                v.y = coords[3 * order[j] + 1];
+                v.z = coords[3 * order[j] + 2];
+            }
+        }
+    };
+
+    // small meshes are not worth starting threads for
+    const size_type minChunk = 0x10000;
+    int threads = std::max(1, int(std::thread::hardware_concurrency()));
+    threads = std::max(1, std::min(threads, count / minChunk));
+    size_type chunk = count / threads;
+
+    std::vector<std::future<void>> futures;
+    for (int t = 1; t < threads; t++) {
+        size_type end = t + 1 < threads ? (t + 1) * chunk : count;
+        futures.push_back(std::async(std::launch::async, decode, t * chunk, end));
+    }
+    decode(0, std::min(chunk, count));
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 void MeshFastBuilder::Finish()
 {
     using size_type = QVector<Private::Vertex>::size_type;
@@ -218,6 +218,12 @@ public:
     /** Add new facet
      */
     void AddFacet(const MeshGeomFacet& facetPoints);
+    /** Adds \a count facets stored in \a data as records of \a stride bytes. Each record
+     * starts with the nine float coordinates of the facet points. The records are decoded
+     * on several threads. As in MeshInput::LoadBinarySTL() the points of a facet are added
+     * in the order 3, 1, 2.
+     */
+    void AddFacets(const char* data, size_type count, std::size_t stride);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
@@ -23,14 +23,9 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
-#include <functional>
 #include <limits>
 #endif
 
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
-
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -43,13 +38,13 @@
 
 #include "Approximation.h"
 #include "Curvature.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Tools.h"
 
 
 using namespace MeshCore;
-namespace sp = std::placeholders;
 
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
     : myKernel(kernel)
@@ -82,16 +77,12 @@ void MeshCurvature::ComputePerFace(bool parallel)
         }
     }
     else {
-        // NOLINTBEGIN
-        QFuture<CurvatureInfo> future =
-            QtConcurrent::mapped(mySegment, std::bind(&FacetCurvature::Compute, &face, sp::_1));
-        // NOLINTEND
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
-        for (const auto& it : future) {
-            myCurvature.push_back(it);
-        }
+        myCurvature.resize(mySegment.size());
+        parallel_blocks(mySegment.size(), 0x400, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                myCurvature[i] = face.Compute(mySegment[i]);
+            }
+        });
     }
 }
 
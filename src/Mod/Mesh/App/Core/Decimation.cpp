@@ -22,54 +22,81 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <unordered_map>
 #endif
 
+#include <Base/BoundBox.h>
+
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
+namespace
+{
+/// Number of facets of a block that is simplified on its own
+constexpr std::size_t BlockFacets = 0x20000;
+/// Number of bins of the histogram used to split the mesh into blocks
+constexpr std::size_t HistogramBins = 0x10000;
+/// Marks a point used by the facets of several blocks
+constexpr int SharedPoint = -1;
+/// Marks a point not used by any facet
+constexpr int NoBlock = -2;
+/// Weight of the quadrics of boundary and sharp edges relative to the quadrics of the facets
+constexpr double FeatureWeight = 1000.0;
 
-void MeshSimplify::simplify(float tolerance, float reduction)
+Simplify::Vertex makeVertex(const Base::Vector3f& pnt, bool locked, int id)
 {
-    Simplify alg;
+    Simplify::Vertex v;
+    v.tstart = 0;
+    v.tcount = 0;
+    v.border = 0;
+    v.locked = locked ? 1 : 0;
+    v.id = id;
+    v.p = pnt;
+    return v;
+}
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+Simplify::Triangle makeTriangle(int v0, int v1, int v2)
+{
+    Simplify::Triangle t;
+    t.deleted = 0;
+    t.dirty = 0;
+    for (double& j : t.err) {
+        j = 0.0;
     }
+    t.v[0] = v0;
+    t.v[1] = v1;
+    t.v[2] = v2;
+    return t;
+}
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
-        }
-        alg.triangles.push_back(t);
+void initSimplify(Simplify& alg, const MeshKernel& kernel, const std::vector<bool>& fixed)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    alg.vertices.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        bool locked = i < fixed.size() && fixed[i];
+        alg.vertices.push_back(makeVertex(points[i], locked, static_cast<int>(i)));
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
-
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    const MeshFacetArray& facets = kernel.GetFacets();
+    alg.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
+        alg.triangles.push_back(makeTriangle(static_cast<int>(facet._aulPoints[0]),
+                                             static_cast<int>(facet._aulPoints[1]),
+                                             static_cast<int>(facet._aulPoints[2])));
+    }
+}
 
-    // Simplification done
+void adoptSimplify(const Simplify& alg, MeshKernel& kernel)
+{
     MeshPointArray new_points;
     new_points.reserve(alg.vertices.size());
     for (const auto& vertex : alg.vertices) {
@@ -94,64 +121,264 @@ void MeshSimplify::simplify(float tolerance, float reduction)
         }
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    kernel.Adopt(new_points, new_facets, true);
 }
 
-void MeshSimplify::simplify(int targetSize)
+/**
+ * Splits the facets into slabs of about BlockFacets facets along the longest axis of the
+ * bounding box. With \a shifted the boundaries are moved by half a slab so that they lie
+ * inside the slabs of the unshifted partition.
+ */
+std::vector<std::vector<FacetIndex>>
+makeBlocks(const MeshPointArray& points, const MeshFacetArray& facets, bool shifted)
 {
-    Simplify alg;
+    Base::BoundBox3f box;
+    for (const auto& pnt : points) {
+        box.Add(pnt);
+    }
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    float lengths[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    auto axis = static_cast<unsigned short>(std::max_element(lengths, lengths + 3) - lengths);
+    float minValue = axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+    float binWidth =
+        std::max(lengths[axis] / float(HistogramBins), std::numeric_limits<float>::min());
+
+    std::vector<std::size_t> bins(facets.size());
+    std::vector<std::size_t> histogram(HistogramBins, 0);
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        const auto& pnts = facets[i]._aulPoints;
+        float center =
+            (points[pnts[0]][axis] + points[pnts[1]][axis] + points[pnts[2]][axis]) / 3.0F;
+        auto bin = static_cast<long>((center - minValue) / binWidth);
+        bins[i] = static_cast<std::size_t>(std::clamp<long>(bin, 0, long(HistogramBins) - 1));
+        histogram[bins[i]]++;
+    }
+
+    std::size_t count = shifted ? BlockFacets / 2 : 0;
+    std::vector<std::size_t> binToBlock(HistogramBins);
+    for (std::size_t bin = 0; bin < HistogramBins; bin++) {
+        binToBlock[bin] = count / BlockFacets;
+        count += histogram[bin];
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
+    std::vector<std::vector<FacetIndex>> blocks(binToBlock.back() + 1);
     for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
+        blocks[binToBlock[bins[i]]].push_back(i);
+    }
+    blocks.erase(std::remove_if(blocks.begin(),
+                                blocks.end(),
+                                [](const auto& block) {
+                                    return block.empty();
+                                }),
+                 blocks.end());
+    return blocks;
+}
+
+/**
+ * Simplifies the blocks of the mesh on several threads. The points used by several blocks are
+ * locked, so the simplified blocks still fit together. With \a reserveSeams the facets at the
+ * block boundaries are left for a later pass, i.e. the blocks are reduced less so that the
+ * later pass can still reach \a targetSize.
+ */
+void simplifyBlocks(MeshPointArray& points,
+                    MeshFacetArray& facets,
+                    std::vector<bool>& locked,
+                    const std::vector<std::vector<FacetIndex>>& blocks,
+                    std::size_t targetSize,
+                    double maxQuadric,
+                    double featureCos,
+                    bool reserveSeams)
+{
+    // the block of each point or SharedPoint
+    std::vector<int> owner(points.size(), NoBlock);
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        for (FacetIndex index : blocks[b]) {
+            for (PointIndex pnt : facets[index]._aulPoints) {
+                if (owner[pnt] == NoBlock) {
+                    owner[pnt] = static_cast<int>(b);
+                }
+                else if (owner[pnt] != static_cast<int>(b)) {
+                    owner[pnt] = SharedPoint;
+                }
+            }
+        }
+    }
+
+    // Each block uses its own algorithm object. A vertex keeps the index of its point in
+    // globalIndex as id.
+    std::vector<Simplify> algs(blocks.size());
+    std::vector<std::vector<PointIndex>> globalIndex(blocks.size());
+    std::vector<int> localIndex(points.size(), -1);
+    double ratio = double(targetSize) / double(facets.size());
+    if (reserveSeams) {
+        std::size_t numSeam = std::count_if(facets.begin(), facets.end(), [&](const auto& f) {
+            return std::any_of(std::begin(f._aulPoints), std::end(f._aulPoints), [&](auto p) {
+                return owner[p] == SharedPoint;
+            });
+        });
+        ratio += double(numSeam) * (1.0 - ratio) / double(facets.size());
+    }
+
+    parallel_blocks(blocks.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; b++) {
+            Simplify& alg = algs[b];
+            std::vector<PointIndex>& global = globalIndex[b];
+            std::unordered_map<PointIndex, int> sharedIndex;
+
+            // the entries of localIndex of the points that are not shared are written by
+            // the block of the point only
+            auto local = [&](PointIndex pnt) {
+                bool shared = owner[pnt] == SharedPoint;
+                int index = localIndex[pnt];
+                if (shared) {
+                    auto it = sharedIndex.find(pnt);
+                    index = it != sharedIndex.end() ? it->second : -1;
+                }
+                if (index < 0) {
+                    index = static_cast<int>(global.size());
+                    global.push_back(pnt);
+                    alg.vertices.push_back(makeVertex(points[pnt], locked[pnt] || shared, index));
+                    if (shared) {
+                        sharedIndex[pnt] = index;
+                    }
+                    else {
+                        localIndex[pnt] = index;
+                    }
+                }
+                return index;
+            };
+
+            alg.triangles.reserve(blocks[b].size());
+            for (FacetIndex index : blocks[b]) {
+                const auto& pnts = facets[index]._aulPoints;
+                int v0 = local(pnts[0]);
+                int v1 = local(pnts[1]);
+                int v2 = local(pnts[2]);
+                alg.triangles.push_back(makeTriangle(v0, v1, v2));
+            }
+
+            alg.max_error = maxQuadric;
+            alg.feature_weight = FeatureWeight;
+            alg.feature_cos = featureCos;
+            auto target = static_cast<int>(double(blocks[b].size()) * ratio + 0.5);
+            alg.simplify_mesh(target, maxQuadric);
         }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+    });
+
+    // Put the blocks together again. A shared point is added once with its unchanged position.
+    MeshPointArray newPoints;
+    MeshFacetArray newFacets;
+    std::vector<bool> newLocked;
+    std::vector<PointIndex> sharedPoints(points.size(), POINT_INDEX_MAX);
+    std::vector<PointIndex> pointMap;
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        const Simplify& alg = algs[b];
+        pointMap.resize(alg.vertices.size());
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            PointIndex pnt = globalIndex[b][alg.vertices[i].id];
+            if (owner[pnt] == SharedPoint) {
+                if (sharedPoints[pnt] == POINT_INDEX_MAX) {
+                    sharedPoints[pnt] = newPoints.size();
+                    newPoints.push_back(points[pnt]);
+                    newLocked.push_back(locked[pnt]);
+                }
+                pointMap[i] = sharedPoints[pnt];
+            }
+            else {
+                pointMap[i] = newPoints.size();
+                newPoints.push_back(alg.vertices[i].p);
+                newLocked.push_back(locked[pnt]);
+            }
+        }
+
+        for (const auto& triangle : alg.triangles) {
+            MeshFacet face;
+            face._aulPoints[0] = pointMap[triangle.v[0]];
+            face._aulPoints[1] = pointMap[triangle.v[1]];
+            face._aulPoints[2] = pointMap[triangle.v[2]];
+            newFacets.push_back(face);
         }
-        alg.triangles.push_back(t);
     }
 
+    points.swap(newPoints);
+    facets.swap(newFacets);
+    locked.swap(newLocked);
+}
+}  // namespace
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshSimplify::fixPoints(const std::vector<PointIndex>& points)
+{
+    myFixedPoints.assign(myKernel.CountPoints(), false);
+    for (PointIndex index : points) {
+        if (index < myFixedPoints.size()) {
+            myFixedPoints[index] = true;
+        }
+    }
+}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    Simplify alg;
+    initSimplify(alg, myKernel, myFixedPoints);
+
+    std::size_t numFacets = myKernel.CountFacets();
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0F - reduction));
+
+    // Simplification starts
+    alg.simplify_mesh(target_count, tolerance);
+
+    // Simplification done
+    adoptSimplify(alg, myKernel);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    Simplify alg;
+    initSimplify(alg, myKernel, myFixedPoints);
+
     // Simplification starts
     alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
 
     // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
-    }
+    adoptSimplify(alg, myKernel);
+}
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
-        }
+void MeshSimplify::simplifyParallel(int targetSize, float maxError, float featureAngle)
+{
+    if (targetSize < 0 || myKernel.CountFacets() <= std::size_t(targetSize)) {
+        return;
     }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
+
+    std::vector<bool> locked = myFixedPoints;
+    locked.resize(myKernel.CountPoints(), false);
+
+    MeshPointArray points = myKernel.GetPoints();
+    MeshFacetArray facets = myKernel.GetFacets();
+    double maxQuadric = std::min(double(maxError) * double(maxError),
+                                 double(std::numeric_limits<float>::max()));
+    double featureCos = std::cos(featureAngle);
+
+    // The second pass collapses the edges at the boundaries of the blocks of the first pass.
+    // The first pass leaves part of the reduction to it, so the seams are simplified, too.
+    for (bool shifted : {false, true}) {
+        std::vector<std::vector<FacetIndex>> blocks = makeBlocks(points, facets, shifted);
+        bool seamPass = !shifted && blocks.size() > 1;
+        simplifyBlocks(points,
+                       facets,
+                       locked,
+                       blocks,
+                       std::size_t(targetSize),
+                       maxQuadric,
+                       featureCos,
+                       seamPass);
+        if (!seamPass) {
+            break;
         }
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    myKernel.Adopt(points, facets, true);
 }
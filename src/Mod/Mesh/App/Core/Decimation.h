@@ -24,8 +24,11 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <vector>
 #include <Mod/Mesh/MeshGlobal.h>
 
+#include "Definitions.h"
+
 namespace MeshCore
 {
 class MeshKernel;
@@ -36,9 +39,21 @@ public:
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /// The given points keep their position and are not removed
+    void fixPoints(const std::vector<PointIndex>& points);
+    /** Simplifies the mesh on several threads. The mesh is split into blocks along its longest
+     * axis that are simplified independently, then the edges at the block boundaries are
+     * collapsed with blocks shifted by half their size.
+     * The simplification stops at about \a targetSize facets or when no edge can be collapsed
+     * without moving the surface by more than about \a maxError. Boundary edges and edges
+     * whose facets enclose an angle larger than \a featureAngle (in radians) get a large
+     * weight in the error quadrics, so their points only move along them.
+     */
+    void simplifyParallel(int targetSize, float maxError, float featureAngle);
 
 private:
     MeshKernel& myKernel;
+    std::vector<bool> myFixedPoints;
 };
 
 }  // namespace MeshCore
@@ -24,6 +24,11 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <set>
+#include <thread>
 #include <vector>
 #endif
 
@@ -597,81 +602,150 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
+bool shareCommonVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (PointIndex p1 : rface1._aulPoints) {
+        if (p1 == rface2._aulPoints[0] || p1 == rface2._aulPoints[1]
+            || p1 == rface2._aulPoints[2]) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
 
+void MeshEvalSelfIntersection::FindIntersections(
+    std::vector<std::pair<FacetIndex, FacetIndex>>& intersection,
+    bool firstOnly) const
+{
     // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
+    std::unique_ptr<MeshFacetGrid> ownGrid;
+    if (!_grid) {
+        ownGrid = std::make_unique<MeshFacetGrid>(_rclMesh);
+    }
+    const MeshFacetGrid& cMeshFacetGrid = _grid ? *_grid : *ownGrid;
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
     unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
     cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    const unsigned long ulCells = ulGridX * ulGridY * ulGridZ;
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+    // Contains bounding boxes for every facet
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(rFaces.size());
+    for (FacetIndex index = 0; index < rFaces.size(); index++) {
+        boxes.push_back(_rclMesh.GetFacet(index).GetBoundBox());
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
+    // Tests all pairs of facets of a grid cell
+    auto checkCell = [&](unsigned long ulCell,
+                         std::vector<std::pair<FacetIndex, FacetIndex>>& pairs) {
+        unsigned long ulX {}, ulY {}, ulZ {};
+        cMeshFacetGrid.GetPositionToIndex(ulCell, ulX, ulY, ulZ);
+        std::set<ElementIndex> elements;
+        cMeshFacetGrid.GetElements(ulX, ulY, ulZ, elements);
+        if (elements.size() < 2) {
+            return;
         }
 
+        std::vector<FacetIndex> aulGridElements(elements.begin(), elements.end());
         MeshGeomFacet facet1, facet2;
         Base::Vector3f pt1, pt2;
         for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
+            facet1 = _rclMesh.GetFacet(*it);
             const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
+            for (auto jt = it + 1; jt != aulGridElements.end(); ++jt) {
                 // If the facets share a common vertex we do not check for self-intersections
                 // because they could but usually do not intersect each other and the algorithm
                 // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+                if (shareCommonVertex(rface1, rFaces[*jt])) {
+                    continue;
                 }
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    facet2 = _rclMesh.GetFacet(*jt);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        pairs.emplace_back(*it, *jt);
+                        if (firstOnly) {
+                            return;
+                        }
                     }
                 }
             }
         }
+    };
+
+    // The cells are handled in batches by several threads. The intersections of each batch are
+    // kept apart so that they are reported in the order of the cells.
+    const unsigned long ulBatch = 64;
+    const unsigned long ulBatches = (ulCells + ulBatch - 1) / ulBatch;
+    std::vector<std::vector<std::pair<FacetIndex, FacetIndex>>> results(ulBatches);
+    std::atomic<unsigned long> nextBatch {0};
+    std::atomic<unsigned long> cellsDone {0};
+    std::atomic<bool> stop {false};
+
+    // Handles the next batch of cells and returns false if there is nothing left to do
+    auto processBatch = [&]() {
+        unsigned long batch = nextBatch++;
+        if (batch >= ulBatches || stop) {
+            return false;
+        }
+        unsigned long first = batch * ulBatch;
+        unsigned long last = std::min(ulCells, first + ulBatch);
+        for (unsigned long cell = first; cell < last && !stop; cell++) {
+            checkCell(cell, results[batch]);
+            if (firstOnly && !results[batch].empty()) {
+                stop = true;
+            }
+        }
+        cellsDone += last - first;
+        return true;
+    };
+
+    unsigned long threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max(1UL, ulBatches));
+    std::vector<std::future<void>> futures;
+    for (unsigned long i = 1; i < threads; i++) {
+        futures.push_back(std::async(std::launch::async, [&processBatch]() {
+            while (processBatch()) {}
+        }));
     }
 
-    return true;
+    // Calculates the intersections, the progress is reported by the calling thread only
+    Base::SequencerLauncher seq("Checking for self-intersections...", ulCells);
+    try {
+        unsigned long reported = 0;
+        while (processBatch()) {
+            for (unsigned long done = cellsDone; reported < done; reported++) {
+                seq.next(!firstOnly);
+            }
+        }
+    }
+    catch (...) {
+        stop = true;
+        for (auto& future : futures) {
+            future.wait();
+        }
+        throw;
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    for (const auto& pairs : results) {
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+    }
+}
+
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersection;
+    FindIntersections(intersection, true);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -702,77 +776,7 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+    FindIntersections(intersection, false);
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -32,6 +32,7 @@
 
 namespace MeshCore
 {
+class MeshFacetGrid;
 
 /**
  * The MeshEvaluation class checks the mesh kernel for correctness with respect to a
@@ -330,6 +331,11 @@ public:
     explicit MeshEvalSelfIntersection(const MeshKernel& rclB)
         : MeshEvaluation(rclB)
     {}
+    /// Uses the already built \a grid of the mesh \a rclB instead of creating a new one
+    MeshEvalSelfIntersection(const MeshKernel& rclB, const MeshFacetGrid& grid)
+        : MeshEvaluation(rclB)
+        , _grid(&grid)
+    {}
     /// Evaluate the mesh and return if true if there are self intersections
     bool Evaluate() override;
     /// collect all intersection lines
@@ -337,6 +343,17 @@ public:
                           std::vector<std::pair<Base::Vector3f, Base::Vector3f>>&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+
+private:
+    /** Tests the facets of each grid cell for intersections. The cells are distributed over
+     * several threads but the pairs are reported in the order of the cells. If \a firstOnly
+     * is true the search stops at the first intersection.
+     */
+    void FindIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>& intersection,
+                           bool firstOnly) const;
+
+private:
+    const MeshFacetGrid* _grid {nullptr};
 };
 
 /**
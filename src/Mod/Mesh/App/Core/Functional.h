@@ -24,7 +24,11 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
@@ -62,6 +66,34 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/** Calls \a func(begin, end) for consecutive blocks of \a blockSize indices of the range
+ * [0, count) on several threads. The blocks do not depend on the number of threads, so the
+ * results collected per block are reproducible.
+ */
+template<class Func>
+static void parallel_blocks(std::size_t count, std::size_t blockSize, Func func)
+{
+    std::size_t blocks = (count + blockSize - 1) / blockSize;
+    std::size_t threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = std::min(threads, blocks);
+
+    std::atomic<std::size_t> next {0};
+    auto work = [&]() {
+        for (std::size_t block = next++; block < blocks; block = next++) {
+            func(block * blockSize, std::min(count, (block + 1) * blockSize));
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (std::size_t i = 1; i < threads; i++) {
+        futures.push_back(std::async(std::launch::async, work));
+    }
+    work();
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
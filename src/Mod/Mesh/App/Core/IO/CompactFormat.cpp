@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#endif
+
+#include <Base/BoundBox.h>
+#include <Base/Exception.h>
+
+#include "Core/MeshKernel.h"
+
+#include "CompactFormat.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr std::size_t ChunkSize = 0x10000;
+constexpr uint32_t FlagNeighbours = 0x1;
+
+uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Collects the encoded bytes and passes them in chunks to the stream
+class ByteSink
+{
+public:
+    explicit ByteSink(std::ostream& str)
+        : _str(str)
+    {
+        _buffer.reserve(ChunkSize + 16);
+    }
+
+    void putUInt32(uint32_t value)
+    {
+        for (int i = 0; i < 4; i++) {
+            _buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+        check();
+    }
+    void putFloat(float value)
+    {
+        putUInt32(std::bit_cast<uint32_t>(value));
+    }
+    void putVarint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            _buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        _buffer.push_back(static_cast<char>(value));
+        check();
+    }
+    void putDelta(int64_t value, int64_t previous)
+    {
+        putVarint(zigzag(value - previous));
+    }
+    void flush()
+    {
+        _str.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+    }
+
+private:
+    void check()
+    {
+        if (_buffer.size() >= ChunkSize) {
+            flush();
+        }
+    }
+
+private:
+    std::ostream& _str;
+    std::string _buffer;
+};
+
+// Reads the stream in chunks so that the data is decoded while it arrives
+class ByteSource
+{
+public:
+    explicit ByteSource(std::istream& str)
+        : _str(str)
+        , _buffer(ChunkSize)
+    {}
+
+    uint32_t getUInt32()
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<uint32_t>(getByte()) << (8 * i);
+        }
+        return value;
+    }
+    float getFloat()
+    {
+        return std::bit_cast<float>(getUInt32());
+    }
+    uint64_t getVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = getByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw Base::BadFormatError("Invalid variable-length integer");
+    }
+    int64_t getDelta(int64_t previous)
+    {
+        return previous + unzigzag(getVarint());
+    }
+
+private:
+    uint8_t getByte()
+    {
+        if (_pos == _end) {
+            _str.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _end = static_cast<std::size_t>(_str.gcount());
+            _pos = 0;
+            if (_end == 0) {
+                throw Base::BadFormatError("Unexpected end of mesh data");
+            }
+        }
+        return static_cast<uint8_t>(_buffer[_pos++]);
+    }
+
+private:
+    std::istream& _str;
+    std::vector<char> _buffer;
+    std::size_t _pos = 0;
+    std::size_t _end = 0;
+};
+
+// The grid of the quantized coordinates
+struct Quantization
+{
+    std::array<double, 3> origin {};
+    std::array<double, 3> step {};
+    uint32_t maximum = 0;
+
+    Quantization(const Base::BoundBox3f& box, int bits)
+    {
+        maximum = static_cast<uint32_t>((uint64_t(1) << bits) - 1);
+        origin = {box.MinX, box.MinY, box.MinZ};
+        std::array<double, 3> extent {double(box.MaxX) - box.MinX,
+                                      double(box.MaxY) - box.MinY,
+                                      double(box.MaxZ) - box.MinZ};
+        for (int i = 0; i < 3; i++) {
+            step[i] = extent[i] > 0.0 ? extent[i] / maximum : 0.0;
+        }
+    }
+    uint32_t encode(float value, int axis) const
+    {
+        if (step[axis] == 0.0) {
+            return 0;
+        }
+        double grid = std::round((value - origin[axis]) / step[axis]);
+        return static_cast<uint32_t>(std::clamp(grid, 0.0, static_cast<double>(maximum)));
+    }
+    float decode(int64_t value, int axis) const
+    {
+        return static_cast<float>(origin[axis] + static_cast<double>(value) * step[axis]);
+    }
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+WriterCompact::WriterCompact(const MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void WriterCompact::SetQuantization(int bits)
+{
+    _bits = std::clamp(bits, 0, MaxQuantizationBits);
+}
+
+void WriterCompact::SetStoreNeighbours(bool on)
+{
+    _neighbours = on;
+}
+
+bool WriterCompact::Save(std::ostream& str) const
+{
+    if (!str || str.bad()) {
+        return false;
+    }
+
+    const MeshPointArray& points = _kernel.GetPoints();
+    const MeshFacetArray& facets = _kernel.GetFacets();
+
+    // the bounding box of the kernel is not necessarily tight
+    Base::BoundBox3f box;
+    for (const auto& it : points) {
+        box.Add(it);
+    }
+
+    ByteSink sink(str);
+    sink.putUInt32(Magic);
+    sink.putUInt32(Version);
+    sink.putUInt32(_neighbours ? FlagNeighbours : 0);
+    sink.putUInt32(static_cast<uint32_t>(points.size()));
+    sink.putUInt32(static_cast<uint32_t>(facets.size()));
+    sink.putUInt32(static_cast<uint32_t>(_bits));
+    sink.putFloat(box.MinX);
+    sink.putFloat(box.MinY);
+    sink.putFloat(box.MinZ);
+    sink.putFloat(box.MaxX);
+    sink.putFloat(box.MaxY);
+    sink.putFloat(box.MaxZ);
+
+    std::array<int64_t, 3> prev {};
+    if (_bits > 0) {
+        Quantization grid(box, _bits);
+        for (const auto& it : points) {
+            for (int i = 0; i < 3; i++) {
+                int64_t value = grid.encode(it[i], i);
+                sink.putDelta(value, prev[i]);
+                prev[i] = value;
+            }
+        }
+    }
+    else {
+        for (const auto& it : points) {
+            for (int i = 0; i < 3; i++) {
+                int64_t value = std::bit_cast<uint32_t>(it[i]);
+                sink.putDelta(value, prev[i]);
+                prev[i] = value;
+            }
+        }
+    }
+
+    int64_t first = 0;
+    for (const auto& it : facets) {
+        int64_t corner = it._aulPoints[0];
+        sink.putDelta(corner, first);
+        sink.putDelta(it._aulPoints[1], corner);
+        sink.putDelta(it._aulPoints[2], corner);
+        first = corner;
+    }
+
+    if (_neighbours) {
+        int64_t index = 0;
+        for (const auto& it : facets) {
+            for (FacetIndex neighbour : it._aulNeighbours) {
+                if (neighbour == FACET_INDEX_MAX) {
+                    sink.putVarint(0);
+                }
+                else {
+                    sink.putVarint(zigzag(static_cast<int64_t>(neighbour) - index) + 1);
+                }
+            }
+            index++;
+        }
+    }
+
+    sink.flush();
+    return str.good();
+}
+
+// ----------------------------------------------------------------------------
+
+ReaderCompact::ReaderCompact(MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void ReaderCompact::Load(std::istream& str)
+{
+    ByteSource source(str);
+    uint32_t flags = source.getUInt32();
+    uint32_t countPoints = source.getUInt32();
+    uint32_t countFacets = source.getUInt32();
+    uint32_t bits = source.getUInt32();
+
+    // same limits as for the legacy format so that we don't over-allocate
+    if (countPoints > 1e9 || countFacets > 1e9) {
+        throw Base::BadFormatError("Mesh seems to have over a billion points or facets");
+    }
+    if (bits > WriterCompact::MaxQuantizationBits) {
+        throw Base::BadFormatError("Invalid quantization of mesh data");
+    }
+
+    Base::BoundBox3f box;
+    box.MinX = source.getFloat();
+    box.MinY = source.getFloat();
+    box.MinZ = source.getFloat();
+    box.MaxX = source.getFloat();
+    box.MaxY = source.getFloat();
+    box.MaxZ = source.getFloat();
+
+    MeshPointArray points(countPoints);
+    std::array<int64_t, 3> prev {};
+    if (bits > 0) {
+        Quantization grid(box, static_cast<int>(bits));
+        for (auto& it : points) {
+            for (int i = 0; i < 3; i++) {
+                prev[i] = source.getDelta(prev[i]);
+                if (prev[i] < 0 || prev[i] > grid.maximum) {
+                    throw Base::BadFormatError("Invalid data structure");
+                }
+                it[i] = grid.decode(prev[i], i);
+            }
+        }
+    }
+    else {
+        for (auto& it : points) {
+            for (int i = 0; i < 3; i++) {
+                prev[i] = source.getDelta(prev[i]);
+                it[i] = std::bit_cast<float>(static_cast<uint32_t>(prev[i]));
+            }
+        }
+    }
+
+    MeshFacetArray facets(countFacets);
+    int64_t first = 0;
+    for (auto& it : facets) {
+        int64_t corner = source.getDelta(first);
+        std::array<int64_t, 3> corners {corner, source.getDelta(corner), source.getDelta(corner)};
+        for (int i = 0; i < 3; i++) {
+            if (corners[i] < 0 || corners[i] >= countPoints) {
+                throw Base::BadFormatError("Invalid data structure");
+            }
+            it._aulPoints[i] = static_cast<PointIndex>(corners[i]);
+        }
+        first = corner;
+    }
+
+    bool neighbours = (flags & FlagNeighbours) != 0;
+    if (neighbours) {
+        int64_t index = 0;
+        for (auto& it : facets) {
+            for (FacetIndex& neighbour : it._aulNeighbours) {
+                uint64_t value = source.getVarint();
+                if (value == 0) {
+                    neighbour = FACET_INDEX_MAX;
+                    continue;
+                }
+                int64_t facet = index + unzigzag(value - 1);
+                if (facet < 0 || facet >= countFacets) {
+                    throw Base::BadFormatError("Invalid data structure");
+                }
+                neighbour = static_cast<FacetIndex>(facet);
+            }
+            index++;
+        }
+    }
+
+    _kernel.Adopt(points, facets, !neighbours);
+}
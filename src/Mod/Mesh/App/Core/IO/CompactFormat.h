@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef MESH_IO_COMPACT_FORMAT_H
+#define MESH_IO_COMPACT_FORMAT_H
+
+#include <cstdint>
+#include <iosfwd>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The compact binary format is used to store meshes inside of documents. It starts with
+ * the same magic number as the format of MeshKernel::Write() but with version 2:
+ *
+ * \code
+ * uint32  magic, version, flags, number of points, number of facets, quantization bits
+ * float   minimum and maximum of the bounding box
+ * points  per coordinate the difference to the previous point
+ * facets  the first corner relative to the first corner of the previous facet,
+ *         the other corners relative to the first corner
+ * [neighbours] relative to the facet index, 0 marks an open edge
+ * \endcode
+ *
+ * The differences are zigzag encoded as variable-length integers, so that meshes with
+ * a good locality of their points and facets, e.g. scans, need few bytes per element and
+ * the zip compression of the document is much more effective. Without quantization the
+ * differences of the IEEE bit patterns of the coordinates are stored and the points are
+ * restored exactly, otherwise the coordinates are rounded to a grid of 2^bits - 1 steps
+ * inside the bounding box. If the neighbourhood isn't stored it's rebuilt on reading.
+ */
+class MeshExport WriterCompact
+{
+public:
+    static constexpr uint32_t Magic = 0xA0B0C0D0;
+    static constexpr uint32_t Version = 0x020000;
+    static constexpr int MaxQuantizationBits = 24;
+
+    explicit WriterCompact(const MeshKernel& kernel);
+    /*!
+     * \brief SetQuantization
+     * Sets the number of bits per coordinate of the grid the points are rounded to.
+     * 0 stores the points exactly, higher values are clamped to \ref MaxQuantizationBits.
+     */
+    void SetQuantization(int bits);
+    /*!
+     * \brief SetStoreNeighbours
+     * Stores the neighbourhood of the facets, which is the default. Otherwise it's rebuilt
+     * on reading, this makes the data about a third smaller but reading several times slower.
+     */
+    void SetStoreNeighbours(bool on);
+    /*!
+     * \brief Save the mesh to the output stream.
+     * \return true on success and false otherwise
+     */
+    bool Save(std::ostream& str) const;
+
+private:
+    const MeshKernel& _kernel;
+    int _bits = 0;
+    bool _neighbours = true;
+};
+
+/** Loads a mesh saved with WriterCompact. */
+class MeshExport ReaderCompact
+{
+public:
+    explicit ReaderCompact(MeshKernel& kernel);
+    /*!
+     * \brief Load the mesh from the input stream.
+     * The stream must be positioned after the magic number and the version. The data
+     * is read in chunks and decoded while reading, so the stream may be consumed beyond
+     * the end of the mesh. A Base::BadFormatError is thrown for truncated or inconsistent
+     * data.
+     */
+    void Load(std::istream& str);
+
+private:
+    MeshKernel& _kernel;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_COMPACT_FORMAT_H
@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
@@ -54,6 +55,7 @@
 #include <Base/Writer.h>
 #include <zipios++/gzipoutputstream.h>
 #include <zipios++/zipoutputstream.h>
+#include <QFile>
 
 #include "Builder.h"
 #include "Definitions.h"
@@ -241,7 +243,7 @@ bool MeshInput::LoadAny(const char* FileName)
     // read file
     bool ok = false;
     if (fi.hasExtension({"stl", "ast"})) {
-        ok = LoadSTL(str);
+        ok = LoadMappedBinarySTL(FileName) || LoadSTL(str);
     }
     else if (fi.hasExtension("iv")) {
         ok = LoadInventor(str);
@@ -312,6 +314,17 @@ bool MeshInput::LoadFormat(std::istream& input, MeshIO::Format fmt)
     }
 }
 
+namespace
+{
+/// Checks the bytes following the facet count of an STL file for keywords of the ASCII format
+bool hasAsciiSTLKeywords(char* szBuf)
+{
+    boost::algorithm::to_upper(szBuf);
+    return strstr(szBuf, "SOLID") || strstr(szBuf, "FACET") || strstr(szBuf, "NORMAL")
+        || strstr(szBuf, "VERTEX") || strstr(szBuf, "ENDFACET") || strstr(szBuf, "ENDLOOP");
+}
+}  // namespace
+
 /** Loads an STL file either in binary or ASCII format.
  * Therefore the file header gets checked to decide if the file is binary or not.
  */
@@ -345,12 +358,9 @@ bool MeshInput::LoadSTL(std::istream& input)
         return (ulCt == 0);
     }
     szBuf[ulBytes] = 0;
-    boost::algorithm::to_upper(szBuf);
 
     try {
-        if (!strstr(szBuf, "SOLID") && !strstr(szBuf, "FACET") && !strstr(szBuf, "NORMAL")
-            && !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET")
-            && !strstr(szBuf, "ENDLOOP")) {
+        if (!hasAsciiSTLKeywords(szBuf)) {
             // probably binary STL
             buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(input);
@@ -858,6 +868,58 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     return true;
 }
 
+/** Loads a binary STL file by mapping it into memory. */
+bool MeshInput::LoadMappedBinarySTL(const char* FileName)
+{
+    constexpr qint64 headerSize = 80 + sizeof(uint32_t);
+    constexpr qint64 facetSize = 50;
+
+    QFile file(QString::fromUtf8(FileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // empty files and the check for a single facet are left to LoadSTL()
+    qint64 size = file.size();
+    if (size < headerSize + 2 * facetSize) {
+        return false;
+    }
+    const char* data = reinterpret_cast<const char*>(file.map(0, size));  // NOLINT
+    if (!data) {
+        return false;
+    }
+
+    uint32_t ulCt {};
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+    if (ulCt < 2 || ulCt > (size - headerSize) / facetSize) {
+        return false;
+    }
+
+    // same check as in LoadSTL()
+    char szBuf[2 * facetSize + 1];
+    std::memcpy(szBuf, data + headerSize, 2 * facetSize);
+    szBuf[2 * facetSize] = 0;
+    if (hasAsciiSTLKeywords(szBuf)) {
+        return false;
+    }
+
+    try {
+        MeshFastBuilder builder(this->_rclMesh);
+        builder.Initialize(static_cast<MeshFastBuilder::size_type>(ulCt));
+        // the points of a facet follow its normal
+        builder.AddFacets(data + headerSize + 3 * sizeof(float),
+                          static_cast<MeshFastBuilder::size_type>(ulCt),
+                          facetSize);
+        builder.Finish();
+    }
+    catch (...) {
+        _rclMesh.Clear();
+        throw;
+    }
+
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML(Base::XMLReader& reader)
 {
@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 #include <map>
@@ -38,6 +39,8 @@
 #include "Algorithm.h"
 #include "Builder.h"
 #include "Evaluation.h"
+#include "Functional.h"
+#include "IO/CompactFormat.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -46,6 +49,93 @@
 
 using namespace MeshCore;
 
+namespace
+{
+/// Number of points or facets handled by one task of the bulk operations
+constexpr std::size_t TaskSize = 0x4000;
+/// Number of facets copied at once into a FacetBatch
+constexpr std::size_t BatchSize = 256;
+
+/** The corner points of a batch of facets stored coordinate by coordinate. The loops over
+ * a batch have no dependencies between the facets and can be vectorized by the compiler.
+ */
+struct FacetBatch
+{
+    std::size_t size {0};
+    std::array<std::array<float, BatchSize>, 3> x;
+    std::array<std::array<float, BatchSize>, 3> y;
+    std::array<std::array<float, BatchSize>, 3> z;
+    std::array<float, BatchSize> result;
+
+    void load(const MeshPointArray& points,
+              const MeshFacetArray& facets,
+              std::size_t begin,
+              std::size_t end)
+    {
+        size = end - begin;
+        for (std::size_t i = 0; i < size; i++) {
+            const MeshFacet& facet = facets[begin + i];
+            for (int j = 0; j < 3; j++) {
+                const MeshPoint& point = points[facet._aulPoints[j]];
+                x[j][i] = point.x;
+                y[j][i] = point.y;
+                z[j][i] = point.z;
+            }
+        }
+    }
+
+    /// Computes the cross product of the edges from the first corner of each facet
+    template<class Func>
+    void cross(Func func) const
+    {
+        for (std::size_t i = 0; i < size; i++) {
+            float ux = x[1][i] - x[0][i];
+            float uy = y[1][i] - y[0][i];
+            float uz = z[1][i] - z[0][i];
+            float vx = x[2][i] - x[0][i];
+            float vy = y[2][i] - y[0][i];
+            float vz = z[2][i] - z[0][i];
+            func(i, uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx);
+        }
+    }
+
+    /// Returns the sum of the values in result
+    double sum() const
+    {
+        double value = 0.0;
+        for (std::size_t i = 0; i < size; i++) {
+            value += result[i];
+        }
+        return value;
+    }
+};
+
+/// Calls \a func(batch, first) for the facets [begin, end)
+template<class Func>
+void forEachFacetBatch(const MeshPointArray& points,
+                       const MeshFacetArray& facets,
+                       std::size_t begin,
+                       std::size_t end,
+                       Func func)
+{
+    FacetBatch batch;
+    for (std::size_t first = begin; first < end; first += BatchSize) {
+        batch.load(points, facets, first, std::min(end, first + BatchSize));
+        func(batch, first);
+    }
+}
+
+/// Sums up the values computed per task in a fixed order
+double sumTasks(const std::vector<double>& values)
+{
+    double value = 0.0;
+    for (double it : values) {
+        value += it;
+    }
+    return value;
+}
+}  // namespace
+
 MeshKernel::MeshKernel()
 {
     _clBoundBox.SetVoid();
@@ -63,6 +153,7 @@ MeshKernel::MeshKernel(MeshKernel&& rclMesh)
 
 MeshKernel& MeshKernel::operator=(const MeshKernel& rclMesh)
 {
+    _ulStamp++;
     if (this != &rclMesh) {  // must be a different instance
         this->_aclPointArray = rclMesh._aclPointArray;
         this->_aclFacetArray = rclMesh._aclFacetArray;
@@ -74,6 +165,7 @@ MeshKernel& MeshKernel::operator=(const MeshKernel& rclMesh)
 
 MeshKernel& MeshKernel::operator=(MeshKernel&& rclMesh)
 {
+    _ulStamp++;
     if (this != &rclMesh) {  // must be a different instance
         this->_aclPointArray = std::move(rclMesh._aclPointArray);
         this->_aclFacetArray = std::move(rclMesh._aclFacetArray);
@@ -85,6 +177,7 @@ MeshKernel& MeshKernel::operator=(MeshKernel&& rclMesh)
 
 MeshKernel& MeshKernel::operator=(const std::vector<MeshGeomFacet>& rclFAry)
 {
+    _ulStamp++;
     MeshBuilder builder(*this);
     builder.Initialize(rclFAry.size());
 
@@ -101,6 +194,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints,
                         const MeshFacetArray& rFacets,
                         bool checkNeighbourHood)
 {
+    _ulStamp++;
     _aclPointArray = rPoints;
     _aclFacetArray = rFacets;
     RecalcBoundBox();
@@ -111,6 +205,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints,
 
 void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    _ulStamp++;
     _aclPointArray.swap(rPoints);
     _aclFacetArray.swap(rFacets);
     RecalcBoundBox();
@@ -121,6 +216,8 @@ void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool ch
 
 void MeshKernel::Swap(MeshKernel& mesh)
 {
+    _ulStamp++;
+    mesh._ulStamp++;
     this->_aclPointArray.swap(mesh._aclPointArray);
     this->_aclFacetArray.swap(mesh._aclFacetArray);
     this->_clBoundBox = mesh._clBoundBox;
@@ -134,6 +231,7 @@ MeshKernel& MeshKernel::operator+=(const MeshGeomFacet& rclSFacet)
 
 void MeshKernel::AddFacet(const MeshGeomFacet& rclSFacet)
 {
+    _ulStamp++;
     MeshFacet clFacet;
 
     // set corner points
@@ -183,6 +281,7 @@ MeshKernel& MeshKernel::operator+=(const std::vector<MeshGeomFacet>& rclFAry)
 
 void MeshKernel::AddFacets(const std::vector<MeshGeomFacet>& rclFAry)
 {
+    _ulStamp++;
     // Create a temp. kernel to get the topology of the passed triangles
     // and merge them with this kernel. This keeps properties and flags
     // of this mesh.
@@ -193,6 +292,7 @@ void MeshKernel::AddFacets(const std::vector<MeshGeomFacet>& rclFAry)
 
 unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry, bool checkManifolds)
 {
+    _ulStamp++;
     // Build map of edges of the referencing facets we want to append
 #ifdef FC_DEBUG
     [[maybe_unused]] unsigned long countPoints = CountPoints();
@@ -362,6 +462,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry,
                                     const std::vector<Base::Vector3f>& rclPAry,
                                     bool checkManifolds)
 {
+    _ulStamp++;
     for (auto it : rclPAry) {
         _clBoundBox.Add(it);
     }
@@ -371,6 +472,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry,
 
 void MeshKernel::Merge(const MeshKernel& rKernel)
 {
+    _ulStamp++;
     if (this != &rKernel) {
         const MeshPointArray& rPoints = rKernel._aclPointArray;
         const MeshFacetArray& rFacets = rKernel._aclFacetArray;
@@ -380,6 +482,7 @@ void MeshKernel::Merge(const MeshKernel& rKernel)
 
 void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFaces)
 {
+    _ulStamp++;
     if (rPoints.empty() || rFaces.empty()) {
         return;  // nothing to do
     }
@@ -442,6 +545,7 @@ void MeshKernel::Cleanup()
 
 void MeshKernel::Clear()
 {
+    _ulStamp++;
     _aclPointArray.clear();
     _aclFacetArray.clear();
 
@@ -454,6 +558,7 @@ void MeshKernel::Clear()
 
 bool MeshKernel::DeleteFacet(const MeshFacetIterator& rclIter)
 {
+    _ulStamp++;
     FacetIndex ulNFacet {}, ulInd {};
 
     if (rclIter._clIter >= _aclFacetArray.end()) {
@@ -505,6 +610,7 @@ bool MeshKernel::DeleteFacet(FacetIndex ulInd)
 
 void MeshKernel::DeleteFacets(const std::vector<FacetIndex>& raulFacets)
 {
+    _ulStamp++;
     _aclPointArray.SetProperty(0);
 
     // number of referencing facets per point
@@ -550,6 +656,7 @@ bool MeshKernel::DeletePoint(PointIndex ulInd)
 
 bool MeshKernel::DeletePoint(const MeshPointIterator& rclIter)
 {
+    _ulStamp++;
     MeshFacetIterator pFIter(*this), pFEnd(*this);
     std::vector<MeshFacetIterator> clToDel;
     PointIndex ulInd {};
@@ -583,6 +690,7 @@ bool MeshKernel::DeletePoint(const MeshPointIterator& rclIter)
 
 void MeshKernel::DeletePoints(const std::vector<PointIndex>& raulPoints)
 {
+    _ulStamp++;
     _aclPointArray.ResetInvalid();
     for (PointIndex ptIndex : raulPoints) {
         _aclPointArray[ptIndex].SetInvalid();
@@ -619,6 +727,7 @@ void MeshKernel::DeletePoints(const std::vector<PointIndex>& raulPoints)
 
 void MeshKernel::ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bOnlySetInvalid)
 {
+    _ulStamp++;
     std::vector<MeshFacet>::iterator pFIter, pFEnd, pFNot;
 
     pFIter = _aclFacetArray.begin();
@@ -668,6 +777,7 @@ void MeshKernel::ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bO
 
 void MeshKernel::RemoveInvalids()
 {
+    _ulStamp++;
     std::vector<unsigned long> aulDecrements;
     std::vector<unsigned long>::iterator pDIter;
     unsigned long ulDec {};
@@ -772,6 +882,7 @@ void MeshKernel::CutFacets(const MeshFacetGrid& rclGrid,
                            bool bCutInner,
                            std::vector<MeshGeomFacet>& raclFacets)
 {
+    _ulStamp++;
     std::vector<FacetIndex> aulFacets;
 
     MeshAlgorithm(*this).CheckFacets(rclGrid, pclProj, rclPoly, bCutInner, aulFacets);
@@ -789,6 +900,7 @@ void MeshKernel::CutFacets(const MeshFacetGrid& grid,
                            bool bInner,
                            std::vector<FacetIndex>& cut)
 {
+    _ulStamp++;
     MeshAlgorithm(*this).CheckFacets(grid, proj, poly, bInner, cut);
     DeleteFacets(cut);
 }
@@ -918,6 +1030,7 @@ void MeshKernel::Write(std::ostream& rclOut) const
 
 void MeshKernel::Read(std::istream& rclIn)
 {
+    _ulStamp++;
     if (!rclIn || rclIn.bad()) {
         return;
     }
@@ -934,6 +1047,13 @@ void MeshKernel::Read(std::istream& rclIn)
     Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff;  // value to mark an open edge
 
+    // the compact format of documents is always little endian
+    if (magic == WriterCompact::Magic && version == WriterCompact::Version) {
+        ReaderCompact reader(*this);
+        reader.Load(rclIn);
+        return;
+    }
+
     // is it the new or old format?
     bool new_format = false;
     if (magic == 0xA0B0C0D0 && version == 0x010000) {
@@ -1112,48 +1232,89 @@ void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
 
 void MeshKernel::Transform(const Base::Matrix4D& rclMat)
 {
-    auto clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
+    _ulStamp++;
+    std::vector<Base::BoundBox3f> boxes((_aclPointArray.size() + TaskSize - 1) / TaskSize);
+    parallel_blocks(_aclPointArray.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        Base::BoundBox3f& box = boxes[begin / TaskSize];
+        for (std::size_t i = begin; i < end; i++) {
+            _aclPointArray[i] *= rclMat;
+            box.Add(_aclPointArray[i]);
+        }
+    });
 
     _clBoundBox.SetVoid();
-    while (clPIter < clPEIter) {
-        *clPIter *= rclMat;
-        _clBoundBox.Add(*clPIter);
-        clPIter++;
+    for (const auto& box : boxes) {
+        _clBoundBox.Add(box);
     }
 }
 
 void MeshKernel::Smooth(int iterations, float stepsize)
 {
+    _ulStamp++;
     (void)stepsize;
     LaplaceSmoothing(*this).Smooth(iterations);
 }
 
 void MeshKernel::RecalcBoundBox() const
 {
+    std::vector<Base::BoundBox3f> boxes((_aclPointArray.size() + TaskSize - 1) / TaskSize);
+    parallel_blocks(_aclPointArray.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        Base::BoundBox3f& box = boxes[begin / TaskSize];
+        for (std::size_t i = begin; i < end; i++) {
+            box.Add(_aclPointArray[i]);
+        }
+    });
+
     _clBoundBox.SetVoid();
-    for (const auto& pI : _aclPointArray) {
-        _clBoundBox.Add(pI);
+    for (const auto& box : boxes) {
+        _clBoundBox.Add(box);
     }
 }
 
 std::vector<Base::Vector3f> MeshKernel::CalcVertexNormals() const
 {
+    // the facet normals are computed in parallel, the normal of a point then adds the normals
+    // of its facets in ascending order so the result doesn't depend on the number of threads
+    std::vector<Base::Vector3f> facetNormals(CountFacets());
+    parallel_blocks(facetNormals.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        forEachFacetBatch(_aclPointArray,
+                          _aclFacetArray,
+                          begin,
+                          end,
+                          [&facetNormals](const FacetBatch& batch, std::size_t first) {
+                              Base::Vector3f* normal = &facetNormals[first];
+                              batch.cross([normal](std::size_t i, float x, float y, float z) {
+                                  normal[i].Set(x, y, z);
+                              });
+                          });
+    });
+
+    MeshAdjacency pointToFacets(*this, MeshAdjacency::PointToFacets);
     std::vector<Base::Vector3f> normals;
-
     normals.resize(CountPoints());
+    parallel_blocks(normals.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (FacetIndex index : pointToFacets[i]) {
+                normals[i] += facetNormals[index];
+            }
+        }
+    });
 
-    PointIndex p1 {}, p2 {}, p3 {};
-    unsigned int ct = CountFacets();
-    for (unsigned int pFIter = 0; pFIter < ct; pFIter++) {
-        GetFacetPoints(pFIter, p1, p2, p3);
-        Base::Vector3f Norm = (GetPoint(p2) - GetPoint(p1)) % (GetPoint(p3) - GetPoint(p1));
+    return normals;
+}
 
-        normals[p1] += Norm;
-        normals[p2] += Norm;
-        normals[p3] += Norm;
+Base::Vector3f MeshKernel::CalcVertexNormal(PointIndex index) const
+{
+    // adds the normals of the facets of the point in ascending order like CalcVertexNormals()
+    Base::Vector3f normal;
+    for (const auto& facet : _aclFacetArray) {
+        const PointIndex* corners = facet._aulPoints;
+        if (corners[0] == index || corners[1] == index || corners[2] == index) {
+            const MeshPoint& p0 = _aclPointArray[corners[0]];
+            normal += (_aclPointArray[corners[1]] - p0) % (_aclPointArray[corners[2]] - p0);
+        }
     }
-
-    return normals;
+    return normal;
 }
 
 std::vector<Base::Vector3f> MeshKernel::GetFacetNormals(const std::vector<FacetIndex>& facets) const
@@ -1179,13 +1340,23 @@ std::vector<Base::Vector3f> MeshKernel::GetFacetNormals(const std::vector<FacetI
 // Evaluation
 float MeshKernel::GetSurface() const
 {
-    float fSurface = 0.0;
-    MeshFacetIterator cIter(*this);
-    for (cIter.Init(); cIter.More(); cIter.Next()) {
-        fSurface += cIter->Area();
-    }
-
-    return fSurface;
+    std::vector<double> areas((_aclFacetArray.size() + TaskSize - 1) / TaskSize);
+    parallel_blocks(_aclFacetArray.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        double& area = areas[begin / TaskSize];
+        forEachFacetBatch(_aclPointArray,
+                          _aclFacetArray,
+                          begin,
+                          end,
+                          [&area](FacetBatch& batch, std::size_t) {
+                              auto& result = batch.result;
+                              batch.cross([&result](std::size_t i, float x, float y, float z) {
+                                  result[i] = std::sqrt(x * x + y * y + z * z) / 2.0F;
+                              });
+                              area += batch.sum();
+                          });
+    });
+
+    return static_cast<float>(sumTasks(areas));
 }
 
 float MeshKernel::GetSurface(const std::vector<FacetIndex>& aSegment) const
@@ -1207,23 +1378,29 @@ float MeshKernel::GetVolume() const
     // if ( !cSolid.Evaluate() )
     //     return 0.0f; // no solid
 
-    float fVolume = 0.0;
-    MeshFacetIterator cIter(*this);
-    Base::Vector3f p1, p2, p3;
-    for (cIter.Init(); cIter.More(); cIter.Next()) {
-        const MeshGeomFacet& rclF = *cIter;
-        p1 = rclF._aclPoints[0];
-        p2 = rclF._aclPoints[1];
-        p3 = rclF._aclPoints[2];
-
-        fVolume += (-p3.x * p2.y * p1.z + p2.x * p3.y * p1.z + p3.x * p1.y * p2.z
-                    - p1.x * p3.y * p2.z - p2.x * p1.y * p3.z + p1.x * p2.y * p3.z);
-    }
-
-    fVolume /= 6.0F;
-    fVolume = std::fabs(fVolume);
-
-    return fVolume;
+    std::vector<double> volumes((_aclFacetArray.size() + TaskSize - 1) / TaskSize);
+    parallel_blocks(_aclFacetArray.size(), TaskSize, [&](std::size_t begin, std::size_t end) {
+        double& volume = volumes[begin / TaskSize];
+        forEachFacetBatch(_aclPointArray,
+                          _aclFacetArray,
+                          begin,
+                          end,
+                          [&volume](FacetBatch& batch, std::size_t) {
+                              const auto& x = batch.x;
+                              const auto& y = batch.y;
+                              const auto& z = batch.z;
+                              for (std::size_t i = 0; i < batch.size; i++) {
+                                  batch.result[i] = -x[2][i] * y[1][i] * z[0][i]
+                                      + x[1][i] * y[2][i] * z[0][i] + x[2][i] * y[0][i] * z[1][i]
+                                      - x[0][i] * y[2][i] * z[1][i] - x[1][i] * y[0][i] * z[2][i]
+                                      + x[0][i] * y[1][i] * z[2][i];
+                              }
+                              volume += batch.sum();
+                          });
+    });
+
+    double fVolume = sumTasks(volumes) / 6.0;
+    return static_cast<float>(std::fabs(fVolume));
 }
 
 bool MeshKernel::HasOpenEdges() const
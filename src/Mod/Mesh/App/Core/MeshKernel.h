@@ -79,6 +79,7 @@ public:
     //@{
     /// Binary streaming of data
     void Write(std::ostream& rclOut) const;
+    /// Reads the data of Write() or the compact format of WriterCompact
     void Read(std::istream& rclIn);
     //@}
 
@@ -112,6 +113,13 @@ public:
      * the removal of points.or after a transformation of the data structure.
      */
     void RecalcBoundBox() const;
+    /** Returns a number that changes with each modification of the points or facets. It can
+     * be used to check whether data derived from the mesh, like a grid, is still valid.
+     */
+    unsigned long GetModificationStamp() const
+    {
+        return _ulStamp;
+    }
 
     /** Returns the point at the given index. This method is rather slow and should be
      * called occasionally only. For fast access the MeshPointIterator interfsce should
@@ -123,6 +131,10 @@ public:
      * by summarizing the normals of the associated facets.
      */
     std::vector<Base::Vector3f> CalcVertexNormals() const;
+    /** Returns the vertex normal of the point with index \a index like CalcVertexNormals().
+     * No normals of other points are computed, so this is much cheaper for a single point.
+     */
+    Base::Vector3f CalcVertexNormal(PointIndex index) const;
     std::vector<Base::Vector3f> GetFacetNormals(const std::vector<FacetIndex>&) const;
 
     /** Returns the facet at the given index. This method is rather slow and should be
@@ -174,6 +186,7 @@ public:
     /** Returns a modifier for the point array */
     MeshPointModifier ModifyPoints()
     {
+        _ulStamp++;
         return MeshPointModifier(_aclPointArray);
     }
 
@@ -190,6 +203,7 @@ public:
     /** Returns a modifier for the facet array */
     MeshFacetModifier ModifyFacets()
     {
+        _ulStamp++;
         return MeshFacetModifier(_aclFacetArray);
     }
 
@@ -486,6 +500,7 @@ private:
     MeshFacetArray _aclFacetArray;        /**< Holds the array of facets. */
     mutable Base::BoundBox3f _clBoundBox; /**< The current calculated bounding box. */
     bool _bValid {true};                  /**< Current state of validality. */
+    unsigned long _ulStamp {0};           /**< Changes with each modification. */
 
     // friends
     friend class MeshPointIterator;
@@ -550,16 +565,19 @@ inline void MeshKernel::GetFacetNeighbours(FacetIndex ulIndex,
 
 inline void MeshKernel::MovePoint(PointIndex ulPtIndex, const Base::Vector3f& rclTrans)
 {
+    _ulStamp++;
     _aclPointArray[ulPtIndex] += rclTrans;
 }
 
 inline void MeshKernel::SetPoint(PointIndex ulPtIndex, const Base::Vector3f& rPoint)
 {
+    _ulStamp++;
     _aclPointArray[ulPtIndex] = rPoint;
 }
 
 inline void MeshKernel::SetPoint(PointIndex ulPtIndex, float x, float y, float z)
 {
+    _ulStamp++;
     _aclPointArray[ulPtIndex].Set(x, y, z);
 }
 
@@ -610,6 +628,7 @@ inline void MeshKernel::SetFacetPoints(FacetIndex ulFaIndex,
                                        PointIndex rclP2)
 {
     assert(ulFaIndex < _aclFacetArray.size());
+    _ulStamp++;
     MeshFacet& rclFacet = _aclFacetArray[ulFaIndex];
     rclFacet._aulPoints[0] = rclP0;
     rclFacet._aulPoints[1] = rclP1;
@@ -0,0 +1,669 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#endif
+
+#include <Base/BoundBox.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Sequencer.h>
+#include <Base/Stream.h>
+
+#include "Builder.h"
+#include "Curvature.h"
+#include "Decimation.h"
+#include "MeshKernel.h"
+#include "OutOfCore.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+/// Size of a facet record in the binary STL format
+constexpr std::size_t StlFacetSize = 50;
+/// Size of a facet record in the chunk files, i.e. the coordinates of its three points
+constexpr std::size_t ChunkFacetSize = 9 * sizeof(float);
+/// Number of facets read at once from the input file
+constexpr std::size_t ReadBlock = 0x10000;
+/// Number of bins of the histogram used to place the boundaries of the chunks
+constexpr std::size_t HistogramBins = 0x10000;
+
+/// Reads the facets of a binary STL file block by block
+class StlFacetReader
+{
+public:
+    explicit StlFacetReader(const Base::FileInfo& fi)
+        : input(fi, std::ios::in | std::ios::binary)
+    {
+        char header[80];
+        uint32_t count {};
+        if (!input.read(header, sizeof(header))
+            || !input.read(reinterpret_cast<char*>(&count), sizeof(count))) {  // NOLINT
+            throw Base::FileException("Not a binary STL file", fi);
+        }
+
+        std::streamoff begin = input.tellg();
+        input.seekg(0, std::ios::end);
+        std::streamoff size = input.tellg() - begin;
+        input.seekg(begin);
+        if (static_cast<std::streamoff>(count) * static_cast<std::streamoff>(StlFacetSize) > size) {
+            throw Base::FileException("Not a binary STL file", fi);
+        }
+
+        total = count;
+        buffer.resize(ReadBlock * StlFacetSize);
+    }
+
+    unsigned long count() const
+    {
+        return total;
+    }
+
+    /// Reads the next block of facets and returns the number of facets in it
+    std::size_t next()
+    {
+        std::size_t count = std::min<std::size_t>(ReadBlock, total - done);
+        if (count > 0 && !input.read(buffer.data(), std::streamsize(count * StlFacetSize))) {
+            throw Base::FileException("Failed to read STL file");
+        }
+        done += count;
+        return count;
+    }
+
+    /// Copies the coordinates of the points of facet \a i of the current block to \a coords
+    void points(std::size_t i, float* coords) const
+    {
+        std::memcpy(coords, buffer.data() + i * StlFacetSize + 3 * sizeof(float), ChunkFacetSize);
+    }
+
+private:
+    Base::ifstream input;
+    std::vector<char> buffer;
+    unsigned long total {0};
+    unsigned long done {0};
+};
+
+struct VertexLess
+{
+    bool operator()(const Base::Vector3f& u, const Base::Vector3f& v) const
+    {
+        if (u.x != v.x) {
+            return u.x < v.x;
+        }
+        if (u.y != v.y) {
+            return u.y < v.y;
+        }
+        return u.z < v.z;
+    }
+};
+
+/// Returns the position of \a pnt in the sorted list \a points, or -1 if it is not in the list
+std::ptrdiff_t findPoint(const std::vector<Base::Vector3f>& points, const Base::Vector3f& pnt)
+{
+    auto it = std::lower_bound(points.begin(), points.end(), pnt, VertexLess());
+    if (it == points.end() || VertexLess()(pnt, *it)) {
+        return -1;
+    }
+    return it - points.begin();
+}
+
+/// Writes the chunks of a mesh one after another to a binary STL or PLY file
+class ChunkWriter
+{
+public:
+    explicit ChunkWriter(const std::string& fileName)
+        : file(fileName)
+    {
+        if (file.hasExtension("stl")) {
+            stl = true;
+        }
+        else if (!file.hasExtension("ply")) {
+            throw Base::FileException("File extension not supported", file);
+        }
+
+        output = std::make_unique<Base::ofstream>(file, std::ios::out | std::ios::binary);
+        if (!*output) {
+            throw Base::FileException("Cannot open file for writing", file);
+        }
+
+        if (stl) {
+            std::string header("Out-of-core mesh written by FreeCAD");
+            header.resize(80, ' ');
+            output->write(header.c_str(), 80);
+            uint32_t count = 0;
+            output->write(reinterpret_cast<const char*>(&count), sizeof(count));  // NOLINT
+        }
+        else {
+            // the header of a PLY file needs the number of elements, so the points and facets
+            // are collected in temporary files first
+            pointFile.setFile(Base::FileInfo::getTempFileName());
+            facetFile.setFile(Base::FileInfo::getTempFileName());
+            points = std::make_unique<Base::ofstream>(pointFile, std::ios::out | std::ios::binary);
+            facets = std::make_unique<Base::ofstream>(facetFile, std::ios::out | std::ios::binary);
+        }
+    }
+
+    ~ChunkWriter()
+    {
+        points.reset();
+        facets.reset();
+        if (!pointFile.filePath().empty()) {
+            pointFile.deleteFile();
+            facetFile.deleteFile();
+        }
+    }
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter(ChunkWriter&&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(ChunkWriter&&) = delete;
+
+    /// Adds the facets [0, count) of \a kernel. \a seam are the points of the chunk shared
+    /// with its neighbours, sorted lexicographically.
+    void add(const MeshKernel& kernel, std::size_t count, const std::vector<Base::Vector3f>& seam)
+    {
+        if (stl) {
+            addSTL(kernel, count);
+        }
+        else {
+            addPLY(kernel, count, seam);
+        }
+        numFacets += count;
+    }
+
+    void close()
+    {
+        if (stl) {
+            uint32_t count = static_cast<uint32_t>(numFacets);
+            output->seekp(80);
+            output->write(reinterpret_cast<const char*>(&count), sizeof(count));  // NOLINT
+        }
+        else {
+            points->close();
+            facets->close();
+            *output << "ply\n"
+                    << "format binary_little_endian 1.0\n"
+                    << "comment Created by FreeCAD <https://www.freecad.org>\n"
+                    << "element vertex " << numPoints << '\n'
+                    << "property float32 x\n"
+                    << "property float32 y\n"
+                    << "property float32 z\n"
+                    << "element face " << numFacets << '\n'
+                    << "property list uchar int vertex_index\n"
+                    << "end_header\n";
+            Base::ifstream pointsIn(pointFile, std::ios::in | std::ios::binary);
+            Base::ifstream facetsIn(facetFile, std::ios::in | std::ios::binary);
+            if (numPoints > 0) {
+                *output << pointsIn.rdbuf();
+            }
+            if (numFacets > 0) {
+                *output << facetsIn.rdbuf();
+            }
+        }
+        output->close();
+        if (!*output) {
+            throw Base::FileException("Failed to write file", file);
+        }
+    }
+
+private:
+    void addSTL(const MeshKernel& kernel, std::size_t count)
+    {
+        uint16_t attribute = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            MeshGeomFacet facet = kernel.GetFacet(i);
+            Base::Vector3f normal = facet.GetNormal();
+            output->write(reinterpret_cast<const char*>(&normal.x), 3 * sizeof(float));  // NOLINT
+            for (const auto& pnt : facet._aclPoints) {
+                output->write(reinterpret_cast<const char*>(&pnt.x), 3 * sizeof(float));  // NOLINT
+            }
+            output->write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));  // NOLINT
+        }
+    }
+
+    void addPLY(const MeshKernel& kernel,
+                std::size_t count,
+                const std::vector<Base::Vector3f>& seam)
+    {
+        // The seam points may have been written with the previous chunk already, all other
+        // points belong to this chunk only. Only the seam of the previous chunk is kept, so the
+        // memory needed does not grow with the number of chunks.
+        const MeshPointArray& rPoints = kernel.GetPoints();
+        const MeshFacetArray& rFacets = kernel.GetFacets();
+        constexpr unsigned long invalid = std::numeric_limits<unsigned long>::max();
+        std::vector<unsigned long> indices(rPoints.size(), invalid);
+        std::vector<unsigned long> seamIndices(seam.size(), invalid);
+
+        Base::OutputStream pointStr(*points);
+        pointStr.setByteOrder(Base::Stream::LittleEndian);
+        Base::OutputStream facetStr(*facets);
+        facetStr.setByteOrder(Base::Stream::LittleEndian);
+
+        auto index = [&](PointIndex pnt) {
+            unsigned long& global = indices[pnt];
+            if (global != invalid) {
+                return global;
+            }
+            std::ptrdiff_t pos = findPoint(seam, rPoints[pnt]);
+            if (pos >= 0) {
+                std::ptrdiff_t last = findPoint(lastSeam, rPoints[pnt]);
+                if (last >= 0) {
+                    global = lastSeamIndices[last];
+                }
+            }
+            if (global == invalid) {
+                global = numPoints++;
+                pointStr << rPoints[pnt].x << rPoints[pnt].y << rPoints[pnt].z;
+            }
+            if (pos >= 0) {
+                seamIndices[pos] = global;
+            }
+            return global;
+        };
+
+        unsigned char n = 3;
+        for (std::size_t i = 0; i < count; i++) {
+            const MeshFacet& facet = rFacets[i];
+            int f1 = static_cast<int>(index(facet._aulPoints[0]));
+            int f2 = static_cast<int>(index(facet._aulPoints[1]));
+            int f3 = static_cast<int>(index(facet._aulPoints[2]));
+            facetStr << n << f1 << f2 << f3;
+        }
+
+        lastSeam = seam;
+        lastSeamIndices = std::move(seamIndices);
+    }
+
+private:
+    Base::FileInfo file;
+    Base::FileInfo pointFile;
+    Base::FileInfo facetFile;
+    std::unique_ptr<Base::ofstream> output;
+    std::unique_ptr<Base::ofstream> points;
+    std::unique_ptr<Base::ofstream> facets;
+    std::vector<Base::Vector3f> lastSeam;
+    std::vector<unsigned long> lastSeamIndices;
+    unsigned long numPoints {0};
+    unsigned long numFacets {0};
+    bool stl {false};
+};
+
+void readChunkFile(const std::string& fileName, unsigned long count, std::vector<char>& data)
+{
+    data.resize(count * ChunkFacetSize);
+    if (count == 0) {
+        return;
+    }
+    Base::FileInfo fi(fileName);
+    Base::ifstream input(fi, std::ios::in | std::ios::binary);
+    if (!input.read(data.data(), std::streamsize(data.size()))) {
+        throw Base::FileException("Failed to read temporary file", fi);
+    }
+}
+}  // namespace
+
+MeshOutOfCore::MeshOutOfCore(const std::string& fileName, unsigned long maxFacets)
+{
+    Base::FileInfo fi(fileName);
+    if (!fi.isReadable()) {
+        throw Base::FileException("No permission on the file", fi);
+    }
+    maxFacets = std::max(maxFacets, 1UL);
+
+    // First pass: bounding box
+    Base::BoundBox3f box;
+    float coords[9];
+    {
+        StlFacetReader reader(fi);
+        numFacets = reader.count();
+        for (std::size_t count = reader.next(); count > 0; count = reader.next()) {
+            for (std::size_t i = 0; i < count; i++) {
+                reader.points(i, coords);
+                for (int j = 0; j < 3; j++) {
+                    box.Add(Base::Vector3f(coords[3 * j], coords[3 * j + 1], coords[3 * j + 2]));
+                }
+            }
+        }
+    }
+
+    if (numFacets == 0) {
+        chunks.emplace_back();
+        return;
+    }
+
+    float lengths[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    axis = static_cast<int>(std::max_element(lengths, lengths + 3) - lengths);
+    minValue = axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+    binWidth = std::max(lengths[axis] / float(HistogramBins), std::numeric_limits<float>::min());
+
+    auto center = [this](const float* c) {
+        return (c[axis] + c[3 + axis] + c[6 + axis]) / 3.0F;
+    };
+    auto binOf = [this](float value) {
+        auto bin = static_cast<long>((value - minValue) / binWidth);
+        return static_cast<std::size_t>(std::clamp<long>(bin, 0, long(HistogramBins) - 1));
+    };
+
+    // Second pass: histogram of the facet centres along the axis and the longest edge of the
+    // facets of each bin
+    std::vector<unsigned long> histogram(HistogramBins, 0);
+    std::vector<float> longestEdge(HistogramBins, 0.0F);
+    {
+        StlFacetReader reader(fi);
+        for (std::size_t count = reader.next(); count > 0; count = reader.next()) {
+            for (std::size_t i = 0; i < count; i++) {
+                reader.points(i, coords);
+                std::size_t bin = binOf(center(coords));
+                histogram[bin]++;
+                for (int j = 0; j < 3; j++) {
+                    const float* p = coords + 3 * j;
+                    const float* q = coords + 3 * ((j + 1) % 3);
+                    longestEdge[bin] =
+                        std::max(longestEdge[bin],
+                                 Base::Distance(Base::Vector3f(p[0], p[1], p[2]),
+                                                Base::Vector3f(q[0], q[1], q[2])));
+                }
+            }
+        }
+    }
+
+    binToChunk.resize(HistogramBins);
+    chunks.emplace_back();
+    chunks.back().lower = -std::numeric_limits<float>::max();
+    unsigned long inChunk = 0;
+    for (std::size_t bin = 0; bin < HistogramBins; bin++) {
+        if (inChunk > 0 && inChunk + histogram[bin] > maxFacets) {
+            float boundary = minValue + float(bin) * binWidth;
+            chunks.back().upper = boundary;
+            chunks.emplace_back();
+            chunks.back().lower = boundary;
+            inChunk = 0;
+        }
+        inChunk += histogram[bin];
+        binToChunk[bin] = static_cast<unsigned long>(chunks.size() - 1);
+    }
+    chunks.back().upper = std::numeric_limits<float>::max();
+
+    // A point is shared by facets whose centres are less than two thirds of their longest edge
+    // away from it. For the curvature the neighbours of the neighbours are needed, too, which
+    // are less than three times the longer of the two longest edges away. So the halo of a
+    // boundary is three times the longest edge of the facets within that distance of it. It
+    // is computed for each boundary, so a few long edges elsewhere don't enlarge all halos.
+    auto haloOf = [&](float boundary) {
+        float width = 0.0F;
+        for (std::size_t bin = 0; bin < HistogramBins; bin++) {
+            float reach = 3.0F * longestEdge[bin];
+            float lower = minValue + float(bin) * binWidth;
+            float distance = std::max({0.0F, lower - boundary, boundary - lower - binWidth});
+            if (distance < reach) {
+                width = std::max(width, reach);
+            }
+        }
+        return width;
+    };
+    // halos[i] is the halo of the boundary between chunk i and i + 1
+    std::vector<float> halos(chunks.size() - 1);
+    for (std::size_t i = 0; i + 1 < chunks.size(); i++) {
+        halos[i] = haloOf(chunks[i].upper);
+    }
+    float maxHalo = halos.empty() ? 0.0F : *std::max_element(halos.begin(), halos.end());
+
+    // Third pass: write the facets of each chunk and its halo to temporary files
+    std::vector<std::unique_ptr<Base::ofstream>> coreFiles;
+    std::vector<std::unique_ptr<Base::ofstream>> haloFiles;
+    for (auto& chunk : chunks) {
+        chunk.coreFile = tempFiles.create();
+        chunk.haloFile = tempFiles.create();
+        coreFiles.push_back(std::make_unique<Base::ofstream>(Base::FileInfo(chunk.coreFile),
+                                                             std::ios::out | std::ios::binary));
+        haloFiles.push_back(std::make_unique<Base::ofstream>(Base::FileInfo(chunk.haloFile),
+                                                             std::ios::out | std::ios::binary));
+    }
+
+    {
+        StlFacetReader reader(fi);
+        Base::SequencerLauncher seq("Splitting mesh...", numFacets / ReadBlock + 1);
+        for (std::size_t count = reader.next(); count > 0; count = reader.next()) {
+            for (std::size_t i = 0; i < count; i++) {
+                reader.points(i, coords);
+                float value = center(coords);
+                unsigned long index = binToChunk[binOf(value)];
+                Chunk& chunk = chunks[index];
+                coreFiles[index]->write(reinterpret_cast<const char*>(coords),  // NOLINT
+                                        ChunkFacetSize);
+                chunk.numCore++;
+                // A halo may be wider than the chunks next to it, then it reaches further
+                auto addToHalo = [&](unsigned long other) {
+                    haloFiles[other]->write(reinterpret_cast<const char*>(coords),  // NOLINT
+                                            ChunkFacetSize);
+                    chunks[other].numHalo++;
+                };
+                for (unsigned long j = index; j > 0 && value - chunks[j - 1].upper < maxHalo;
+                     j--) {
+                    if (value - chunks[j - 1].upper < halos[j - 1]) {
+                        addToHalo(j - 1);
+                    }
+                }
+                for (unsigned long j = index + 1;
+                     j < chunks.size() && chunks[j].lower - value < maxHalo;
+                     j++) {
+                    if (chunks[j].lower - value < halos[j - 1]) {
+                        addToHalo(j);
+                    }
+                }
+            }
+            seq.next(true);
+        }
+    }
+
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        coreFiles[i]->close();
+        haloFiles[i]->close();
+        if (!*coreFiles[i] || !*haloFiles[i]) {
+            throw Base::FileException("Failed to write temporary file");
+        }
+    }
+}
+
+MeshOutOfCore::~MeshOutOfCore() = default;
+
+MeshOutOfCore::TempFiles::~TempFiles()
+{
+    for (const auto& file : files) {
+        Base::FileInfo(file).deleteFile();
+    }
+}
+
+std::string MeshOutOfCore::TempFiles::create()
+{
+    files.push_back(Base::FileInfo::getTempFileName());
+    return files.back();
+}
+
+unsigned long MeshOutOfCore::ChunkOf(float value) const
+{
+    if (binToChunk.empty()) {
+        return 0;
+    }
+    auto bin = static_cast<long>((value - minValue) / binWidth);
+    bin = std::clamp<long>(bin, 0, long(binToChunk.size()) - 1);
+    return binToChunk[bin];
+}
+
+std::vector<Base::Vector3f> MeshOutOfCore::SeamPoints(unsigned long index) const
+{
+    MeshKernel kernel;
+    unsigned long numCore = LoadChunk(index, kernel, true);
+
+    const MeshFacetArray& facets = kernel.GetFacets();
+    std::vector<bool> inCore(kernel.CountPoints(), false);
+    std::vector<bool> inHalo(kernel.CountPoints(), false);
+    for (FacetIndex i = 0; i < facets.size(); i++) {
+        std::vector<bool>& flags = i < numCore ? inCore : inHalo;
+        for (PointIndex pnt : facets[i]._aulPoints) {
+            flags[pnt] = true;
+        }
+    }
+
+    std::vector<Base::Vector3f> seam;
+    const MeshPointArray& points = kernel.GetPoints();
+    for (PointIndex i = 0; i < points.size(); i++) {
+        if (inCore[i] && inHalo[i]) {
+            seam.push_back(points[i]);
+        }
+    }
+    std::sort(seam.begin(), seam.end(), VertexLess());
+    return seam;
+}
+
+unsigned long MeshOutOfCore::LoadChunk(unsigned long index, MeshKernel& kernel, bool halo) const
+{
+    const Chunk& chunk = chunks.at(index);
+    unsigned long numHalo = halo ? chunk.numHalo : 0;
+
+    std::vector<char> data;
+    MeshFastBuilder builder(kernel);
+    builder.Initialize(static_cast<MeshFastBuilder::size_type>(chunk.numCore + numHalo));
+    readChunkFile(chunk.coreFile, chunk.numCore, data);
+    builder.AddFacets(data.data(),
+                      static_cast<MeshFastBuilder::size_type>(chunk.numCore),
+                      ChunkFacetSize);
+    if (numHalo > 0) {
+        readChunkFile(chunk.haloFile, numHalo, data);
+        builder.AddFacets(data.data(),
+                          static_cast<MeshFastBuilder::size_type>(numHalo),
+                          ChunkFacetSize);
+    }
+    builder.Finish();
+
+    return chunk.numCore;
+}
+
+unsigned long MeshOutOfCore::CountOpenEdges() const
+{
+    // An edge between two chunks is closed by a facet of the halo, and an open edge is
+    // counted by the chunk of its only facet.
+    unsigned long count = 0;
+    Base::SequencerLauncher seq("Checking for open edges...", chunks.size());
+    for (unsigned long i = 0; i < chunks.size(); i++) {
+        MeshKernel kernel;
+        unsigned long numCore = LoadChunk(i, kernel, true);
+        const MeshFacetArray& facets = kernel.GetFacets();
+        for (unsigned long j = 0; j < numCore; j++) {
+            for (FacetIndex neighbour : facets[j]._aulNeighbours) {
+                if (neighbour == FACET_INDEX_MAX) {
+                    count++;
+                }
+            }
+        }
+        seq.next(true);
+    }
+    return count;
+}
+
+void MeshOutOfCore::Simplify(float tolerance, float reduction, const std::string& fileName) const
+{
+    ChunkWriter writer(fileName);
+    Base::SequencerLauncher seq("Simplifying mesh...", chunks.size());
+    for (unsigned long i = 0; i < chunks.size(); i++) {
+        MeshKernel kernel;
+        LoadChunk(i, kernel, false);
+
+        // the seam points must match the neighbours, the other points on open edges belong to
+        // holes of the mesh and may be simplified
+        std::vector<Base::Vector3f> seam = SeamPoints(i);
+        std::vector<PointIndex> fixed;
+        const MeshPointArray& points = kernel.GetPoints();
+        for (PointIndex j = 0; j < points.size(); j++) {
+            if (findPoint(seam, points[j]) >= 0) {
+                fixed.push_back(j);
+            }
+        }
+
+        MeshSimplify simplify(kernel);
+        simplify.fixPoints(fixed);
+        simplify.simplify(tolerance, reduction);
+        writer.add(kernel, kernel.CountFacets(), seam);
+        seq.next(true);
+    }
+    writer.close();
+}
+
+void MeshOutOfCore::ComputeCurvature(const std::string& fileName) const
+{
+    Base::FileInfo fi(fileName);
+    Base::ofstream output(fi, std::ios::out);
+    if (!output) {
+        throw Base::FileException("Cannot open file for writing", fi);
+    }
+    output << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+    // Every point is written by the chunk its coordinate along the axis falls into. The halo
+    // makes sure that the chunk has all the neighbours of the point.
+    Base::SequencerLauncher seq("Computing curvature...", chunks.size());
+    for (unsigned long i = 0; i < chunks.size(); i++) {
+        MeshKernel kernel;
+        LoadChunk(i, kernel, true);
+
+        MeshCurvature curvature(kernel);
+        curvature.ComputePerVertex();
+        const std::vector<CurvatureInfo>& info = curvature.GetCurvature();
+        const MeshPointArray& points = kernel.GetPoints();
+        for (std::size_t j = 0; j < points.size(); j++) {
+            const MeshPoint& p = points[j];
+            if (ChunkOf(p[axis]) == i) {
+                output << p.x << " " << p.y << " " << p.z << " " << info[j].fMaxCurvature << " "
+                       << info[j].fMinCurvature << '\n';
+            }
+        }
+        seq.next(true);
+    }
+
+    output.close();
+    if (!output) {
+        throw Base::FileException("Failed to write file", fi);
+    }
+}
+
+void MeshOutOfCore::Export(const std::string& fileName) const
+{
+    ChunkWriter writer(fileName);
+    Base::SequencerLauncher seq("Writing mesh...", chunks.size());
+    for (unsigned long i = 0; i < chunks.size(); i++) {
+        MeshKernel kernel;
+        unsigned long numCore = LoadChunk(i, kernel, false);
+        writer.add(kernel, numCore, SeamPoints(i));
+        seq.next(true);
+    }
+    writer.close();
+}
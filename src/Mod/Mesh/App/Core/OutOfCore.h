@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef MESH_OUTOFCORE_H
+#define MESH_OUTOFCORE_H
+
+#include <string>
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshOutOfCore class processes meshes that are too large to be loaded at once.
+ *
+ * The facets of a binary STL file are distributed to slabs along the longest axis of the
+ * bounding box so that a slab holds about the given number of facets. Each slab is written to
+ * a temporary file, together with the facets of other slabs near its boundaries (the halo).
+ * The width of the halo of a boundary depends on the longest edges near it and may span
+ * several slabs. The operations then load and process one slab at a time, so the memory
+ * needed depends on the size of a slab and not on the size of the mesh.
+ *
+ * The points shared by neighbouring slabs are kept by the simplification, hence the written
+ * meshes have no gaps between the slabs. The temporary files are removed when the object is
+ * destroyed or its construction fails.
+ */
+class MeshExport MeshOutOfCore
+{
+public:
+    /** Splits the binary STL file \a fileName into chunks of about \a maxFacets facets.
+     * Throws Base::FileException if the file cannot be read.
+     */
+    MeshOutOfCore(const std::string& fileName, unsigned long maxFacets);
+    ~MeshOutOfCore();
+
+    MeshOutOfCore(const MeshOutOfCore&) = delete;
+    MeshOutOfCore(MeshOutOfCore&&) = delete;
+    MeshOutOfCore& operator=(const MeshOutOfCore&) = delete;
+    MeshOutOfCore& operator=(MeshOutOfCore&&) = delete;
+
+    /// Returns the number of facets of the whole mesh
+    unsigned long CountFacets() const
+    {
+        return numFacets;
+    }
+    /// Returns the number of chunks
+    unsigned long CountChunks() const
+    {
+        return static_cast<unsigned long>(chunks.size());
+    }
+    /** Loads chunk \a index into \a kernel and returns its number of facets. With \a halo the
+     * facets of other chunks near its boundaries are appended to the facets of the chunk.
+     */
+    unsigned long LoadChunk(unsigned long index, MeshKernel& kernel, bool halo) const;
+
+    /// Returns the number of open edges of the whole mesh
+    unsigned long CountOpenEdges() const;
+    /** Simplifies each chunk with MeshSimplify and writes the result to \a fileName as
+     * binary STL or PLY file.
+     */
+    void Simplify(float tolerance, float reduction, const std::string& fileName) const;
+    /** Computes the principal curvatures of the points and writes them to the text file
+     * \a fileName, one line "x y z max min" per point.
+     */
+    void ComputeCurvature(const std::string& fileName) const;
+    /// Writes the whole mesh to \a fileName as binary STL or PLY file
+    void Export(const std::string& fileName) const;
+
+private:
+    struct Chunk
+    {
+        std::string coreFile;
+        std::string haloFile;
+        unsigned long numCore {0};
+        unsigned long numHalo {0};
+        float lower {0.0F};
+        float upper {0.0F};
+    };
+
+    /// Owns the temporary files and deletes them in its destructor
+    class TempFiles
+    {
+    public:
+        TempFiles() = default;
+        ~TempFiles();
+
+        TempFiles(const TempFiles&) = delete;
+        TempFiles(TempFiles&&) = delete;
+        TempFiles& operator=(const TempFiles&) = delete;
+        TempFiles& operator=(TempFiles&&) = delete;
+
+        /// Returns the name of a new temporary file
+        std::string create();
+
+    private:
+        std::vector<std::string> files;
+    };
+
+    /// Returns the chunk a coordinate along the axis belongs to
+    unsigned long ChunkOf(float value) const;
+    /** Returns the points that chunk \a index shares with its neighbours, i.e. the points of
+     * its facets that are also points of the halo, sorted lexicographically.
+     */
+    std::vector<Base::Vector3f> SeamPoints(unsigned long index) const;
+
+private:
+    TempFiles tempFiles;
+    std::vector<Chunk> chunks;
+    std::vector<unsigned long> binToChunk;
+    unsigned long numFacets {0};
+    int axis {0};
+    float minValue {0.0F};
+    float binWidth {1.0F};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_OUTOFCORE_H
@@ -10,7 +10,12 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices, an upper limit for the error of a collapse and the original vertex id
+// * Add weighted quadrics of boundary and sharp edges
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 using vec3f = Base::Vector3f;
@@ -80,11 +85,17 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;int id=-1;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
+    // edges with a larger error are never collapsed
+    double max_error=std::numeric_limits<double>::max();
+    // weight of the planes through boundary edges and edges whose triangles have normals with
+    // a dot product below feature_cos, 0 to disable
+    double feature_weight=0;
+    double feature_cos=-1;
 
     void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
 
@@ -96,6 +107,7 @@ private:
     bool flipped(vec3f p,int i0,int i1,Vertex &v0,Vertex &v1,std::vector<int> &deleted);
     void update_triangles(int i0,Vertex &v,std::vector<int> &deleted,int &deleted_triangles);
     void update_mesh(int iteration);
+    void add_feature_quadrics();
     void compact_mesh();
 };
 
@@ -185,7 +197,7 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
 
             for (std::size_t j=0;j<3;++j)
             {
-                if (t.err[j]<threshold)
+                if (t.err[j]<threshold && t.err[j]<max_error)
                 {
                     int i0=t.v[ j     ]; Vertex &v0 = vertices[i0];
                     int i1=t.v[(j+1)%3]; Vertex &v1 = vertices[i1];
@@ -194,6 +206,10 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices must keep their position
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
                     calculate_error(i0,i1,p);
@@ -356,6 +372,8 @@ void Simplify::update_mesh(int iteration)
             for (std::size_t j=0;j<3;++j)
                 vertices[t.v[j]].q = vertices[t.v[j]].q+SymmetricMatrix(n.x,n.y,n.z,-n.Dot(p[0]));
         }
+        if (feature_weight > 0)
+            add_feature_quadrics();
         for (std::size_t i=0;i<triangles.size();++i)
         {
             // Calc Edge Error
@@ -446,6 +464,60 @@ void Simplify::update_mesh(int iteration)
     }
 }
 
+// A plane through each feature edge is added to the quadrics of its points with a large
+// weight. The points may still move along the edge but hardly away from it.
+
+void Simplify::add_feature_quadrics()
+{
+    struct Edge { int v0,v1,tid; };
+    std::vector<Edge> edges;
+    edges.reserve(triangles.size()*3);
+    for (std::size_t i=0;i<triangles.size();++i)
+    {
+        const Triangle &t=triangles[i];
+        for (std::size_t j=0;j<3;++j)
+        {
+            int a=t.v[j], b=t.v[(j+1)%3];
+            edges.push_back({std::min(a,b),std::max(a,b),int(i)});
+        }
+    }
+    std::sort(edges.begin(),edges.end(),[](const Edge &e1,const Edge &e2) {
+        return e1.v0<e2.v0 || (e1.v0==e2.v0 && e1.v1<e2.v1);
+    });
+
+    double s=std::sqrt(feature_weight);
+    for (std::size_t i=0;i<edges.size();)
+    {
+        std::size_t j=i+1;
+        while (j<edges.size() && edges[j].v0==edges[i].v0 && edges[j].v1==edges[i].v1)
+            ++j;
+
+        Vertex &v0=vertices[edges[i].v0];
+        Vertex &v1=vertices[edges[i].v1];
+        const vec3f &n1=triangles[edges[i].tid].n;
+        vec3f n;
+        if (j-i==1)
+        {
+            // boundary edge: plane perpendicular to its triangle
+            n=(v1.p-v0.p).Cross(n1);
+        }
+        else if (j-i==2 && n1.Dot(triangles[edges[i+1].tid].n)<feature_cos)
+        {
+            // sharp edge: plane between its two triangles
+            n=n1+triangles[edges[i+1].tid].n;
+        }
+
+        if (n.Length()>0)
+        {
+            n.Normalize();
+            SymmetricMatrix q(s*n.x,s*n.y,s*n.z,-s*n.Dot(v0.p));
+            v0.q+=q;
+            v1.q+=q;
+        }
+        i=j;
+    }
+}
+
 // Finally compact mesh before exiting
 
 void Simplify::compact_mesh()
@@ -474,6 +546,7 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].id=vertices[i].id;
             dst++;
         }
     }
@@ -22,20 +22,59 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #endif
 
 #include <Base/Tools.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
-#include "Iterator.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+constexpr std::size_t SmoothBlock = 0x1000;
+
+/** Computes the new positions of the points index(0), ..., index(count - 1) with
+ * \a compute. Without \a jacobi each point is moved right away, so the following points
+ * see its new position. With \a jacobi the positions are computed on several threads from
+ * the old points before any point is moved, so the result doesn't depend on the order of the
+ * points.
+ */
+template<class Index, class Func>
+void movePoints(MeshKernel& kernel, bool jacobi, std::size_t count, Index index, Func compute)
+{
+    if (!jacobi) {
+        for (std::size_t i = 0; i < count; i++) {
+            kernel.SetPoint(index(i), compute(index(i)));
+        }
+        return;
+    }
+
+    std::vector<Base::Vector3f> moved(count);
+    parallel_blocks(count, SmoothBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            moved[i] = compute(index(i));
+        }
+    });
+    for (std::size_t i = 0; i < count; i++) {
+        kernel.SetPoint(index(i), moved[i]);
+    }
+}
+
+PointIndex allPoints(std::size_t i)
+{
+    return static_cast<PointIndex>(i);
+}
+}  // namespace
+
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
     : kernel(m)
@@ -53,115 +92,67 @@ PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
+Base::Vector3f PlaneFitSmoothing::Fit(const MeshAdjacency& vv_it, PointIndex pos) const
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshPoint& point = points[pos];
+    MeshAdjacency::Range cv = vv_it[pos];
+    if (cv.size() < 3) {
+        return point;
+    }
 
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(point);
+    Base::Vector3f center = point;
+    for (PointIndex cv_it : cv) {
+        pf.AddPoint(points[cv_it]);
+        center += points[cv_it];
+    }
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+    float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
+    center.Scale(scale, scale, scale);
 
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
+    // get the mean plane of the current vertex with the surrounding vertices
+    pf.Fit();
+    Base::Vector3f N = pf.GetNormal();
+    N.Normalize();
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+    // look in which direction we should move the vertex
+    Base::Vector3f L = point - center;
+    if (N * L < 0.0F) {
+        N.Scale(-1.0, -1.0, -1.0);
+    }
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+    // maximum value to move is distance to mean plane
+    float d = std::min<float>(std::fabs(this->maximum), std::fabs(N * L));
+    N.Scale(d, d, d);
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+    return point - N;
+}
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+    for (unsigned int i = 0; i < iterations; i++) {
+        movePoints(kernel, true, kernel.CountPoints(), allPoints, [&](PointIndex pos) {
+            return Fit(vv_it, pos);
+        });
     }
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
                                      const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
+    auto index = [&point_indices](std::size_t i) {
+        return point_indices[i];
+    };
 
     for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        movePoints(kernel, true, point_indices.size(), index, [&](PointIndex pos) {
+            return Fit(vv_it, pos);
+        });
     }
 }
 
@@ -169,84 +160,62 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
+Base::Vector3f LaplaceSmoothing::Umbrella(const MeshAdjacency& vv_it,
+                                          const MeshAdjacency& vf_it,
+                                          double stepsize,
+                                          PointIndex pos) const
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
+    const MeshPoint& point = points[pos];
+    MeshAdjacency::Range cv = vv_it[pos];
+    if (cv.size() < 3) {
+        return point;
+    }
+    if (cv.size() != vf_it[pos].size()) {
+        // do nothing for border points
+        return point;
+    }
 
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    double w = 1.0 / double(cv.size());
+    double delx = 0.0, dely = 0.0, delz = 0.0;
+    for (PointIndex cv_it : cv) {
+        delx += w * static_cast<double>(points[cv_it].x - point.x);
+        dely += w * static_cast<double>(points[cv_it].y - point.y);
+        delz += w * static_cast<double>(points[cv_it].z - point.z);
+    }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
+    float x = static_cast<float>(static_cast<double>(point.x) + stepsize * delx);
+    float y = static_cast<float>(static_cast<double>(point.y) + stepsize * dely);
+    float z = static_cast<float>(static_cast<double>(point.z) + stepsize * delz);
+    return Base::Vector3f(x, y, z);
+}
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
+void LaplaceSmoothing::Umbrella(const MeshAdjacency& vv_it,
+                                const MeshAdjacency& vf_it,
+                                double stepsize)
+{
+    movePoints(kernel, jacobi, kernel.CountPoints(), allPoints, [&](PointIndex pos) {
+        return Umbrella(vv_it, vf_it, stepsize, pos);
+    });
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
+void LaplaceSmoothing::Umbrella(const MeshAdjacency& vv_it,
+                                const MeshAdjacency& vf_it,
                                 double stepsize,
                                 const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
-        }
-
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
-    }
+    auto index = [&point_indices](std::size_t i) {
+        return point_indices[i];
+    };
+    movePoints(kernel, jacobi, point_indices.size(), index, [&](PointIndex pos) {
+        return Umbrella(vv_it, vf_it, stepsize, pos);
+    });
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
@@ -256,8 +225,8 @@ void LaplaceSmoothing::Smooth(unsigned int iterations)
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
@@ -270,8 +239,8 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -284,8 +253,8 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency vv_it(kernel, MeshAdjacency::PointToPoints);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -329,8 +298,8 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
     std::vector<unsigned long> point_indices(kernel.CountPoints());
     std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency ff_it(kernel, MeshAdjacency::FacetToFacets);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
@@ -340,73 +309,75 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency ff_it(kernel, MeshAdjacency::FacetToFacets);
+    MeshCore::MeshAdjacency vf_it(kernel, MeshAdjacency::PointToFacets);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
     }
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(const MeshAdjacency& ff_it,
+                                         const MeshAdjacency& vf_it,
                                          const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
 
     // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
+    std::vector<Base::Vector3d> realNormals(facets.size());
+    parallel_blocks(facets.size(), SmoothBlock, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t pos = begin; pos < end; pos++) {
+            realNormals[pos] = Base::toVector<double>(kernel.GetFacet(pos).GetNormal());
+        }
+    });
 
     // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
+    std::vector<Base::Vector3d> faceNormals(facets.size());
+    parallel_blocks(facets.size(), SmoothBlock, [&](std::size_t begin, std::size_t end) {
         std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+        for (FacetIndex pos = begin; pos < end; pos++) {
+            const Base::Vector3d& refNormal = realNormals[pos];
+            const MeshCore::MeshFacet& facet = facets[pos];
+
+            anglesWithFaces.clear();
+            for (FacetIndex fi : ff_it[pos]) {
+                const Base::Vector3d& faceNormal = realNormals[fi];
+                double angle = refNormal.GetAngle(faceNormal);
+
+                int absWeight = std::abs(weights);
+                if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                    if (weights < 0) {
+                        angle = -angle;
+                    }
+                    for (int i = 0; i < absWeight; i++) {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
                 }
-                for (int i = 0; i < absWeight; i++) {
+                else {
                     anglesWithFaces.emplace_back(angle, faceNormal);
                 }
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
 
-        faceNormals[pos] = find_median(anglesWithFaces);
-    }
+            faceNormals[pos] = find_median(anglesWithFaces);
+        }
+    });
 
     // Step 2: move vertices
-    for (auto pos : point_indices) {
+    auto index = [&point_indices](std::size_t i) {
+        return point_indices[i];
+    };
+    movePoints(kernel, jacobi, point_indices.size(), index, [&](PointIndex pos) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
-
-            double faceArea = iter->Area();
+        for (FacetIndex it : vf_it[pos]) {
+            MeshGeomFacet face = kernel.GetFacet(it);
+            double faceArea = face.Area();
             totalArea += faceArea;
 
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+            Base::Vector3d C = Base::toVector<double>(face.GetGravityPoint());
 
             Base::Vector3d PC = C - P;
             Base::Vector3d mT = faceNormals[it];
@@ -415,6 +386,6 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
         }
 
         P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
-    }
+        return Base::toVector<float>(P);
+    });
 }
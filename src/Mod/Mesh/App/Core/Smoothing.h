@@ -26,15 +26,15 @@
 #include <limits>
 #include <vector>
 
+#include <Base/Vector3D.h>
+
 #include "Definitions.h"
 
 
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
+class MeshAdjacency;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -62,6 +62,19 @@ public:
     AbstractSmoothing& operator=(AbstractSmoothing&&) = delete;
 
     void initialize(Component comp, Continuity cont);
+    /** With \a on all new positions of an iteration are computed from the old positions, so
+     * the points are moved on several threads. By default each point is moved right away and
+     * the following points of the iteration already see its new position.
+     * PlaneFitSmoothing always computes the new positions from the old ones.
+     */
+    void SetJacobi(bool on)
+    {
+        jacobi = on;
+    }
+    bool IsJacobi() const
+    {
+        return jacobi;
+    }
 
     /** Smooth the triangle mesh. */
     virtual void Smooth(unsigned int) = 0;
@@ -73,6 +86,7 @@ protected:
 
     Component component {Normal};
     Continuity continuity {C0};
+    bool jacobi {false};
     // NOLINTEND
 };
 
@@ -87,6 +101,10 @@ public:
     void Smooth(unsigned int) override;
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
+private:
+    /// Returns point \a pos moved towards the mean plane of its neighbours
+    Base::Vector3f Fit(const MeshAdjacency&, PointIndex pos) const;
+
 private:
     float maximum {std::numeric_limits<float>::max()};
 };
@@ -107,11 +125,17 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
+    /** Moves all points, respectively the given points, by the umbrella operator. With
+     * SetJacobi() the new positions are computed on several threads from the old positions.
+     */
+    void Umbrella(const MeshAdjacency&, const MeshAdjacency&, double);
+    void Umbrella(const MeshAdjacency&,
+                  const MeshAdjacency&,
                   double,
                   const std::vector<PointIndex>&);
+    /// Returns point \a pos moved by the umbrella operator
+    Base::Vector3f
+    Umbrella(const MeshAdjacency&, const MeshAdjacency&, double, PointIndex pos) const;
 
 private:
     double lambda {0.6307};
@@ -149,9 +173,7 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
-                      const std::vector<PointIndex>&);
+    void UpdatePoints(const MeshAdjacency&, const MeshAdjacency&, const std::vector<PointIndex>&);
 
 private:
     int weights {1};
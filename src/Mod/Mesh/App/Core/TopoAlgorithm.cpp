@@ -49,6 +49,8 @@ MeshTopoAlgorithm::MeshTopoAlgorithm(MeshKernel& rclM)
 
 MeshTopoAlgorithm::~MeshTopoAlgorithm()
 {
+    // the operations change the arrays of the kernel directly
+    _rclMesh._ulStamp++;
     if (_needsCleanup) {
         Cleanup();
     }
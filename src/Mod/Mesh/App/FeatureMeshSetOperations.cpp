@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include "Core/Boolean.h"
 #include "Core/Iterator.h"
 #include "Core/SetOperations.h"
 
@@ -33,12 +34,20 @@ using namespace std;
 
 PROPERTY_SOURCE(Mesh::SetOperations, Mesh::Feature)
 
+const char* SetOperations::AlgorithmEnums[] = {"Classic", "Corefinement", nullptr};
 
 SetOperations::SetOperations()
 {
     ADD_PROPERTY(Source1, (nullptr));
     ADD_PROPERTY(Source2, (nullptr));
     ADD_PROPERTY(OperationType, ("union"));
+    ADD_PROPERTY_TYPE(Algorithm,
+                      (long(0)),
+                      nullptr,
+                      App::Prop_None,
+                      "Classic splits the facets along the intersection polylines, "
+                      "Corefinement also handles coplanar and touching facets");
+    Algorithm.setEnums(AlgorithmEnums);
 }
 
 short SetOperations::mustExecute() const
@@ -53,6 +62,9 @@ short SetOperations::mustExecute() const
         if (OperationType.isTouched()) {
             return 1;
         }
+        if (Algorithm.isTouched()) {
+            return 1;
+        }
     }
 
     return 0;
@@ -91,12 +103,22 @@ App::DocumentObjectExecReturn* SetOperations::execute()
                                    " or 'difference' or 'inner' or 'outer'");
         }
 
-        MeshCore::SetOperations setOp(meshKernel1.getKernel(),
-                                      meshKernel2.getKernel(),
-                                      pcKernel->getKernel(),
-                                      type,
-                                      1.0e-5F);
-        setOp.Do();
+        if (Algorithm.getValue() == 1) {
+            MeshCore::MeshBoolean boolOp(meshKernel1.getKernel(),
+                                         meshKernel2.getKernel(),
+                                         pcKernel->getKernel(),
+                                         type,
+                                         1.0e-5F);
+            boolOp.Do();
+        }
+        else {
+            MeshCore::SetOperations setOp(meshKernel1.getKernel(),
+                                          meshKernel2.getKernel(),
+                                          pcKernel->getKernel(),
+                                          type,
+                                          1.0e-5F);
+            setOp.Do();
+        }
         Mesh.setValuePtr(pcKernel.release());
     }
     else {
@@ -38,6 +38,7 @@
 #include <Base/ViewProj.h>
 #include <Base/Writer.h>
 
+#include "Core/Boolean.h"
 #include "Core/Builder.h"
 #include "Core/Decimation.h"
 #include "Core/Degeneration.h"
@@ -58,6 +59,53 @@ using namespace Mesh;
 
 const float MeshObject::Epsilon = 1.0e-5F;
 
+namespace
+{
+/// Returns the sorted indices of the facets in the grid cells passed by the line through \a pnt
+std::vector<FacetIndex> facetsAlongLine(const MeshCore::MeshFacetGrid& grid,
+                                        const Base::Vector3f& pnt,
+                                        const Base::Vector3f& dir)
+{
+    std::vector<FacetIndex> facets;
+    std::vector<FacetIndex> elements;
+    for (const Base::Vector3f& ray : {dir, -dir}) {
+        MeshCore::MeshGridIterator it(grid);
+        if (it.InitOnRay(pnt, ray, elements)) {
+            do {
+                facets.insert(facets.end(), elements.begin(), elements.end());
+            } while (it.NextOnRay(elements));
+        }
+    }
+
+    std::sort(facets.begin(), facets.end());
+    facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
+    return facets;
+}
+
+/// Applies the boolean operation \a type to the transformed kernels of both meshes
+MeshCore::MeshKernel booleanOperation(const MeshObject& mesh1,
+                                      const MeshObject& mesh2,
+                                      MeshCore::SetOperations::OperationType type,
+                                      MeshObject::BooleanAlgorithm algo,
+                                      float epsilon)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::MeshKernel kernel1(mesh1.getKernel());
+    kernel1.Transform(mesh1.getTransform());
+    MeshCore::MeshKernel kernel2(mesh2.getKernel());
+    kernel2.Transform(mesh2.getTransform());
+    if (algo == MeshObject::COREFINEMENT) {
+        MeshCore::MeshBoolean boolOp(kernel1, kernel2, result, type, epsilon);
+        boolOp.Do();
+    }
+    else {
+        MeshCore::SetOperations setOp(kernel1, kernel2, result, type, epsilon);
+        setOp.Do();
+    }
+    return result;
+}
+}  // namespace
+
 TYPESYSTEM_SOURCE(Mesh::MeshObject, Data::ComplexGeoData)
 TYPESYSTEM_SOURCE(Mesh::MeshSegment, Data::Segment)
 
@@ -239,6 +287,19 @@ MeshObject& MeshObject::operator=(MeshObject&& mesh)
     return *this;
 }
 
+const MeshCore::MeshFacetGrid& MeshObject::getFacetGrid() const
+{
+    std::lock_guard<std::mutex> lock(_gridMutex);
+    // the kernel may have been changed through a reference obtained before
+    if (!_facetGrid || _gridStamp != _kernel.GetModificationStamp()) {
+        // points moved through the kernel don't update its bounding box
+        _kernel.RecalcBoundBox();
+        _facetGrid = std::make_unique<MeshCore::MeshFacetGrid>(_kernel);
+        _gridStamp = _kernel.GetModificationStamp();
+    }
+    return *_facetGrid;
+}
+
 void MeshObject::setKernel(const MeshCore::MeshKernel& m)
 {
     this->_kernel = m;
@@ -806,18 +867,26 @@ bool MeshObject::nearestFacetOnRay(const MeshObject::TRay& ray,
     inv.multVec(pnt, pnt);
     inv.getRotation().multVec(dir, dir);
 
-    FacetIndex index = 0;
+    bool found = false;
     Base::Vector3f res;
-    MeshCore::MeshAlgorithm alg(getKernel());
+    Base::Vector3f nearest;
+    for (FacetIndex index : facetsAlongLine(getFacetGrid(), pnt, dir)) {
+        MeshCore::MeshGeomFacet facet = _kernel.GetFacet(index);
+        if (facet.Foraminate(pnt, dir, res, static_cast<float>(maxAngle))) {
+            if (!found || Base::Distance(res, pnt) < Base::Distance(nearest, pnt)) {
+                found = true;
+                nearest = res;
+                output.first = index;
+            }
+        }
+    }
 
-    if (alg.NearestFacetOnRay(pnt, dir, static_cast<float>(maxAngle), res, index)) {
-        plm.multVec(res, res);
-        output.first = index;
-        output.second = Base::toVector<double>(res);
-        return true;
+    if (found) {
+        plm.multVec(nearest, nearest);
+        output.second = Base::toVector<double>(nearest);
     }
 
-    return false;
+    return found;
 }
 
 std::vector<MeshObject::TFaceSection> MeshObject::foraminate(const TRay& ray, double maxAngle) const
@@ -833,12 +902,10 @@ std::vector<MeshObject::TFaceSection> MeshObject::foraminate(const TRay& ray, do
     inv.getRotation().multVec(dir, dir);
 
     Base::Vector3f res;
-    MeshCore::MeshFacetIterator f_it(getKernel());
-    int index = 0;
-
     std::vector<MeshObject::TFaceSection> output;
-    for (f_it.Begin(); f_it.More(); f_it.Next(), index++) {
-        if (f_it->Foraminate(pnt, dir, res, static_cast<float>(maxAngle))) {
+    for (FacetIndex index : facetsAlongLine(getFacetGrid(), pnt, dir)) {
+        MeshCore::MeshGeomFacet facet = _kernel.GetFacet(index);
+        if (facet.Foraminate(pnt, dir, res, static_cast<float>(maxAngle))) {
             plm.multVec(res, res);
 
             MeshObject::TFaceSection section;
@@ -1088,10 +1155,15 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimate(int targetSize, float maxError, float featureAngle)
+{
+    MeshCore::MeshSimplify dm(this->_kernel);
+    dm.simplifyParallel(targetSize, maxError, featureAngle);
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
-    std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
-    Base::Vector3d normal = transformVectorToOutside(temp[index]);
+    Base::Vector3d normal = transformVectorToOutside(_kernel.CalcVertexNormal(index));
     normal.Normalize();
     return normal;
 }
@@ -1112,14 +1184,27 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes,
                                float fMinEps,
                                bool bConnectPolygons) const
 {
-    MeshCore::MeshKernel kernel(this->_kernel);
-    kernel.Transform(this->_Mtrx);
+    // Cut the untransformed kernel with the planes moved relative to it. A point x of the
+    // kernel lies on the plane if n * (A * x + t - b) = 0, so the plane in kernel coordinates
+    // goes through the inverse transformed base point with the normal transpose(A) * n.
+    Base::Matrix4D inv = _Mtrx;
+    inv.inverseGauss();
+    Base::Matrix4D trp = _Mtrx;
+    trp.transpose();
 
-    MeshCore::MeshFacetGrid grid(kernel);
-    MeshCore::MeshAlgorithm algo(kernel);
+    MeshCore::MeshAlgorithm algo(this->_kernel);
     for (const auto& plane : planes) {
+        Base::Vector3f base = inv * plane.first;
+        Base::Vector3f normal = trp * plane.second;
+        normal.Normalize();
+
         MeshObject::TPolylines polylines;
-        algo.CutWithPlane(plane.first, plane.second, grid, polylines, fMinEps, bConnectPolygons);
+        algo.CutWithPlane(base, normal, getFacetGrid(), polylines, fMinEps, bConnectPolygons);
+        for (auto& polyline : polylines) {
+            for (auto& pnt : polyline) {
+                _Mtrx.multVec(pnt, pnt);
+            }
+        }
         sections.push_back(polylines);
     }
 }
@@ -1217,84 +1302,34 @@ void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& n
     }
 }
 
-MeshObject* MeshObject::unite(const MeshObject& mesh) const
+MeshObject* MeshObject::unite(const MeshObject& mesh, BooleanAlgorithm algo) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Union,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        booleanOperation(*this, mesh, MeshCore::SetOperations::Union, algo, Epsilon));
 }
 
-MeshObject* MeshObject::intersect(const MeshObject& mesh) const
+MeshObject* MeshObject::intersect(const MeshObject& mesh, BooleanAlgorithm algo) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Intersect,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        booleanOperation(*this, mesh, MeshCore::SetOperations::Intersect, algo, Epsilon));
 }
 
-MeshObject* MeshObject::subtract(const MeshObject& mesh) const
+MeshObject* MeshObject::subtract(const MeshObject& mesh, BooleanAlgorithm algo) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Difference,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        booleanOperation(*this, mesh, MeshCore::SetOperations::Difference, algo, Epsilon));
 }
 
-MeshObject* MeshObject::inner(const MeshObject& mesh) const
+MeshObject* MeshObject::inner(const MeshObject& mesh, BooleanAlgorithm algo) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Inner,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        booleanOperation(*this, mesh, MeshCore::SetOperations::Inner, algo, Epsilon));
 }
 
-MeshObject* MeshObject::outer(const MeshObject& mesh) const
+MeshObject* MeshObject::outer(const MeshObject& mesh, BooleanAlgorithm algo) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Outer,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        booleanOperation(*this, mesh, MeshCore::SetOperations::Outer, algo, Epsilon));
 }
 
 std::vector<std::vector<Base::Vector3f>>
@@ -1532,13 +1567,13 @@ void MeshObject::removeNonManifoldPoints()
 
 bool MeshObject::hasSelfIntersections() const
 {
-    MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
+    MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel, getFacetGrid());
     return !cMeshEval.Evaluate();
 }
 
 MeshObject::TFacePairs MeshObject::getSelfIntersections() const
 {
-    MeshCore::MeshEvalSelfIntersection eval(getKernel());
+    MeshCore::MeshEvalSelfIntersection eval(getKernel(), getFacetGrid());
     MeshObject::TFacePairs pairs;
     eval.GetIntersections(pairs);
     return pairs;
@@ -25,6 +25,8 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -58,6 +60,7 @@ class ViewProjMethod;
 namespace MeshCore
 {
 class AbstractPolygonTriangulator;
+class MeshFacetGrid;
 }
 
 namespace Mesh
@@ -100,6 +103,11 @@ public:
         INNER,
         OUTER
     };
+    enum BooleanAlgorithm
+    {
+        CLASSIC,     /**< MeshCore::SetOperations */
+        COREFINEMENT /**< MeshCore::MeshBoolean */
+    };
 
     using TFacePair = std::pair<FacetIndex, FacetIndex>;
     using TFacePairs = std::vector<TFacePair>;
@@ -184,6 +192,14 @@ public:
     {
         return _kernel;
     }
+    /** Returns a facet grid of the untransformed kernel. It is built on first use and shared by
+     * all queries until the kernel is modified, see MeshKernel::GetModificationStamp(). The
+     * reference is valid until the next call after a modification.
+     * @note The grid is built under a lock, but the reference is returned after releasing it.
+     * Concurrent queries are fine, but callers must not run concurrently with anything that
+     * modifies the kernel.
+     */
+    const MeshCore::MeshFacetGrid& getFacetGrid() const;
 
     Base::BoundBox3d getBoundBox() const override;
     bool getCenterOfGravity(Base::Vector3d& center) const override;
@@ -264,6 +280,7 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    void decimate(int targetSize, float maxError, float featureAngle);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&,
@@ -295,11 +312,11 @@ public:
 
     /** @name Boolean operations */
     //@{
-    MeshObject* unite(const MeshObject&) const;
-    MeshObject* intersect(const MeshObject&) const;
-    MeshObject* subtract(const MeshObject&) const;
-    MeshObject* inner(const MeshObject&) const;
-    MeshObject* outer(const MeshObject&) const;
+    MeshObject* unite(const MeshObject&, BooleanAlgorithm algo = CLASSIC) const;
+    MeshObject* intersect(const MeshObject&, BooleanAlgorithm algo = CLASSIC) const;
+    MeshObject* subtract(const MeshObject&, BooleanAlgorithm algo = CLASSIC) const;
+    MeshObject* inner(const MeshObject&, BooleanAlgorithm algo = CLASSIC) const;
+    MeshObject* outer(const MeshObject&, BooleanAlgorithm algo = CLASSIC) const;
     std::vector<std::vector<Base::Vector3f>>
     section(const MeshObject&, bool connectLines, float fMinDist) const;
     //@}
@@ -471,6 +488,9 @@ private:
     Base::Matrix4D _Mtrx;
     MeshCore::MeshKernel _kernel;
     std::vector<Segment> _segments;
+    mutable std::unique_ptr<MeshCore::MeshFacetGrid> _facetGrid;
+    mutable unsigned long _gridStamp {0};
+    mutable std::mutex _gridMutex;
     static const float Epsilon;
 };
 
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include <App/Application.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -29,6 +30,7 @@
 #include <Base/VectorPy.h>
 #include <Base/Writer.h>
 
+#include "Core/IO/CompactFormat.h"
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -888,6 +890,11 @@ void PropertyMeshKernel::Save(Base::Writer& writer) const
         saver.SaveXML(writer);
     }
     else {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Mesh/Document");
+        _saveCompact = hGrp->GetBool("CompactFormat", false);
+        _quantizationBits = static_cast<int>(hGrp->GetInt("QuantizationBits", 0));
+        _storeNeighbours = hGrp->GetBool("StoreNeighbours", true);
         writer.Stream() << writer.ind() << "<Mesh file=\"" << writer.addFile("MeshKernel.bms", this)
                         << "\"/>" << std::endl;
     }
@@ -921,7 +928,15 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    if (!_saveCompact) {
+        _meshObject->save(writer.Stream());
+        return;
+    }
+
+    MeshCore::WriterCompact compact(_meshObject->getKernel());
+    compact.SetQuantization(_quantizationBits);
+    compact.SetStoreNeighbours(_storeNeighbours);
+    compact.Save(writer.Stream());
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
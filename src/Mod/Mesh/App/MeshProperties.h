@@ -85,6 +85,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -158,6 +162,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     /** @name Python interface */
     //@{
@@ -214,6 +222,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     const char* getEditorName() const override;
 
@@ -315,6 +327,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -323,6 +339,11 @@ public:
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject {nullptr};
+    // the options of the binary format are read in Save() because SaveDocFile()
+    // may run on another thread
+    mutable bool _saveCompact {false};
+    mutable int _quantizationBits {0};
+    mutable bool _storeNeighbours {true};
 };
 
 }  // namespace Mesh
@@ -76,27 +76,57 @@ class MeshPy(ComplexGeoData):
 
     @constmethod
     def unite(self) -> Any:
-        """Union of this and the given mesh object."""
+        """
+        unite(mesh, [algorithm])
+        Union of this and the given mesh object.
+
+        The optional algorithm is 'Classic' (default) or 'Corefinement'. The corefinement
+        also handles coplanar and touching facets and leaves no gaps along the intersection.
+        """
         ...
 
     @constmethod
     def intersect(self) -> Any:
-        """Intersection of this and the given mesh object."""
+        """
+        intersect(mesh, [algorithm])
+        Intersection of this and the given mesh object.
+
+        The optional algorithm is 'Classic' (default) or 'Corefinement'. The corefinement
+        also handles coplanar and touching facets and leaves no gaps along the intersection.
+        """
         ...
 
     @constmethod
     def difference(self) -> Any:
-        """Difference of this and the given mesh object."""
+        """
+        difference(mesh, [algorithm])
+        Difference of this and the given mesh object.
+
+        The optional algorithm is 'Classic' (default) or 'Corefinement'. The corefinement
+        also handles coplanar and touching facets and leaves no gaps along the intersection.
+        """
         ...
 
     @constmethod
     def inner(self) -> Any:
-        """Get the part inside of the intersection"""
+        """
+        inner(mesh, [algorithm])
+        Get the part inside of the intersection
+
+        The optional algorithm is 'Classic' (default) or 'Corefinement'. The corefinement
+        also handles coplanar and touching facets and leaves no gaps along the intersection.
+        """
         ...
 
     @constmethod
     def outer(self) -> Any:
-        """Get the part outside the intersection"""
+        """
+        outer(mesh, [algorithm])
+        Get the part outside the intersection
+
+        The optional algorithm is 'Classic' (default) or 'Corefinement'. The corefinement
+        also handles coplanar and touching facets and leaves no gaps along the intersection.
+        """
         ...
 
     @constmethod
@@ -434,7 +464,9 @@ class MeshPy(ComplexGeoData):
     @constmethod
     def smooth(self, **kwargs) -> Any:
         """Smooth the mesh
-        smooth([iteration=1,maxError=FLT_MAX])"""
+        smooth([iteration=1,maxError=FLT_MAX])
+        With Jacobi=True the Laplace, Taubin and MedianFilter methods compute all new
+        positions of an iteration from the old ones and move the points on several threads"""
         ...
 
     def decimate(self) -> Any:
@@ -444,7 +476,15 @@ class MeshPy(ComplexGeoData):
         reduction: reduction factor must be in the range [0.0,1.0]
         Example:
         mesh.decimate(0.5, 0.1) # reduction by up to 10 percent
-        mesh.decimate(0.5, 0.9) # reduction by up to 90 percent"""
+        mesh.decimate(0.5, 0.9) # reduction by up to 90 percent
+
+        decimate(targetSize(Int), maxError(Float), featureAngle(Float))
+        Decimate the mesh on several threads
+        targetSize: number of facets to reach
+        maxError: maximum deviation of the simplified surface
+        featureAngle: points of edges sharper than this angle (in radians) are kept
+        Example:
+        mesh.decimate(mesh.CountFacets // 10, 0.1, math.radians(30))"""
         ...
 
     def mergeFacets(self) -> Any:
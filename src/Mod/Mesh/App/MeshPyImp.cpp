@@ -453,11 +453,26 @@ PyObject* MeshPy::crossSections(PyObject* args) const
     return Py::new_reference_to(crossSections);
 }
 
+namespace
+{
+MeshObject::BooleanAlgorithm toBooleanAlgorithm(const char* algo)
+{
+    if (!algo || strcmp(algo, "Classic") == 0) {
+        return MeshObject::CLASSIC;
+    }
+    if (strcmp(algo, "Corefinement") == 0) {
+        return MeshObject::COREFINEMENT;
+    }
+    throw Base::ValueError("Algorithm must either be 'Classic' or 'Corefinement'");
+}
+}  // namespace
+
 PyObject* MeshPy::unite(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    const char* algo = nullptr;
+    if (!PyArg_ParseTuple(args, "O!|s", &(MeshPy::Type), &pcObj, &algo)) {
         return nullptr;
     }
 
@@ -465,7 +480,8 @@ PyObject* MeshPy::unite(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr(), toBooleanAlgorithm(algo));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -477,7 +493,8 @@ PyObject* MeshPy::intersect(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    const char* algo = nullptr;
+    if (!PyArg_ParseTuple(args, "O!|s", &(MeshPy::Type), &pcObj, &algo)) {
         return nullptr;
     }
 
@@ -485,7 +502,8 @@ PyObject* MeshPy::intersect(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr(), toBooleanAlgorithm(algo));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -497,7 +515,8 @@ PyObject* MeshPy::difference(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    const char* algo = nullptr;
+    if (!PyArg_ParseTuple(args, "O!|s", &(MeshPy::Type), &pcObj, &algo)) {
         return nullptr;
     }
 
@@ -505,7 +524,8 @@ PyObject* MeshPy::difference(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr(), toBooleanAlgorithm(algo));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -517,7 +537,8 @@ PyObject* MeshPy::inner(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    const char* algo = nullptr;
+    if (!PyArg_ParseTuple(args, "O!|s", &(MeshPy::Type), &pcObj, &algo)) {
         return nullptr;
     }
 
@@ -525,7 +546,8 @@ PyObject* MeshPy::inner(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr(), toBooleanAlgorithm(algo));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -537,7 +559,8 @@ PyObject* MeshPy::outer(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    const char* algo = nullptr;
+    if (!PyArg_ParseTuple(args, "O!|s", &(MeshPy::Type), &pcObj, &algo)) {
         return nullptr;
     }
 
@@ -545,7 +568,8 @@ PyObject* MeshPy::outer(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr(), toBooleanAlgorithm(algo));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -2001,18 +2025,26 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     double micro = 0;
     double maximum = 1000;
     int weight = 1;
-    static const std::array<const char*, 7>
-        keywords_smooth {"Method", "Iteration", "Lambda", "Micro", "Maximum", "Weight", nullptr};
+    int jacobi = 0;
+    static const std::array<const char*, 8> keywords_smooth {"Method",
+                                                             "Iteration",
+                                                             "Lambda",
+                                                             "Micro",
+                                                             "Maximum",
+                                                             "Weight",
+                                                             "Jacobi",
+                                                             nullptr};
     if (!Base::Wrapped_ParseTupleAndKeywords(args,
                                              kwds,
-                                             "|sidddi",
+                                             "|sidddip",
                                              keywords_smooth,
                                              &method,
                                              &iter,
                                              &lambda,
                                              &micro,
                                              &maximum,
-                                             &weight)) {
+                                             &weight,
+                                             &jacobi)) {
         return nullptr;
     }
 
@@ -2025,6 +2057,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
+            smooth.SetJacobi(jacobi != 0);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "Taubin") == 0) {
@@ -2035,6 +2068,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
             if (micro > 0) {
                 smooth.SetMicro(micro);
             }
+            smooth.SetJacobi(jacobi != 0);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "PlaneFit") == 0) {
@@ -2045,6 +2079,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
         else if (strcmp(method, "MedianFilter") == 0) {
             MeshCore::MedianFilterSmoothing smooth(kernel);
             smooth.SetWeight(weight);
+            smooth.SetJacobi(jacobi != 0);
             smooth.Smooth(iter);
         }
         else {
@@ -2072,6 +2107,19 @@ PyObject* MeshPy::decimate(PyObject* args)
 
     PyErr_Clear();
     int targetSize {};
+    float maxError {};
+    float featureAngle {};
+    if (PyArg_ParseTuple(args, "iff", &targetSize, &maxError, &featureAngle)) {
+        PY_TRY
+        {
+            getMeshObjectPtr()->decimate(targetSize, maxError, featureAngle);
+        }
+        PY_CATCH;
+
+        Py_Return;
+    }
+
+    PyErr_Clear();
     if (PyArg_ParseTuple(args, "i", &targetSize)) {
         PY_TRY
         {
@@ -2083,7 +2131,8 @@ PyObject* MeshPy::decimate(PyObject* args)
     }
 
     PyErr_SetString(PyExc_ValueError,
-                    "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+                    "decimate(tolerance=float, reduction=float), decimate(targetSize=int) or "
+                    "decimate(targetSize=int, maxError=float, featureAngle=float)");
     return nullptr;
 }
 
@@ -0,0 +1,591 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+/*
+ * Measures the throughput of the hot paths of the mesh kernel on synthetic data sets.
+ *
+ * Usage:
+ *   MeshBenchmark [--facets N[,N...]] [--datasets NAME[,NAME...]] [--operations TEXT]
+ *                 [--repeat N] [--max-boolean N] [--format text|csv|json]
+ *
+ * The data sets are generated from a fixed seed and don't depend on the standard library,
+ * so the same arguments give the same meshes on every platform:
+ *   sphere   a closed UV sphere
+ *   terrain  an open height field of a few octaves of waves
+ *   scan     the terrain with noise on the points and missing patches like a laser scan
+ *
+ * Only operations whose name contains the text of --operations are measured. The set
+ * operations are limited to spheres of at most --max-boolean facets. The results are
+ * written in the selected format to stdout, progress messages to stderr.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <numbers>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/IO/CompactFormat.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+using MeshCore::MeshKernel;
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// Data sets
+
+// splitmix64, used instead of <random> whose distributions are implementation defined
+class Random
+{
+public:
+    explicit Random(uint64_t seed)
+        : state(seed)
+    {}
+    double uniform()
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return static_cast<double>(z >> 11) * 0x1.0p-53;
+    }
+
+private:
+    uint64_t state;
+};
+
+MeshKernel makeSphere(std::size_t facets)
+{
+    // rings * segments * 2 facets minus the degenerated ones at the poles
+    auto rings = static_cast<unsigned long>(std::max(3.0, std::sqrt(facets / 4.0)));
+    unsigned long segments = 2 * rings;
+    const double radius = 10.0;
+
+    MeshCore::MeshPointArray points;
+    points.reserve((rings - 1) * segments + 2);
+    points.push_back(Base::Vector3f(0.0F, 0.0F, float(radius)));
+    for (unsigned long i = 1; i < rings; i++) {
+        double theta = std::numbers::pi * double(i) / double(rings);
+        for (unsigned long j = 0; j < segments; j++) {
+            double phi = 2.0 * std::numbers::pi * double(j) / double(segments);
+            points.push_back(Base::Vector3f(float(radius * std::sin(theta) * std::cos(phi)),
+                                            float(radius * std::sin(theta) * std::sin(phi)),
+                                            float(radius * std::cos(theta))));
+        }
+    }
+    points.push_back(Base::Vector3f(0.0F, 0.0F, float(-radius)));
+
+    auto ring = [segments](unsigned long i, unsigned long j) {
+        return MeshCore::PointIndex(1 + (i - 1) * segments + j % segments);
+    };
+    MeshCore::PointIndex south = points.size() - 1;
+    MeshCore::MeshFacetArray facetArray;
+    facetArray.reserve(2 * (rings - 1) * segments);
+    for (unsigned long j = 0; j < segments; j++) {
+        facetArray.push_back(MeshCore::MeshFacet(0, ring(1, j), ring(1, j + 1)));
+    }
+    for (unsigned long i = 1; i + 1 < rings; i++) {
+        for (unsigned long j = 0; j < segments; j++) {
+            MeshCore::PointIndex p0 = ring(i, j);
+            MeshCore::PointIndex p1 = ring(i + 1, j);
+            MeshCore::PointIndex p2 = ring(i + 1, j + 1);
+            MeshCore::PointIndex p3 = ring(i, j + 1);
+            facetArray.push_back(MeshCore::MeshFacet(p0, p1, p2));
+            facetArray.push_back(MeshCore::MeshFacet(p0, p2, p3));
+        }
+    }
+    for (unsigned long j = 0; j < segments; j++) {
+        MeshCore::PointIndex p0 = ring(rings - 1, j);
+        MeshCore::PointIndex p1 = ring(rings - 1, j + 1);
+        facetArray.push_back(MeshCore::MeshFacet(p0, south, p1));
+    }
+
+    MeshKernel kernel;
+    kernel.Adopt(points, facetArray, true);
+    return kernel;
+}
+
+MeshKernel makeTerrain(std::size_t facets, double noise, double holes)
+{
+    auto size = static_cast<unsigned long>(std::max(2.0, std::sqrt(facets / 2.0)));
+    const double cell = 100.0 / double(size);
+    Random random(size);
+
+    MeshCore::MeshPointArray points;
+    points.reserve((size + 1) * (size + 1));
+    for (unsigned long i = 0; i <= size; i++) {
+        for (unsigned long j = 0; j <= size; j++) {
+            double x = cell * double(i);
+            double y = cell * double(j);
+            double z = 0.0;
+            double amplitude = 8.0;
+            double frequency = 0.05;
+            for (int octave = 0; octave < 4; octave++) {
+                z += amplitude * std::sin(frequency * x + octave) * std::cos(frequency * y);
+                amplitude *= 0.5;
+                frequency *= 2.1;
+            }
+            z += noise * cell * (random.uniform() - 0.5);
+            points.push_back(Base::Vector3f(float(x), float(y), float(z)));
+        }
+    }
+
+    // the missing patches of a scan are squares of 8x8 cells
+    const unsigned long patch = 8;
+    unsigned long patches = (size + patch - 1) / patch;
+    std::vector<bool> missing(patches * patches);
+    for (auto&& it : missing) {
+        it = random.uniform() < holes;
+    }
+
+    MeshCore::MeshFacetArray facetArray;
+    facetArray.reserve(2 * size * size);
+    for (unsigned long i = 0; i < size; i++) {
+        for (unsigned long j = 0; j < size; j++) {
+            if (missing[(i / patch) * patches + j / patch]) {
+                continue;
+            }
+            MeshCore::PointIndex p0 = i * (size + 1) + j;
+            MeshCore::PointIndex p1 = p0 + size + 1;
+            facetArray.push_back(MeshCore::MeshFacet(p0, p1, p0 + 1));
+            facetArray.push_back(MeshCore::MeshFacet(p0 + 1, p1, p1 + 1));
+        }
+    }
+
+    MeshKernel kernel;
+    kernel.Adopt(points, facetArray, true);
+    return kernel;
+}
+
+struct DataSet
+{
+    const char* name;
+    std::function<MeshKernel(std::size_t)> create;
+};
+
+const std::vector<DataSet>& dataSets()
+{
+    static const std::vector<DataSet> sets {
+        {"sphere", makeSphere},
+        {"terrain", [](std::size_t facets) { return makeTerrain(facets, 0.0, 0.0); }},
+        {"scan", [](std::size_t facets) { return makeTerrain(facets, 0.3, 0.02); }},
+    };
+    return sets;
+}
+
+// ----------------------------------------------------------------------------
+// Operations
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Func>
+double timed(Func&& func)
+{
+    auto start = Clock::now();
+    func();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Operation
+{
+    const char* name;
+    // runs the operation once and returns the elapsed time in seconds,
+    // the preparation of the input isn't measured
+    std::function<double(const MeshKernel&)> run;
+    bool booleanOnly = false;
+};
+
+template<typename Save>
+std::string saveToString(Save&& save)
+{
+    std::stringstream str;
+    save(str);
+    return str.str();
+}
+
+using SaveFunction = std::function<void(const MeshKernel&, std::ostream&)>;
+using LoadFunction = std::function<void(MeshKernel&, std::istream&)>;
+
+Operation writeOperation(const char* name, SaveFunction save)
+{
+    return {name, [save](const MeshKernel& mesh) {
+                std::stringstream str;
+                return timed([&] { save(mesh, str); });
+            }};
+}
+
+Operation readOperation(const char* name, SaveFunction save, LoadFunction load)
+{
+    return {name, [save, load](const MeshKernel& mesh) {
+                std::stringstream str(saveToString([&](std::ostream& out) { save(mesh, out); }));
+                MeshKernel kernel;
+                return timed([&] { load(kernel, str); });
+            }};
+}
+
+template<typename Query>
+Operation queryOperation(const char* name, Query query)
+{
+    return {name, [query](const MeshKernel& mesh) {
+                return timed([&] {
+                    query(mesh);
+                });
+            }};
+}
+
+template<typename Modify>
+Operation modifyOperation(const char* name, Modify modify)
+{
+    return {name, [modify](const MeshKernel& mesh) {
+                MeshKernel kernel(mesh);
+                return timed([&] { modify(kernel); });
+            }};
+}
+
+Operation booleanOperation(const char* name, bool corefinement)
+{
+    Operation op {name, [corefinement](const MeshKernel& mesh) {
+                      MeshKernel other(mesh);
+                      Base::Matrix4D mat;
+                      mat.move(Base::Vector3f(7.0F, 3.0F, 1.0F));
+                      other.Transform(mat);
+                      MeshKernel result;
+                      return timed([&] {
+                          if (corefinement) {
+                              MeshCore::MeshBoolean(mesh,
+                                                    other,
+                                                    result,
+                                                    MeshCore::SetOperations::Union)
+                                  .Do();
+                          }
+                          else {
+                              MeshCore::SetOperations(mesh,
+                                                      other,
+                                                      result,
+                                                      MeshCore::SetOperations::Union)
+                                  .Do();
+                          }
+                      });
+                  }};
+    op.booleanOnly = true;
+    return op;
+}
+
+const std::vector<Operation>& operations()
+{
+    using MeshCore::MeshInput;
+    using MeshCore::MeshOutput;
+
+    auto saveSTL = [](const MeshKernel& mesh, std::ostream& str) {
+        MeshOutput(mesh).SaveBinarySTL(str);
+    };
+    auto loadSTL = [](MeshKernel& mesh, std::istream& str) {
+        MeshInput(mesh).LoadBinarySTL(str);
+    };
+    auto savePLY = [](const MeshKernel& mesh, std::ostream& str) {
+        MeshOutput(mesh).SaveBinaryPLY(str);
+    };
+    auto loadPLY = [](MeshKernel& mesh, std::istream& str) {
+        MeshInput(mesh).LoadPLY(str);
+    };
+    auto saveOBJ = [](const MeshKernel& mesh, std::ostream& str) {
+        MeshOutput(mesh).SaveOBJ(str);
+    };
+    auto loadOBJ = [](MeshKernel& mesh, std::istream& str) {
+        MeshInput(mesh).LoadOBJ(str);
+    };
+    auto saveKernel = [](const MeshKernel& mesh, std::ostream& str) {
+        mesh.Write(str);
+    };
+    auto loadKernel = [](MeshKernel& mesh, std::istream& str) {
+        mesh.Read(str);
+    };
+    auto saveCompact = [](const MeshKernel& mesh, std::ostream& str) {
+        MeshCore::WriterCompact(mesh).Save(str);
+    };
+
+    static const std::vector<Operation> ops {
+        writeOperation("io.stl.write", saveSTL),
+        readOperation("io.stl.read", saveSTL, loadSTL),
+        writeOperation("io.ply.write", savePLY),
+        readOperation("io.ply.read", savePLY, loadPLY),
+        writeOperation("io.obj.write", saveOBJ),
+        readOperation("io.obj.read", saveOBJ, loadOBJ),
+        writeOperation("io.kernel.write", saveKernel),
+        readOperation("io.kernel.read", saveKernel, loadKernel),
+        writeOperation("io.compact.write", saveCompact),
+        readOperation("io.compact.read", saveCompact, loadKernel),
+        modifyOperation("topology.rebuild_neighbours",
+                        [](MeshKernel& mesh) {
+                            mesh.RebuildNeighbours();
+                        }),
+        queryOperation("grid.facet_grid",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshFacetGrid grid(mesh);
+                       }),
+        queryOperation("eval.topology",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshEvalTopology(mesh).Evaluate();
+                       }),
+        queryOperation("eval.neighbourhood",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshEvalNeighbourhood(mesh).Evaluate();
+                       }),
+        queryOperation("eval.duplicate_points",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshEvalDuplicatePoints(mesh).Evaluate();
+                       }),
+        queryOperation("eval.degenerated_facets",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshEvalDegeneratedFacets eval(
+                               mesh,
+                               MeshCore::MeshDefinitions::_fMinPointDistanceD1);
+                           eval.Evaluate();
+                       }),
+        queryOperation("eval.self_intersection",
+                       [](const MeshKernel& mesh) {
+                           MeshCore::MeshEvalSelfIntersection(mesh).Evaluate();
+                       }),
+        modifyOperation("fix.duplicate_points",
+                        [](MeshKernel& mesh) {
+                            MeshCore::MeshFixDuplicatePoints(mesh).Fixup();
+                        }),
+        modifyOperation("fix.degenerated_facets",
+                        [](MeshKernel& mesh) {
+                            MeshCore::MeshFixDegeneratedFacets(
+                                mesh,
+                                MeshCore::MeshDefinitions::_fMinPointDistanceD1)
+                                .Fixup();
+                        }),
+        modifyOperation("decimation.parallel",
+                        [](MeshKernel& mesh) {
+                            int target = static_cast<int>(mesh.CountFacets() / 4);
+                            MeshCore::MeshSimplify(mesh).simplifyParallel(target, 0.1F, 0.5F);
+                        }),
+        modifyOperation("smoothing.laplace",
+                        [](MeshKernel& mesh) {
+                            MeshCore::LaplaceSmoothing(mesh).Smooth(1);
+                        }),
+        modifyOperation("smoothing.taubin",
+                        [](MeshKernel& mesh) {
+                            MeshCore::TaubinSmoothing(mesh).Smooth(1);
+                        }),
+        modifyOperation("smoothing.laplace.jacobi",
+                        [](MeshKernel& mesh) {
+                            MeshCore::LaplaceSmoothing smooth(mesh);
+                            smooth.SetJacobi(true);
+                            smooth.Smooth(1);
+                        }),
+        booleanOperation("boolean.classic", false),
+        booleanOperation("boolean.corefinement", true),
+    };
+    return ops;
+}
+
+// ----------------------------------------------------------------------------
+// Results
+
+struct Result
+{
+    std::string dataset;
+    unsigned long facets;
+    std::string operation;
+    int repeat;
+    double minimum;
+    double mean;
+};
+
+void printText(const std::vector<Result>& results)
+{
+    std::printf("%-10s %10s  %-28s %12s %12s\n", "dataset", "facets", "operation", "min", "mean");
+    for (const auto& it : results) {
+        std::printf("%-10s %10lu  %-28s %10.3fms %10.3fms\n",
+                    it.dataset.c_str(),
+                    it.facets,
+                    it.operation.c_str(),
+                    it.minimum * 1000.0,
+                    it.mean * 1000.0);
+    }
+}
+
+void printCSV(const std::vector<Result>& results)
+{
+    std::printf("dataset,facets,operation,repeat,min_seconds,mean_seconds\n");
+    for (const auto& it : results) {
+        std::printf("%s,%lu,%s,%d,%.9f,%.9f\n",
+                    it.dataset.c_str(),
+                    it.facets,
+                    it.operation.c_str(),
+                    it.repeat,
+                    it.minimum,
+                    it.mean);
+    }
+}
+
+void printJSON(const std::vector<Result>& results)
+{
+    std::printf("{\n  \"threads\": %u,\n  \"results\": [", std::thread::hardware_concurrency());
+    const char* separator = "\n";
+    for (const auto& it : results) {
+        std::printf("%s    {\"dataset\": \"%s\", \"facets\": %lu, \"operation\": \"%s\", "
+                    "\"repeat\": %d, \"min_seconds\": %.9f, \"mean_seconds\": %.9f}",
+                    separator,
+                    it.dataset.c_str(),
+                    it.facets,
+                    it.operation.c_str(),
+                    it.repeat,
+                    it.minimum,
+                    it.mean);
+        separator = ",\n";
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::stringstream str(text);
+    std::string item;
+    while (std::getline(str, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program
+              << " [--facets N[,N...]] [--datasets NAME[,NAME...]] [--operations TEXT]\n"
+                 "       [--repeat N] [--max-boolean N] [--format text|csv|json]\n";
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::size_t> sizes {10000, 100000, 1000000};
+    std::vector<std::string> names {"sphere", "terrain", "scan"};
+    std::string filter;
+    std::string format = "text";
+    std::size_t maxBoolean = 1000000;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 == argc) {
+            return usage(argv[0]);
+        }
+        std::string value = argv[++i];
+        if (arg == "--facets") {
+            sizes.clear();
+            for (const auto& it : split(value)) {
+                sizes.push_back(std::stoul(it));
+            }
+        }
+        else if (arg == "--datasets") {
+            names = split(value);
+        }
+        else if (arg == "--operations") {
+            filter = value;
+        }
+        else if (arg == "--repeat") {
+            repeat = std::max(1, std::stoi(value));
+        }
+        else if (arg == "--max-boolean") {
+            maxBoolean = std::stoul(value);
+        }
+        else if (arg == "--format") {
+            format = value;
+        }
+        else {
+            return usage(argv[0]);
+        }
+    }
+
+    std::vector<Result> results;
+    for (const auto& name : names) {
+        auto set = std::find_if(dataSets().begin(), dataSets().end(), [&name](const DataSet& ds) {
+            return name == ds.name;
+        });
+        if (set == dataSets().end()) {
+            std::cerr << "Unknown data set: " << name << '\n';
+            return 1;
+        }
+
+        for (std::size_t size : sizes) {
+            MeshKernel mesh = set->create(size);
+            std::cerr << set->name << " with " << mesh.CountFacets() << " facets\n";
+            for (const auto& op : operations()) {
+                if (std::string(op.name).find(filter) == std::string::npos) {
+                    continue;
+                }
+                if (op.booleanOnly
+                    && (std::string(set->name) != "sphere" || mesh.CountFacets() > maxBoolean)) {
+                    continue;
+                }
+
+                std::cerr << "  " << op.name << '\n';
+                Result result {set->name, mesh.CountFacets(), op.name, repeat, 0.0, 0.0};
+                for (int i = 0; i < repeat; i++) {
+                    double elapsed = op.run(mesh);
+                    result.minimum = i == 0 ? elapsed : std::min(result.minimum, elapsed);
+                    result.mean += elapsed / repeat;
+                }
+                results.push_back(result);
+            }
+        }
+    }
+
+    if (format == "csv") {
+        printCSV(results);
+    }
+    else if (format == "json") {
+        printJSON(results);
+    }
+    else {
+        printText(results);
+    }
+    return 0;
+}
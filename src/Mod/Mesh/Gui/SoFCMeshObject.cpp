@@ -358,10 +358,7 @@ SoFCMeshPickNode::SoFCMeshPickNode()
 /*!
   Destructor.
 */
-SoFCMeshPickNode::~SoFCMeshPickNode()
-{
-    delete meshGrid;
-}
+SoFCMeshPickNode::~SoFCMeshPickNode() = default;
 
 // Doc from superclass.
 void SoFCMeshPickNode::initClass()
@@ -369,20 +366,6 @@ void SoFCMeshPickNode::initClass()
     SO_NODE_INIT_CLASS(SoFCMeshPickNode, SoNode, "Node");
 }
 
-void SoFCMeshPickNode::notify(SoNotList* list)
-{
-    SoField* f = list->getLastField();
-    if (f == &mesh) {
-        const Mesh::MeshObject* meshObject = mesh.getValue();
-        if (meshObject) {
-            MeshCore::MeshAlgorithm alg(meshObject->getKernel());
-            float fAvgLen = alg.GetAverageEdgeLength();
-            delete meshGrid;
-            meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0F * fAvgLen);
-        }
-    }
-}
-
 // Doc from superclass.
 void SoFCMeshPickNode::rayPick(SoRayPickAction* /*action*/)
 {}
@@ -394,6 +377,9 @@ void SoFCMeshPickNode::pick(SoPickAction* action)
     raypick->setObjectSpace();
 
     const Mesh::MeshObject* meshObject = mesh.getValue();
+    if (!meshObject) {
+        return;
+    }
     MeshCore::MeshAlgorithm alg(meshObject->getKernel());
 
     const SbLine& line = raypick->getLine();
@@ -402,7 +388,7 @@ void SoFCMeshPickNode::pick(SoPickAction* action)
     Base::Vector3f pt(pos[0], pos[1], pos[2]);
     Base::Vector3f dr(dir[0], dir[1], dir[2]);
     Mesh::FacetIndex index {};
-    if (alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index)) {
+    if (alg.NearestFacetOnRay(pt, dr, meshObject->getFacetGrid(), pt, index)) {
         SoPickedPoint* pp = raypick->addIntersection(SbVec3f(pt.x, pt.y, pt.z));
         if (pp) {
             SoFaceDetail* det = new SoFaceDetail();
@@ -36,11 +36,6 @@ using GLuint = unsigned int;
 using GLint = int;
 using GLfloat = float;
 
-namespace MeshCore
-{
-class MeshFacetGrid;
-}
-
 namespace MeshGui
 {
 
@@ -94,7 +89,6 @@ class MeshGuiExport SoFCMeshPickNode: public SoNode
 public:
     static void initClass();
     SoFCMeshPickNode();
-    void notify(SoNotList*) override;
 
     SoSFMeshObject mesh;  // NOLINT
 
@@ -103,9 +97,6 @@ public:
 
 protected:
     ~SoFCMeshPickNode() override;
-
-private:
-    MeshCore::MeshFacetGrid* meshGrid {nullptr};
 };
 
 // -------------------------------------------------------
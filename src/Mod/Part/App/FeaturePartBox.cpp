@@ -52,11 +52,33 @@ short Box::mustExecute() const
     return Primitive::mustExecute();
 }
 
+void Box::prepareRecompute()
+{
+    double L = Length.getValue();
+    double W = Width.getValue();
+    double H = Height.getValue();
+    prepared.reset();
+
+    // invalid dimensions are reported by execute()
+    if (L < Precision::Confusion() || W < Precision::Confusion() || H < Precision::Confusion())
+        return;
+
+    try {
+        BRepPrimAPI_MakeBox mkBox(L, W, H);
+        prepared = PreparedBox{L, W, H, mkBox.Shape()};
+    }
+    catch (Standard_Failure&) {
+        // execute() builds the box again and reports the error
+    }
+}
+
 App::DocumentObjectExecReturn *Box::execute()
 {
     double L = Length.getValue();
     double W = Width.getValue();
     double H = Height.getValue();
+    std::optional<PreparedBox> box;
+    box.swap(prepared);
 
     if (L < Precision::Confusion())
         return new App::DocumentObjectExecReturn("Length of box too small");
@@ -68,9 +90,16 @@ App::DocumentObjectExecReturn *Box::execute()
         return new App::DocumentObjectExecReturn("Height of box too small");
 
     try {
-        // Build a box using the dimension attributes
-        BRepPrimAPI_MakeBox mkBox(L, W, H);
-        TopoDS_Shape ResultShape = mkBox.Shape();
+        // Build a box using the dimension attributes, unless it was built by
+        // prepareRecompute() for the same dimensions
+        TopoDS_Shape ResultShape;
+        if (box && box->length == L && box->width == W && box->height == H) {
+            ResultShape = box->shape;
+        }
+        else {
+            BRepPrimAPI_MakeBox mkBox(L, W, H);
+            ResultShape = mkBox.Shape();
+        }
         this->Shape.setValue(ResultShape, false);
         return Primitive::execute();
     }
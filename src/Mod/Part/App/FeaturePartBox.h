@@ -23,6 +23,8 @@
 #ifndef PART_FEATUREPARTBOX_H
 #define PART_FEATUREPARTBOX_H
 
+#include <optional>
+
 #include <App/PropertyStandard.h>
 
 #include "PrimitiveFeature.h"
@@ -46,6 +48,12 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn *execute() override;
     short mustExecute() const override;
+    /// the box only depends on its own dimensions
+    bool canRecomputeConcurrently() const override {
+        return true;
+    }
+    /// build the box of the current dimensions for the next execute()
+    void prepareRecompute() override;
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override {
         return "PartGui::ViewProviderBox";
@@ -55,6 +63,13 @@ protected:
     /// get called by the container when a property has changed
     void onChanged (const App::Property* prop) override;
     //@}
+
+private:
+    struct PreparedBox {
+        double length, width, height;
+        TopoDS_Shape shape;
+    };
+    std::optional<PreparedBox> prepared;
 };
 
 } //namespace Part
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <memory>
 # include <sstream>
 # include <Bnd_Box.hxx>
 # include <BRepBndLib.hxx>
@@ -45,10 +46,12 @@
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
+#include <zipios++/zipfile.h>
 
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "PropertyTopoShape.h"
+#include "ShapeMapHasher.h"
 #include "TopoShapePy.h"
 #include "PartFeature.h"
 
@@ -57,6 +60,172 @@ FC_LOG_LEVEL_INIT("App", true, true)
 namespace sp = std::placeholders;
 using namespace Part;
 
+namespace Part
+{
+
+/** Shared handle to the archive of a document whose shapes are restored lazily.
+ * The central directory of the archive is read only once for all pending shapes.
+ * When the document is saved to the same file the pending shape files are copied
+ * through unchanged (see PropertyPartShape::SaveDocFile()) and looked up in the new
+ * file once it has replaced the old one.
+ */
+class ShapeArchive
+{
+public:
+    ShapeArchive(App::Document* doc, const std::string& path)
+        : path(path)
+        , zip(std::make_unique<zipios::ZipFile>(path))
+    {
+        if (doc) {
+            connStartSave = doc->signalStartSave.connect(
+                [this](const App::Document&, const std::string& filename) {
+                    slotStartSave(filename);
+                });
+            connFinishSave = doc->signalFinishSave.connect(
+                [this](const App::Document&, const std::string& filename) {
+                    slotFinishSave(filename);
+                });
+        }
+    }
+
+    ~ShapeArchive()
+    {
+        if (!snapshot.empty())
+            Base::FileInfo(snapshot).deleteFile();
+    }
+
+    /// Returns the shared handle of the archive \a path of \a doc
+    static std::shared_ptr<ShapeArchive> open(App::Document* doc, const std::string& path)
+    {
+        static std::mutex registryMutex;
+        static std::map<std::string, std::weak_ptr<ShapeArchive>> registry;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto it = registry.begin(); it != registry.end();) {
+            if (it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+        auto& entry = registry[path];
+        auto archive = entry.lock();
+        if (!archive) {
+            archive = std::make_shared<ShapeArchive>(doc, path);
+            entry = archive;
+        }
+        return archive;
+    }
+
+    /// Registers the entry of a pending shape
+    void addEntry(const std::string& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current.emplace(entry, entry);
+    }
+
+    /// Returns the stream of \a entry or null if it's not available anymore
+    std::unique_ptr<std::istream> getInputStream(const std::string& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = current.find(entry);
+        if (!zip || it == current.end() || it->second.empty())
+            return {};
+        return std::unique_ptr<std::istream>(zip->getInputStream(it->second));
+    }
+
+    /// Copies \a entry unchanged to \a out
+    bool copyEntry(const std::string& entry, std::ostream& out)
+    {
+        auto str = getInputStream(entry);
+        if (!str)
+            return false;
+        out << str->rdbuf();
+        return !str->bad();
+    }
+
+    /// Records that \a entry is written as \a file by the current save
+    void relocate(const std::string& entry, const std::string& file)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        saved[entry] = file;
+    }
+
+private:
+    bool isArchive(const std::string& filename) const
+    {
+        return Base::FileInfo(filename).filePath() == path;
+    }
+
+    void slotStartSave(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        saved.clear();
+        if (!zip || !isArchive(filename) || !snapshot.empty())
+            return;
+
+        // Without a backup policy the document is written directly into the archive.
+        // The pending shape files are then read from a copy of it while saving.
+        bool policy = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Document")->GetBool("BackupPolicy", true);
+        if (policy)
+            return;
+        std::string copy = App::Application::getTempFileName();
+        try {
+            if (Base::FileInfo(path).copyTo(copy.c_str())) {
+                zip = std::make_unique<zipios::ZipFile>(copy);
+                snapshot = copy;
+                return;
+            }
+        }
+        catch (const std::exception&) {
+        }
+        Base::FileInfo(copy).deleteFile();
+        FC_ERR("Failed to copy " << path << ", pending shapes are lost");
+        zip.reset();
+    }
+
+    void slotFinishSave(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!isArchive(filename)) {
+            saved.clear();
+            return;
+        }
+
+        // The archive has been replaced, shapes that weren't saved are not in it.
+        for (auto& [entry, file] : current) {
+            auto it = saved.find(entry);
+            file = it != saved.end() ? it->second : std::string();
+        }
+        saved.clear();
+        if (!snapshot.empty()) {
+            Base::FileInfo(snapshot).deleteFile();
+            snapshot.clear();
+        }
+        try {
+            zip = std::make_unique<zipios::ZipFile>(path);
+        }
+        catch (const std::exception& e) {
+            FC_ERR("Failed to reopen " << path << ": " << e.what());
+            zip.reset();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::string path;
+    std::string snapshot;
+    std::unique_ptr<zipios::ZipFile> zip;
+    /// Maps the original entry of a pending shape to the one in the current file
+    std::map<std::string, std::string> current;
+    /// Entries written by the save in progress
+    std::map<std::string, std::string> saved;
+    boost::signals2::scoped_connection connStartSave;
+    boost::signals2::scoped_connection connFinishSave;
+};
+
+}
+
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData)
 
 PropertyPartShape::PropertyPartShape() = default;
@@ -66,6 +235,8 @@ PropertyPartShape::~PropertyPartShape() = default;
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    resetPendingShape();
+    _SharedSource = nullptr;
     _Shape = sh;
     auto obj = freecad_cast<App::DocumentObject*>(getContainer());
     if(obj) {
@@ -90,6 +261,8 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
         _Shape.Tag = obj->getID();
+    resetPendingShape();
+    _SharedSource = nullptr;
     _Shape.setShape(sh,resetElementMap);
     hasSetValue();
     _Ver.clear();
@@ -97,11 +270,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    loadPendingShape();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadPendingShape();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -118,6 +293,7 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadPendingShape();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
@@ -125,6 +301,7 @@ const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
     Base::BoundBox3d box;
+    loadPendingShape();
     if (_Shape.getShape().IsNull())
         return box;
     try {
@@ -150,16 +327,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    loadPendingShape();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    loadPendingShape();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadPendingShape();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -167,6 +347,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject()
 {
+    loadPendingShape();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -204,6 +385,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 App::Property *PropertyPartShape::Copy() const
 {
     PropertyPartShape *prop = new PropertyPartShape();
+    loadPendingShape();
 
     // March, 2024 Toponaming project:  There was originally a feature to enable making an element
     // copy ( new geometry and map ) that has not been kept:
@@ -221,6 +403,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if(prop) {
+        prop->loadPendingShape();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -250,7 +433,7 @@ void PropertyPartShape::beforeSave() const
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
-    if(owner && !_Shape.isNull() && _Shape.getElementMapSize()>0) {
+    if(owner && hasShape() && _Shape.getElementMapSize()>0) {
         auto ret = owner->getDocument()->addStringHasher(_Shape.Hasher);
         _HasherIndex = ret.second;
         _SaveHasher = ret.first;
@@ -260,9 +443,13 @@ void PropertyPartShape::beforeSave() const
 void PropertyPartShape::Save (Base::Writer &writer) const
 {
     //See SaveDocFile(), RestoreDocFile()
+    bool binary = writer.getMode("BinaryBrep");
+    bool toXML = writer.isForceXML();
+    if (toXML || !isPendingFileCompatible(binary))
+        loadPendingShape();
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
-    if(owner && !_Shape.isNull()
+    if(owner && hasShape()
         && _Shape.getElementMapSize()>0
         && !_Shape.Hasher.isNull()) {
         writer.Stream() << " HasherIndex=\"" << _HasherIndex << '"';
@@ -281,12 +468,23 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     }
     writer.Stream() << " ElementMap=\"" << version << '"';
 
-    bool binary = writer.getMode("BinaryBrep");
-    bool toXML = writer.isForceXML();
     if(!toXML) {
-        writer.Stream() << " file=\""
-                        << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this)
-                        << "\"/>\n";
+        bool share = owner && !_Shape.isNull() && App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DeduplicateShapes", false);
+        std::size_t key = share ? ShapeMapHasher()(_Shape.getShape()) : 0;
+        std::string shared = share ? findSharedFile(writer, key) : std::string();
+        if (!shared.empty()) {
+            writer.Stream() << " SharedFile=\"" << shared << "\"/>\n";
+        }
+        else {
+            std::string file = writer.addFile(getFileName(binary?".bin":".brp").c_str(), this);
+            if (share)
+                writer.addSharedFile(key, file, this);
+            std::lock_guard<std::mutex> lock(_LazyMutex);
+            if (_LazyPending)
+                _LazyArchive->relocate(_LazyEntry, file);
+            writer.Stream() << " file=\"" << file << "\"/>\n";
+        }
     } else if(binary) {
         writer.Stream() << " binary=\"1\">\n";
         _Shape.exportBinary(writer.beginCharStream(Base::CharStreamFormat::Base64Encoded));
@@ -313,6 +511,24 @@ void PropertyPartShape::Save (Base::Writer &writer) const
     }
 }
 
+std::string PropertyPartShape::findSharedFile(Base::Writer &writer, std::size_t key) const
+{
+    // Shapes with the same TShape, location and orientation, e.g. the shape of a body
+    // and its tip, are written only once. Only the file of an object the owner depends
+    // on is shared so that it's also available when the document is partially loaded.
+    auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+    for (const auto& [file, object] : writer.getSharedFiles(key)) {
+        auto prop = freecad_cast<const PropertyPartShape*>(object);
+        if (!prop || !prop->_Shape.getShape().IsEqual(_Shape.getShape()))
+            continue;
+        auto source = freecad_cast<App::DocumentObject*>(prop->getContainer());
+        if (source && source->getDocument() == owner->getDocument()
+                   && owner->isInOutListRecursive(source))
+            return file;
+    }
+    return {};
+}
+
 std::string PropertyPartShape::getElementMapVersion(bool restored) const {
     if(restored)
         return _Ver;
@@ -324,6 +540,8 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     reader.readElement("Part");
 
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+    resetPendingShape();
+    _SharedSource = nullptr;
     _Ver = "?";
     bool has_ver = reader.hasAttribute("ElementMap");
     if (has_ver)
@@ -341,10 +559,24 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
             reader.addFile(file.c_str(), this);
         }
     }
+    else if (reader.hasAttribute("SharedFile")) {
+        // the shape is the one of another property that was restored before, it's
+        // taken over in afterRestore() once the file has been read
+        std::string file = reader.getAttribute<const char*>("SharedFile");
+        for (const auto& entry : reader.FileList) {
+            if (entry.FileName == file) {
+                _SharedSource = freecad_cast<PropertyPartShape*>(entry.Object);
+                break;
+            }
+        }
+        if (!_SharedSource) {
+            FC_WARN("Shared shape file '" << file << "' of " << getFullName() << " not found");
+            if (owner)
+                owner->getDocument()->addRecomputeObject(owner);
+        }
+    }
     else if (reader.hasAttribute(("binary")) && reader.getAttribute<long>("binary")) {
-        TopoShape shape;
         shape.importBinary(reader.beginCharStream());
-        shape = shape.getShape();
     }
     else if (reader.hasAttribute("brep") && reader.getAttribute<long>("brep")) {
         shape.importBrep(reader.beginCharStream(Base::CharStreamFormat::Raw));
@@ -409,6 +641,20 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 
 void PropertyPartShape::afterRestore()
 {
+    if (_SharedSource) {
+        auto source = _SharedSource;
+        _SharedSource = nullptr;
+        std::lock_guard<std::mutex> lock(source->_LazyMutex);
+        if (source->_LazyPending) {
+            _LazyArchive = source->_LazyArchive;
+            _LazyEntry = source->_LazyEntry;
+            _LazyPending = true;
+        }
+        else {
+            _Shape.setShape(source->_Shape.getShape(), false);
+        }
+    }
+
     if (_Shape.isRestoreFailed()) {
         // this cause GeoFeature::updateElementReference() to call
         // PropertyLinkBase::updateElementReferences() with reverse = true, in
@@ -504,7 +750,7 @@ void PropertyPartShape::saveToFile(Base::Writer &writer) const
     fi.deleteFile();
 }
 
-void PropertyPartShape::loadFromFile(Base::Reader &reader)
+TopoDS_Shape PropertyPartShape::loadFromFile(Base::Reader &reader)
 {
     BRep_Builder builder;
     // create a temporary file and copy the content from the zip stream
@@ -544,28 +790,53 @@ void PropertyPartShape::loadFromFile(Base::Reader &reader)
 
     // delete the temp file
     fi.deleteFile();
-    setValue(shape);
+    return shape;
 }
 
-void PropertyPartShape::loadFromStream(Base::Reader &reader)
+bool PropertyPartShape::loadFromStream(Base::Reader &reader, TopoDS_Shape &shape)
 {
+    if (Base::FileInfo(reader.getFileName()).hasExtension("bin")) {
+        TopoShape binary;
+        binary.importBinary(reader);
+        shape = binary.getShape();
+        return true;
+    }
     try {
         reader.exceptions(std::istream::failbit | std::istream::badbit);
         BRep_Builder builder;
-        TopoDS_Shape shape;
         BRepTools::Read(shape, reader, builder);
-        setValue(shape);
     }
     catch (const std::exception&) {
-        if (!reader.eof())
-            Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
+        shape.Nullify();
+        return reader.eof();
     }
+    return true;
+}
+
+void PropertyPartShape::setRestoredShape(const TopoDS_Shape &shape)
+{
+    // Keep the element map and hasher restored before the shape file is read.
+    // setValue() clears _Ver, so it's kept as well.
+    auto elementMap = _Shape.resetElementMap();
+    TopoShape value(shape);
+    value.Hasher = _Shape.Hasher;
+    value.resetElementMap(elementMap);
+    std::string ver = _Ver;
+    setValue(value);
+    _Ver = ver;
 }
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
+    if (isPendingFileCompatible(writer.getMode("BinaryBrep"))) {
+        // copy the shape file of a deferred shape through without reading it
+        std::lock_guard<std::mutex> lock(_LazyMutex);
+        if (_LazyPending && _LazyArchive->copyEntry(_LazyEntry, writer.Stream()))
+            return;
+    }
+    loadPendingShape();
     if (_Shape.getShape().IsNull())
         return;
     TopoDS_Shape myShape = _Shape.getShape();
@@ -590,45 +861,133 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 {
+    // For large documents most of the time spent in opening them goes into parsing
+    // the shapes. With lazy loading enabled only the location of the shape file is
+    // kept and the shape is read on first access. The element map and hasher are
+    // restored independently of the shape and are kept as is in the meantime.
+    if (!reader.getArchiveFileName().empty()) {
+        bool lazy = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("LazyLoadShapes", false);
+        if (lazy) {
+            auto owner = freecad_cast<App::DocumentObject*>(getContainer());
+            std::shared_ptr<ShapeArchive> archive;
+            try {
+                archive = ShapeArchive::open(owner ? owner->getDocument() : nullptr,
+                                             reader.getArchiveFileName());
+            }
+            catch (const std::exception& e) {
+                FC_WARN("Failed to open " << reader.getArchiveFileName() << ": " << e.what());
+            }
+            if (archive) {
+                std::lock_guard<std::mutex> lock(_LazyMutex);
+                archive->addEntry(reader.getFileName());
+                _LazyArchive = archive;
+                _LazyEntry = reader.getFileName();
+                _LazyPending = true;
+                return;
+            }
+        }
+    }
 
-    // save the element map
-    auto elementMap = _Shape.resetElementMap();
-    auto hasher = _Shape.Hasher;
+    TopoDS_Shape shape;
+    bool direct = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+    if (!direct && !Base::FileInfo(reader.getFileName()).hasExtension("bin")) {
+        shape = loadFromFile(reader);
+    }
+    else {
+        auto iostate = reader.exceptions();
+        if (!loadFromStream(reader, shape))
+            Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
+        reader.exceptions(iostate);
+    }
+    setRestoredShape(shape);
+}
 
-    Base::FileInfo brep(reader.getFileName());
-    TopoShape shape;
+bool PropertyPartShape::canRestoreDocFileConcurrently() const
+{
+    // Lazily loaded shapes and shapes read through a temporary file are left
+    // to RestoreDocFile()
+    auto hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General");
+    return !hGrp->GetBool("LazyLoadShapes", false) && hGrp->GetBool("DirectAccess", true);
+}
 
-    // In LS3 the following statement is executed right before shape.Hasher = hasher;
-    // https://github.com/realthunder/FreeCAD/blob/a9810d509a6f112b5ac03d4d4831b67e6bffd5b7/src/Mod/Part/App/PropertyTopoShape.cpp#L639
-    // Now it's not possible anymore because both PropertyPartShape::loadFromFile() and
-    // PropertyPartShape::loadFromStream() calls PropertyPartShape::setValue() which clears the
-    // value of _Ver.
-    // Therefore we're storing the value of _Ver here so that we don't lose it.
+std::function<void()> PropertyPartShape::RestoreDocFileConcurrently(Base::Reader &reader)
+{
+    // Only the shape is decoded by the worker thread. As in RestoreDocFile() the
+    // element map and hasher restored in the meantime are kept when it's set.
+    auto shape = std::make_shared<TopoDS_Shape>();
+    bool failed = !loadFromStream(reader, *shape);
+
+    return [this, shape, failed, fileName = reader.getFileName()]() {
+        if (failed) {
+            Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+        }
+        setRestoredShape(*shape);
+    };
+}
 
-    std::string ver = _Ver;
+void PropertyPartShape::loadPendingShape() const
+{
+    if (!_LazyPending)
+        return;
 
-    if (brep.hasExtension("bin")) {
-        shape.importBinary(reader);
-    }
-    else {
-        bool direct = App::GetApplication().GetParameterGroupByPath
-            ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
-        if (!direct) {
-            loadFromFile(reader);
+    // The const getters may be called by several threads at once, e.g. by a
+    // parallel recompute. Only the first one reads the shape.
+    std::lock_guard<std::mutex> lock(_LazyMutex);
+    if (!_LazyPending)
+        return;
+
+    TopoShape shape;
+    try {
+        auto str = _LazyArchive->getInputStream(_LazyEntry);
+        if (!str) {
+            FC_THROWM(Base::FileException, "Shape file '" << _LazyEntry << "' is not available");
+        }
+        if (Base::FileInfo(_LazyEntry).hasExtension("bin")) {
+            shape.importBinary(*str);
         }
         else {
-            auto iostate = reader.exceptions();
-            loadFromStream(reader);
-            reader.exceptions(iostate);
+            shape.importBrep(*str);
         }
-        shape = getValue();
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().error("Failed to load shape of %s: %s\n", getFullName().c_str(), e.what());
+    }
+    catch (const Standard_Failure& e) {
+        Base::Console().error("Failed to load shape of %s: %s\n", getFullName().c_str(),
+            e.GetMessageString());
+    }
+    catch (const std::exception& e) {
+        Base::Console().error("Failed to load shape of %s: %s\n", getFullName().c_str(), e.what());
     }
 
-    // restore the element map
-    shape.Hasher = hasher;
-    shape.resetElementMap(elementMap);
-    setValue(shape);
-    _Ver = ver;
+    // Keep the tag, hasher and element map that have been restored meanwhile. No change
+    // is signaled because the value of the property is the same as after restoring.
+    _Shape.setShape(shape.getShape(), false);
+    if (!_Shape.Tag) {
+        if (auto parent = freecad_cast<App::DocumentObject*>(getContainer())) {
+            _Shape.Tag = parent->getID();
+        }
+    }
+    _LazyArchive.reset();
+    _LazyEntry.clear();
+    _LazyPending = false;
+}
+
+void PropertyPartShape::resetPendingShape()
+{
+    std::lock_guard<std::mutex> lock(_LazyMutex);
+    _LazyArchive.reset();
+    _LazyEntry.clear();
+    _LazyPending = false;
+}
+
+bool PropertyPartShape::isPendingFileCompatible(bool binary) const
+{
+    std::lock_guard<std::mutex> lock(_LazyMutex);
+    return _LazyPending && Base::FileInfo(_LazyEntry).hasExtension(binary ? "bin" : "brp");
 }
 
 // -------------------------------------------------------------------------
@@ -23,7 +23,10 @@
 #ifndef PART_PROPERTYTOPOSHAPE_H
 #define PART_PROPERTYTOPOSHAPE_H
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -36,6 +39,7 @@ namespace Part
 {
 
 class  Feature;
+class  ShapeArchive;
 /** The part shape property class.
  * @author Werner Mayer
  */
@@ -90,6 +94,8 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canRestoreDocFileConcurrently() const override;
+    std::function<void()> RestoreDocFileConcurrently(Base::Reader &reader) override;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
@@ -104,16 +110,44 @@ public:
 
     void afterRestore() override;
 
+    /// Returns true if the shape was restored lazily and hasn't been read yet
+    bool isLoadPending() const {
+        return _LazyPending;
+    }
+
     friend class Feature;
 
 private:
     void saveToFile(Base::Writer &writer) const;
-    void loadFromFile(Base::Reader &reader);
-    void loadFromStream(Base::Reader &reader);
+    /// Reads a BRep shape file through a temporary file
+    TopoDS_Shape loadFromFile(Base::Reader &reader);
+    /// Reads a binary or BRep shape file, returns false if it's invalid
+    static bool loadFromStream(Base::Reader &reader, TopoDS_Shape &shape);
+    /// Sets the shape of a shape file, keeping the element map restored before
+    void setRestoredShape(const TopoDS_Shape &shape);
+    /// Reads the shape from the document archive if its restore was deferred
+    void loadPendingShape() const;
+    /// Drops a deferred shape file, e.g. when a new value is set
+    void resetPendingShape();
+    /// Returns true if a deferred shape file can be saved as is in the given format
+    bool isPendingFileCompatible(bool binary) const;
+    /// Returns true if a shape is set or its restore was deferred
+    bool hasShape() const {
+        return _LazyPending || !_Shape.isNull();
+    }
+    /// Returns the file of an identical shape already written by \a writer
+    std::string findSharedFile(Base::Writer &writer, std::size_t key) const;
 
 private:
-    TopoShape _Shape;
+    mutable TopoShape _Shape;
     std::string _Ver;
+    /// Archive and entry name of a deferred shape file
+    mutable std::shared_ptr<ShapeArchive> _LazyArchive;
+    mutable std::string _LazyEntry;
+    mutable std::atomic<bool> _LazyPending {false};
+    mutable std::mutex _LazyMutex;
+    /// Property whose shape file is shared by this one while restoring
+    const PropertyPartShape* _SharedSource = nullptr;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
 };
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <memory>
 #endif
 
@@ -56,6 +57,11 @@ public:
                            &Module::show,
                            "show(points,[string]) -- Add the points to the active document or "
                            "create one if no document exists.  Returns document object.");
+        add_varargs_method("estimateNormals",
+                           &Module::estimateNormals,
+                           "estimateNormals(feature,[neighbours=10,orient=True]) -- Compute the "
+                           "normals of the points of the feature and store them in its Normal "
+                           "property.");
         initialize("This module is the Points module.");  // register with Python
     }
 
@@ -73,6 +79,16 @@ private:
 
         return std::make_tuple(useColor, checkState, minDistance);
     }
+    unsigned int readSubsampling() const
+    {
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication()
+                                                 .GetUserParameter()
+                                                 .GetGroup("BaseApp")
+                                                 ->GetGroup("Preferences")
+                                                 ->GetGroup("Mod/Points/Import");
+        // keep every n-th point of huge clouds, 1 reads all points
+        return static_cast<unsigned int>(std::max(hGrp->GetUnsigned("Subsampling", 1), 1UL));
+    }
     Py::Object open(const Py::Tuple& args)
     {
         char* Name {};
@@ -111,6 +127,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setSubsampling(readSubsampling());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().newDocument();
@@ -233,6 +250,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setSubsampling(readSubsampling());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().getDocument(DocName);
@@ -424,6 +442,38 @@ private:
 
         return Py::None();
     }
+
+    Py::Object estimateNormals(const Py::Tuple& args)
+    {
+        PyObject* pcObj {};
+        int neighbours = 10;
+        PyObject* orient = Py_True;
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "O!|iO!",
+                              &(App::DocumentObjectPy::Type),
+                              &pcObj,
+                              &neighbours,
+                              &PyBool_Type,
+                              &orient)) {
+            throw Py::Exception();
+        }
+
+        auto feature = dynamic_cast<Points::Feature*>(
+            static_cast<App::DocumentObjectPy*>(pcObj)->getDocumentObjectPtr());
+        if (!feature) {
+            throw Py::TypeError("expect a points feature");
+        }
+
+        try {
+            feature->estimateNormals(std::size_t(std::max(neighbours, 0)),
+                                     Base::asBoolean(orient));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
 };
 
 PyObject* initModule()
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#include <QtConcurrentMap>
+#endif
+
+#include <Base/Exception.h>
+
+#include "Downsampling.h"
+#include "Points.h"
+
+
+using namespace Points;
+
+namespace
+{
+/// Number of bits of the cell coordinate per axis in a cell key
+constexpr int KeyBits = 21;
+constexpr uint64_t KeyMask = (uint64_t(1) << KeyBits) - 1;
+
+using CellEntry = std::pair<uint64_t, uint32_t>;
+
+/**
+ * The valid points sorted into the cells of a regular grid. The entries hold the key of the cell
+ * and the index of the point and are sorted by the key and then by the index. As the x
+ * coordinate of a cell makes up the highest bits of the key the entries are split into slabs
+ * along the x axis that can be processed independently.
+ */
+struct CellGrid
+{
+    Base::Vector3f origin;
+    float size {1.0F};
+    std::vector<CellEntry> entries;
+    /// the slabs as ranges of entries
+    std::vector<std::pair<std::size_t, std::size_t>> slabs;
+
+    CellGrid(const std::vector<Base::Vector3f>& points, double cellSize)
+    {
+        if (!(cellSize > 0.0)) {
+            throw Base::ValueError("The cell size must be positive");
+        }
+        size = float(cellSize);
+
+        std::vector<uint32_t> valid;
+        valid.reserve(points.size());
+        Base::Vector3f minPnt(FLT_MAX, FLT_MAX, FLT_MAX);
+        Base::Vector3f maxPnt(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (std::size_t i = 0; i < points.size(); i++) {
+            const Base::Vector3f& pnt = points[i];
+            if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+                valid.push_back(uint32_t(i));
+                minPnt.Set(std::min(minPnt.x, pnt.x),
+                           std::min(minPnt.y, pnt.y),
+                           std::min(minPnt.z, pnt.z));
+                maxPnt.Set(std::max(maxPnt.x, pnt.x),
+                           std::max(maxPnt.y, pnt.y),
+                           std::max(maxPnt.z, pnt.z));
+            }
+        }
+        if (valid.empty()) {
+            return;
+        }
+
+        origin = minPnt;
+        Base::Vector3f extent = maxPnt - minPnt;
+        double maxCells = double(KeyMask);
+        if (extent.x / cellSize >= maxCells || extent.y / cellSize >= maxCells
+            || extent.z / cellSize >= maxCells) {
+            throw Base::ValueError("The cell size is too small for the extent of the points");
+        }
+
+        // distribute the points into the slabs and sort each of them
+        auto numCellsX = uint64_t(extent.x / size) + 1;
+        std::size_t numSlabs = std::min<uint64_t>(
+            4 * std::max(std::thread::hardware_concurrency(), 1U),
+            numCellsX);
+        auto slabOf = [&](const Base::Vector3f& pnt) {
+            return std::size_t(cell(pnt.x - origin.x) * numSlabs / numCellsX);
+        };
+
+        std::vector<std::size_t> offsets(numSlabs + 1, 0);
+        for (uint32_t index : valid) {
+            offsets[slabOf(points[index]) + 1]++;
+        }
+        for (std::size_t i = 0; i < numSlabs; i++) {
+            offsets[i + 1] += offsets[i];
+            slabs.emplace_back(offsets[i], offsets[i + 1]);
+        }
+        entries.resize(valid.size());
+        for (uint32_t index : valid) {
+            const Base::Vector3f& pnt = points[index];
+            entries[offsets[slabOf(pnt)]++] = CellEntry(key(pnt), index);
+        }
+        QtConcurrent::blockingMap(slabs, [this](const std::pair<std::size_t, std::size_t>& slab) {
+            std::sort(entries.begin() + std::ptrdiff_t(slab.first),
+                      entries.begin() + std::ptrdiff_t(slab.second));
+        });
+    }
+
+    uint64_t cell(float offset) const
+    {
+        return std::min(uint64_t(std::max(offset / size, 0.0F)), KeyMask);
+    }
+    uint64_t key(const Base::Vector3f& pnt) const
+    {
+        return (cell(pnt.x - origin.x) << (2 * KeyBits)) | (cell(pnt.y - origin.y) << KeyBits)
+            | cell(pnt.z - origin.z);
+    }
+    static std::array<uint64_t, 3> coords(uint64_t key)
+    {
+        return {key >> (2 * KeyBits), (key >> KeyBits) & KeyMask, key & KeyMask};
+    }
+};
+
+std::vector<std::size_t> sortedIndices(const std::vector<std::vector<uint32_t>>& lists)
+{
+    std::vector<std::size_t> indices;
+    for (const auto& list : lists) {
+        indices.insert(indices.end(), list.begin(), list.end());
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+}  // namespace
+
+std::vector<std::size_t> Downsampling::VoxelGrid(const PointKernel& kernel, double size)
+{
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+    CellGrid grid(points, size);
+
+    // the entries of a cell never span two slabs
+    std::vector<std::vector<uint32_t>> kept(grid.slabs.size());
+    std::vector<std::size_t> slabIndices(grid.slabs.size());
+    for (std::size_t i = 0; i < slabIndices.size(); i++) {
+        slabIndices[i] = i;
+    }
+    QtConcurrent::blockingMap(slabIndices, [&](std::size_t slab) {
+        std::size_t end = grid.slabs[slab].second;
+        for (std::size_t begin = grid.slabs[slab].first; begin < end;) {
+            std::size_t last = begin;
+            Base::Vector3d center;
+            for (; last < end && grid.entries[last].first == grid.entries[begin].first; last++) {
+                const Base::Vector3f& pnt = points[grid.entries[last].second];
+                center += Base::Vector3d(pnt.x, pnt.y, pnt.z);
+            }
+            center /= double(last - begin);
+
+            Base::Vector3f centerf(float(center.x), float(center.y), float(center.z));
+            uint32_t nearest = grid.entries[begin].second;
+            float minDist = FLT_MAX;
+            for (std::size_t i = begin; i < last; i++) {
+                float dist = Base::DistanceP2(points[grid.entries[i].second], centerf);
+                if (dist < minDist) {
+                    minDist = dist;
+                    nearest = grid.entries[i].second;
+                }
+            }
+            kept[slab].push_back(nearest);
+            begin = last;
+        }
+    });
+
+    return sortedIndices(kept);
+}
+
+std::vector<std::size_t> Downsampling::PoissonDisk(const PointKernel& kernel, double radius)
+{
+    struct Cell
+    {
+        uint64_t key;
+        std::size_t begin;
+        std::size_t end;
+        /// the kept points of a cell are moved to the beginning of its entries
+        std::size_t kept;
+    };
+
+    // with cells of the size of the radius only the adjacent cells need to be checked
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+    CellGrid grid(points, radius);
+    std::vector<Cell> cells;
+    for (std::size_t i = 0; i < grid.entries.size();) {
+        std::size_t last = i;
+        while (last < grid.entries.size() && grid.entries[last].first == grid.entries[i].first) {
+            last++;
+        }
+        cells.push_back({grid.entries[i].first, i, last, 0});
+        i = last;
+    }
+
+    // cells whose coordinates are equal modulo 3 have no adjacent cells in common and can be
+    // processed at the same time
+    std::array<std::vector<std::size_t>, 27> phases;
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        auto xyz = CellGrid::coords(cells[i].key);
+        phases[(xyz[0] % 3) * 9 + (xyz[1] % 3) * 3 + xyz[2] % 3].push_back(i);
+    }
+
+    auto sqrRadius = float(radius * radius);
+    auto processCell = [&](std::size_t index) {
+        Cell& cell = cells[index];
+        auto xyz = CellGrid::coords(cell.key);
+        std::vector<const Cell*> adjacent;
+        adjacent.reserve(26);
+        for (int i = 0; i < 27; i++) {
+            std::array<int64_t, 3> pos {int64_t(xyz[0]) + i / 9 - 1,
+                                        int64_t(xyz[1]) + (i / 3) % 3 - 1,
+                                        int64_t(xyz[2]) + i % 3 - 1};
+            if (i == 13 || std::any_of(pos.begin(), pos.end(), [](int64_t v) {
+                    return v < 0 || v > int64_t(KeyMask);
+                })) {
+                continue;
+            }
+            uint64_t key = (uint64_t(pos[0]) << (2 * KeyBits)) | (uint64_t(pos[1]) << KeyBits)
+                | uint64_t(pos[2]);
+            auto it = std::lower_bound(cells.begin(),
+                                       cells.end(),
+                                       key,
+                                       [](const Cell& c, uint64_t k) {
+                                           return c.key < k;
+                                       });
+            if (it != cells.end() && it->key == key) {
+                adjacent.push_back(&*it);
+            }
+        }
+
+        auto isFree = [&](const Base::Vector3f& pnt, const Cell& other) {
+            for (std::size_t i = other.begin; i < other.begin + other.kept; i++) {
+                if (Base::DistanceP2(pnt, points[grid.entries[i].second]) < sqrRadius) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        for (std::size_t i = cell.begin; i < cell.end; i++) {
+            const Base::Vector3f& pnt = points[grid.entries[i].second];
+            if (isFree(pnt, cell)
+                && std::all_of(adjacent.begin(), adjacent.end(), [&](const Cell* other) {
+                       return isFree(pnt, *other);
+                   })) {
+                std::swap(grid.entries[i], grid.entries[cell.begin + cell.kept]);
+                cell.kept++;
+            }
+        }
+    };
+
+    for (auto& phase : phases) {
+        QtConcurrent::blockingMap(phase, processCell);
+    }
+
+    std::vector<std::vector<uint32_t>> kept(1);
+    for (const auto& cell : cells) {
+        for (std::size_t i = cell.begin; i < cell.begin + cell.kept; i++) {
+            kept.front().push_back(grid.entries[i].second);
+        }
+    }
+    return sortedIndices(kept);
+}
+
+PointKernel Downsampling::Extract(const PointKernel& kernel,
+                                  const std::vector<std::size_t>& indices)
+{
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+    std::vector<Base::Vector3f> kept;
+    kept.reserve(indices.size());
+    for (std::size_t index : indices) {
+        kept.push_back(points.at(index));
+    }
+
+    PointKernel result;
+    result.setTransform(kernel.getTransform());
+    result.swap(kept);
+    return result;
+}
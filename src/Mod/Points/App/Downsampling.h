@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef POINTS_DOWNSAMPLING_H
+#define POINTS_DOWNSAMPLING_H
+
+#include <vector>
+
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+
+/**
+ * The Downsampling class reduces the density of a point cloud. The methods return the indices
+ * of the kept points in increasing order so that the properties of the points can be reduced
+ * alike. Invalid points are always dropped. The work is done in parallel.
+ */
+class PointsExport Downsampling
+{
+public:
+    /** Divides the bounding box of the points into cubes of the given \a size and keeps of
+     * each occupied cube the point closest to the centre of gravity of its points.
+     */
+    static std::vector<std::size_t> VoxelGrid(const PointKernel& kernel, double size);
+    /** Keeps a subset of the points so that no two kept points are closer than \a radius and
+     * each dropped point is closer than \a radius to a kept one. The result doesn't depend on
+     * the number of threads.
+     */
+    static std::vector<std::size_t> PoissonDisk(const PointKernel& kernel, double radius);
+    /** Returns the points of \a kernel at the given \a indices, e.g. the result of one of the
+     * methods above. The placement of the kernel is kept.
+     */
+    static PointKernel Extract(const PointKernel& kernel, const std::vector<std::size_t>& indices);
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_DOWNSAMPLING_H
@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+#include <Eigen/Eigenvalues>
+#endif
+
+#include "NormalEstimation.h"
+#include "Points.h"
+#include "PointsKdTree.h"
+#include "Properties.h"
+
+
+using namespace Points;
+
+namespace
+{
+bool isValid(const Base::Vector3f& pnt)
+{
+    return !std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z);
+}
+
+/**
+ * An approximate priority queue of the edges to propagate the orientation along. The edges are
+ * sorted into buckets by their weight between 0 and 1, within a bucket the last edge comes first.
+ */
+class EdgeQueue
+{
+public:
+    using Edge = std::pair<uint32_t, uint32_t>;
+
+    void push(float weight, const Edge& edge)
+    {
+        std::size_t index = std::min(std::size_t(weight * float(NumBuckets)), NumBuckets - 1);
+        buckets[index].push_back(edge);
+        lowest = std::min(lowest, index);
+    }
+    bool pop(Edge& edge)
+    {
+        while (lowest < NumBuckets && buckets[lowest].empty()) {
+            lowest++;
+        }
+        if (lowest == NumBuckets) {
+            return false;
+        }
+        edge = buckets[lowest].back();
+        buckets[lowest].pop_back();
+        return true;
+    }
+
+private:
+    static constexpr std::size_t NumBuckets = 32;
+    std::array<std::vector<Edge>, NumBuckets> buckets;
+    std::size_t lowest {NumBuckets};
+};
+
+/**
+ * Makes the neighbourhood graph with \a degree neighbours per point symmetric, so a point is
+ * adjacent to its neighbours and to the points it is a neighbour of. The adjacent points of the
+ * point i are stored from adjacent[offsets[i]] to adjacent[offsets[i + 1] - 1].
+ */
+void symmetrize(const std::vector<uint32_t>& graph,
+                std::size_t degree,
+                std::vector<std::size_t>& offsets,
+                std::vector<uint32_t>& adjacent)
+{
+    std::size_t numPoints = degree > 0 ? graph.size() / degree : 0;
+    auto forEachEdge = [&](auto func) {
+        for (std::size_t i = 0; i < graph.size(); i++) {
+            if (graph[i] != PointsKdTree::InvalidIndex) {
+                func(uint32_t(i / degree), graph[i]);
+            }
+        }
+    };
+
+    offsets.assign(numPoints + 1, 0);
+    forEachEdge([&](uint32_t from, uint32_t to) {
+        offsets[from + 1]++;
+        offsets[to + 1]++;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    adjacent.resize(offsets[numPoints]);
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    forEachEdge([&](uint32_t from, uint32_t to) {
+        adjacent[pos[from]++] = to;
+        adjacent[pos[to]++] = from;
+    });
+
+    // mutual neighbours are stored twice
+    std::size_t first = 0;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < numPoints; i++) {
+        std::size_t last = offsets[i + 1];
+        auto begin = adjacent.begin() + std::ptrdiff_t(first);
+        auto end = adjacent.begin() + std::ptrdiff_t(last);
+        std::sort(begin, end);
+        end = std::unique(begin, end);
+        if (count != first) {
+            std::copy(begin, end, adjacent.begin() + std::ptrdiff_t(count));
+        }
+        count += std::size_t(end - begin);
+        offsets[i + 1] = count;
+        first = last;
+    }
+    adjacent.resize(count);
+}
+}  // namespace
+
+NormalEstimation::NormalEstimation(const PointKernel& kernel)
+    : kernel(kernel)
+{}
+
+void NormalEstimation::SetNeighbours(std::size_t num)
+{
+    neighbours = num;
+}
+
+void NormalEstimation::SetOrientation(bool on)
+{
+    orientation = on;
+}
+
+std::vector<Base::Vector3f> NormalEstimation::Perform() const
+{
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+    std::vector<Base::Vector3f> normals(points.size(), Base::Vector3f(0.0F, 0.0F, 0.0F));
+
+    // at least three points are needed to fit a plane
+    std::shared_ptr<const PointsKdTree> kdTree = kernel.getKdTree();
+    const PointsKdTree& tree = *kdTree;
+    std::size_t num = std::min(neighbours, tree.Size());
+    if (num < 3) {
+        return normals;
+    }
+
+    // the neighbours of each point without the point itself
+    std::size_t degree = num - 1;
+    std::vector<uint32_t> graph;
+    if (orientation) {
+        graph.assign(points.size() * degree, PointsKdTree::InvalidIndex);
+    }
+
+    using Neighbours = std::vector<PointsKdTree::Neighbour>;
+    tree.ForEachNearest(num, [&](uint32_t index, const Neighbours& result) {
+        Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+        for (const auto& it : result) {
+            const Base::Vector3f& pnt = points[it.index];
+            mean += Eigen::Vector3d(pnt.x, pnt.y, pnt.z);
+        }
+        mean /= double(result.size());
+
+        Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+        for (const auto& it : result) {
+            const Base::Vector3f& pnt = points[it.index];
+            Eigen::Vector3d diff = Eigen::Vector3d(pnt.x, pnt.y, pnt.z) - mean;
+            cov += diff * diff.transpose();
+        }
+
+        // the eigenvalues are sorted in increasing order
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        solver.computeDirect(cov);
+        Eigen::Vector3d normal = solver.eigenvectors().col(0);
+        normals[index].Set(float(normal.x()), float(normal.y()), float(normal.z()));
+
+        if (!graph.empty()) {
+            uint32_t* adjacent = graph.data() + std::size_t(index) * degree;
+            for (const auto& it : result) {
+                if (it.index != index && adjacent < graph.data() + (index + 1) * degree) {
+                    *adjacent++ = it.index;
+                }
+            }
+        }
+    });
+
+    if (orientation) {
+        std::vector<std::size_t> offsets;
+        std::vector<uint32_t> adjacent;
+        symmetrize(graph, degree, offsets, adjacent);
+        std::vector<uint32_t>().swap(graph);
+        orient(normals, offsets, adjacent);
+    }
+
+    return normals;
+}
+
+void NormalEstimation::Perform(PropertyNormalList& normals) const
+{
+    normals.setValues(Perform());
+}
+
+void NormalEstimation::orient(std::vector<Base::Vector3f>& normals,
+                              const std::vector<std::size_t>& offsets,
+                              const std::vector<uint32_t>& adjacent) const
+{
+    // the orientation is passed on within the connected parts of the neighbourhood graph
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+    std::vector<uint32_t> parts(points.size(), PointsKdTree::InvalidIndex);
+    uint32_t numParts = 0;
+
+    EdgeQueue queue;
+    auto visit = [&](uint32_t index) {
+        parts[index] = numParts;
+        for (std::size_t i = offsets[index]; i < offsets[index + 1]; i++) {
+            uint32_t next = adjacent[i];
+            if (parts[next] == PointsKdTree::InvalidIndex) {
+                float weight = 1.0F - std::fabs(normals[index] * normals[next]);
+                queue.push(weight, {index, next});
+            }
+        }
+    };
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (parts[i] != PointsKdTree::InvalidIndex || !isValid(points[i])) {
+            continue;
+        }
+        visit(uint32_t(i));
+        EdgeQueue::Edge edge;
+        while (queue.pop(edge)) {
+            if (parts[edge.second] != PointsKdTree::InvalidIndex) {
+                continue;
+            }
+            if (normals[edge.first] * normals[edge.second] < 0.0F) {
+                normals[edge.second] = -normals[edge.second];
+            }
+            visit(edge.second);
+        }
+        numParts++;
+    }
+
+    // the normal of the outermost point of a part is expected to point away from its centre
+    std::vector<Base::Vector3d> centers(numParts);
+    std::vector<std::size_t> counts(numParts, 0);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (parts[i] != PointsKdTree::InvalidIndex) {
+            centers[parts[i]] += Base::Vector3d(points[i].x, points[i].y, points[i].z);
+            counts[parts[i]]++;
+        }
+    }
+    std::vector<uint32_t> outermost(numParts, 0);
+    std::vector<double> maxDist(numParts, -1.0);
+    for (uint32_t part = 0; part < numParts; part++) {
+        centers[part] /= double(counts[part]);
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+        uint32_t part = parts[i];
+        if (part != PointsKdTree::InvalidIndex) {
+            Base::Vector3d pnt(points[i].x, points[i].y, points[i].z);
+            double dist = Base::DistanceP2(pnt, centers[part]);
+            if (dist > maxDist[part]) {
+                maxDist[part] = dist;
+                outermost[part] = uint32_t(i);
+            }
+        }
+    }
+
+    std::vector<bool> flip(numParts, false);
+    for (uint32_t part = 0; part < numParts; part++) {
+        const Base::Vector3f& pnt = points[outermost[part]];
+        Base::Vector3d dir = Base::Vector3d(pnt.x, pnt.y, pnt.z) - centers[part];
+        const Base::Vector3f& normal = normals[outermost[part]];
+        flip[part] = Base::Vector3d(normal.x, normal.y, normal.z) * dir < 0.0;
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (parts[i] != PointsKdTree::InvalidIndex && flip[parts[i]]) {
+            normals[i] = -normals[i];
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef POINTS_NORMALESTIMATION_H
+#define POINTS_NORMALESTIMATION_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+class PropertyNormalList;
+
+/**
+ * The NormalEstimation class computes the normals of a point cloud without any mesh. The normal
+ * of a point is the normal of the plane fitted to its nearest neighbours, i.e. the eigenvector
+ * of the smallest eigenvalue of their covariance matrix. The planes are fitted in parallel.
+ *
+ * As a fitted plane doesn't define the side of the normal the normals can be oriented
+ * consistently afterwards. Within each connected part of the symmetric neighbourhood graph the
+ * orientation is passed on from point to point, preferring the neighbours with the most parallel
+ * normals. Then all normals of a part are flipped if the normal of its point farthest from the
+ * centre of the part points inwards.
+ */
+class PointsExport NormalEstimation
+{
+public:
+    explicit NormalEstimation(const PointKernel& kernel);
+
+    /// Sets the number of neighbours of a point including itself, the default is 10.
+    void SetNeighbours(std::size_t num);
+    /// Enables the consistent orientation of the normals, it's enabled by default.
+    void SetOrientation(bool on);
+
+    /** Returns the normal of each point in the local coordinate system of the kernel. Invalid
+     * points get a null vector.
+     */
+    std::vector<Base::Vector3f> Perform() const;
+    /// Stores the normals in \a normals, e.g. the normal property of a points feature.
+    void Perform(PropertyNormalList& normals) const;
+
+private:
+    void orient(std::vector<Base::Vector3f>& normals,
+                const std::vector<std::size_t>& offsets,
+                const std::vector<uint32_t>& adjacent) const;
+
+private:
+    const PointKernel& kernel;
+    std::size_t neighbours {10};
+    bool orientation {true};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_NORMALESTIMATION_H
@@ -34,6 +34,7 @@
 
 #include "Points.h"
 #include "PointsAlgos.h"
+#include "PointsKdTree.h"
 
 
 #ifdef _MSC_VER
@@ -48,11 +49,13 @@ TYPESYSTEM_SOURCE(Points::PointKernel, Data::ComplexGeoData)
 PointKernel::PointKernel(const PointKernel& pts)
     : _Mtrx(pts._Mtrx)
     , _Points(pts._Points)
+    , _KdTree(pts._KdTree)
 {}
 
 PointKernel::PointKernel(PointKernel&& pts) noexcept
     : _Mtrx(pts._Mtrx)
     , _Points(std::move(pts._Points))
+    , _KdTree(std::move(pts._KdTree))
 {}
 
 std::vector<const char*> PointKernel::getElementTypes() const
@@ -132,6 +135,7 @@ PointKernel& PointKernel::operator=(const PointKernel& Kernel)
         // copy the mesh structure
         setTransform(Kernel._Mtrx);
         this->_Points = Kernel._Points;
+        this->_KdTree = Kernel._KdTree;
     }
 
     return *this;
@@ -143,11 +147,21 @@ PointKernel& PointKernel::operator=(PointKernel&& Kernel) noexcept
         // copy the mesh structure
         setTransform(Kernel._Mtrx);
         this->_Points = std::move(Kernel._Points);
+        this->_KdTree = std::move(Kernel._KdTree);
     }
 
     return *this;
 }
 
+std::shared_ptr<const PointsKdTree> PointKernel::getKdTree() const
+{
+    std::lock_guard<std::mutex> lock(_KdTreeMutex);
+    if (!_KdTree) {
+        _KdTree = std::make_shared<const PointsKdTree>(*this);
+    }
+    return _KdTree;
+}
+
 unsigned int PointKernel::getMemSize() const
 {
     return _Points.size() * sizeof(value_type);
@@ -220,6 +234,7 @@ void PointKernel::RestoreDocFile(Base::Reader& reader)
     Base::InputStream str(reader);
     uint32_t uCt = 0;
     str >> uCt;
+    _KdTree.reset();
     _Points.resize(uCt);
     for (unsigned long i = 0; i < uCt; i++) {
         float x {};
@@ -25,6 +25,8 @@
 #define POINTS_POINT_H
 
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <App/ComplexGeoData.h>
@@ -39,6 +41,7 @@
 
 namespace Points
 {
+class PointsKdTree;
 
 /** Point kernel
  */
@@ -86,6 +89,8 @@ public:
     }
     std::vector<value_type>& getBasicPoints()
     {
+        // the caller may modify the points
+        _KdTree.reset();
         return this->_Points;
     }
     const std::vector<value_type>& getBasicPoints() const
@@ -94,12 +99,18 @@ public:
     }
     void setBasicPoints(const std::vector<value_type>& pts)
     {
+        _KdTree.reset();
         this->_Points = pts;
     }
     void swap(std::vector<value_type>& pts)
     {
+        _KdTree.reset();
         this->_Points.swap(pts);
     }
+    /** Returns the kd-tree of the points. It is built on the first call and shared until the
+     * points are modified, the placement is ignored like in PointsKdTree.
+     */
+    std::shared_ptr<const PointsKdTree> getKdTree() const;
 
     void getPoints(std::vector<Base::Vector3d>& Points,
                    std::vector<Base::Vector3d>& Normals,
@@ -116,6 +127,10 @@ public:
     void SaveDocFile(Base::Writer& writer) const override;
     void Restore(Base::XMLReader& reader) override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
     void save(const char* file) const;
     void save(std::ostream&) const;
     void load(const char* file);
@@ -125,6 +140,8 @@ public:
 private:
     Base::Matrix4D _Mtrx;
     std::vector<value_type> _Points;
+    mutable std::shared_ptr<const PointsKdTree> _KdTree;
+    mutable std::mutex _KdTreeMutex;
 
 public:
     /// number of points stored
@@ -136,6 +153,7 @@ public:
     std::vector<value_type> getValidPoints() const;
     void resize(size_type n)
     {
+        _KdTree.reset();
         _Points.resize(n);
     }
     void reserve(size_type n)
@@ -144,11 +162,13 @@ public:
     }
     inline void erase(size_type first, size_type last)
     {
+        _KdTree.reset();
         _Points.erase(_Points.begin() + first, _Points.begin() + last);
     }
 
     void clear()
     {
+        _KdTree.reset();
         _Points.clear();
     }
 
@@ -161,11 +181,13 @@ public:
     /// set the points
     inline void setPoint(const int idx, const Base::Vector3d& point)
     {
+        _KdTree.reset();
         _Points[idx] = transformPointToInside(point);
     }
     /// insert the points
     inline void push_back(const Base::Vector3d& point)
     {
+        _KdTree.reset();
         _Points.push_back(transformPointToInside(point));
     }
 
@@ -25,13 +25,21 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <sstream>
+#include <string_view>
+#include <thread>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
-#include <boost/regex.hpp>
+#include <boost/spirit/include/qi.hpp>
+#include <Eigen/Core>
+#include <QFile>
+#include <QtConcurrentMap>
 #endif
 
 #include <Base/Console.h>
@@ -42,6 +50,7 @@
 #include <Base/Stream.h>
 
 #include "PointsAlgos.h"
+#include "PointsKdTree.h"
 #include <E57Format.h>
 
 
@@ -64,62 +73,229 @@ void PointsAlgos::Load(PointKernel& points, const char* FileName)
     }
 }
 
-void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+namespace
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                    "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    // boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    // boost::regex
-    // rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt = 0;
-    std::string line;
-    Base::FileInfo fi(FileName);
+/**
+ * Parses a number at the start of [\a pos, \a end) independent of the locale. Returns the
+ * end of the number or nullptr if there is no number.
+ */
+const char* parseNumber(const char* pos, const char* end, double& value)
+{
+    // std::from_chars for floating point numbers isn't available with all standard libraries
+    if (!boost::spirit::qi::parse(pos, end, boost::spirit::qi::double_, value)) {
+        return nullptr;
+    }
+    return pos;
+}
 
-    Base::ifstream tmp_str(fi, std::ios::in);
+/**
+ * A piece of complete lines of an ASCII point file and the points parsed from it.
+ */
+struct AsciiRange
+{
+    const char* begin {nullptr};
+    const char* end {nullptr};
+    std::vector<Base::Vector3f> points;
+};
+
+bool isAsciiSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == ';';
+}
+
+/**
+ * Parses the lines of \a range. A line gives a point if it starts with three numbers, further
+ * columns are ignored. All other lines like comments or headers are skipped. The parsing doesn't
+ * depend on the locale. If \a transform is true the points are multiplied with \a mat.
+ */
+void parseAsciiRange(AsciiRange& range, const Base::Matrix4D& mat, bool transform)
+{
+    range.points.clear();
+    const char* pos = range.begin;
+    const char* end = range.end;
+    while (pos < end) {
+        const char* eol = std::find(pos, end, '\n');
+        std::array<double, 3> xyz {};
+        std::size_t count = 0;
+        while (count < xyz.size()) {
+            while (pos < eol && isAsciiSeparator(*pos)) {
+                ++pos;
+            }
+            const char* ptr = parseNumber(pos, eol, xyz[count]);
+            if (!ptr || (ptr < eol && !isAsciiSeparator(*ptr))) {
+                break;
+            }
+            pos = ptr;
+            count++;
+        }
+        if (count == xyz.size()) {
+            Base::Vector3d pnt(xyz[0], xyz[1], xyz[2]);
+            if (transform) {
+                pnt = mat * pnt;
+            }
+            range.points.emplace_back(static_cast<float>(pnt.x),
+                                      static_cast<float>(pnt.y),
+                                      static_cast<float>(pnt.z));
+        }
+        pos = eol + 1;
+    }
+}
 
-    // estimating size
-    while (std::getline(tmp_str, line)) {
-        LineCnt++;
+/**
+ * Splits \a size bytes of \a data into the ranges so that each of them ends with a newline.
+ */
+void splitAsciiRanges(const char* data, std::size_t size, std::vector<AsciiRange>& ranges)
+{
+    const char* end = data + size;
+    const char* pos = data;
+    std::size_t num = ranges.size();
+    for (std::size_t i = 0; i < num; i++) {
+        ranges[i].begin = pos;
+        if (i + 1 < num) {
+            const char* next = std::max(pos, data + (i + 1) * size / num);
+            next = std::find(next, end, '\n');
+            pos = next < end ? next + 1 : end;
+        }
+        else {
+            pos = end;
+        }
+        ranges[i].end = pos;
     }
+}
+}  // namespace
 
-    // resize the PointKernel
-    points.resize(LineCnt);
+void PointsAlgos::LoadAscii(PointKernel& points, const char* FileName)
+{
+    constexpr qint64 minRangeSize = 1 << 20;
+    constexpr qint64 maxRangeSize = 1 << 24;
+    // the memory of a window doesn't grow with the number of threads
+    constexpr qint64 maxWindowSize = 1 << 26;
 
-    Base::SequencerLauncher seq("Loading points…", LineCnt);
+    Base::FileInfo fi(FileName);
+    QFile file(QString::fromUtf8(fi.filePath().c_str()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw Base::FileException("File to load not existing or not readable", FileName);
+    }
 
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+    // like setPoint() the points are transformed with the inverse placement of the kernel
+    Base::Matrix4D mat = points.getTransform();
+    bool transform = !mat.isUnity();
+    mat.inverse();
+
+    // the file is mapped window by window, each window is split into one range per task
+    qint64 fileSize = file.size();
+    std::size_t numRanges = 4 * std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<AsciiRange> ranges(numRanges);
+    qint64 rangeSize = std::clamp(fileSize / qint64(numRanges) + 1, minRangeSize, maxRangeSize);
+    qint64 windowSize = std::min(rangeSize * qint64(numRanges), maxWindowSize);
+
+    std::vector<Base::Vector3f> result;
+    std::vector<char> buffer;
+    Base::SequencerLauncher seq("Loading points…", std::size_t(fileSize / windowSize + 1));
+
+    qint64 offset = 0;
+    qint64 lineWindowSize = windowSize;
+    while (offset < fileSize) {
+        qint64 length = std::min(lineWindowSize, fileSize - offset);
+        uchar* mapped = file.map(offset, length);
+        const char* data = reinterpret_cast<const char*>(mapped);  // NOLINT
+        if (!mapped) {
+            // e.g. files on devices that cannot be mapped
+            buffer.resize(std::size_t(length));
+            if (!file.seek(offset) || file.read(buffer.data(), length) != length) {
+                throw Base::FileException("Failed to read file", FileName);
+            }
+            data = buffer.data();
+        }
+
+        // the window ends with the last complete line
+        qint64 used = length;
+        if (offset + length < fileSize) {
+            std::string_view view(data, std::size_t(length));
+            std::size_t eol = view.rfind('\n');
+            if (eol == std::string_view::npos) {
+                // a line longer than the window, only this window is enlarged
+                if (mapped) {
+                    file.unmap(mapped);
+                }
+                lineWindowSize *= 2;
+                continue;
+            }
+            used = qint64(eol) + 1;
+        }
 
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
+        splitAsciiRanges(data, std::size_t(used), ranges);
+        QtConcurrent::blockingMap(ranges, [&mat, transform](AsciiRange& range) {
+            parseAsciiRange(range, mat, transform);
+        });
 
-                points.setPoint(LineCnt, pt);
-                seq.next();
-                LineCnt++;
+        for (auto& range : ranges) {
+            if (result.empty() && !range.points.empty() && offset + used < fileSize) {
+                // estimate the number of points from the average line length
+                auto bytes = std::size_t(range.end - range.begin);
+                auto estimate = double(fileSize) * double(range.points.size()) / double(bytes);
+                result.reserve(std::size_t(estimate * 1.05));
             }
+            result.insert(result.end(), range.points.begin(), range.points.end());
         }
+
+        if (mapped) {
+            file.unmap(mapped);
+        }
+        if (lineWindowSize > windowSize) {
+            lineWindowSize = windowSize;
+            std::vector<char>().swap(buffer);
+        }
+        offset += used;
+        seq.next();
     }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
+
+    points.swap(result);
+}
+
+std::vector<std::size_t>
+PointsAlgos::FindOutliers(const PointKernel& points, std::size_t neighbours, double deviation)
+{
+    // the nearest neighbour of a point is the point itself
+    std::shared_ptr<const PointsKdTree> kdTree = points.getKdTree();
+    const PointsKdTree& tree = *kdTree;
+    std::size_t num = std::min(neighbours + 1, tree.Size());
+    if (num < 2) {
+        return {};
+    }
+    std::vector<PointsKdTree::Neighbour> result;
+    tree.FindNearest(num, result);
+
+    std::vector<double> meanDist(points.size(), -1.0);
+    double sum = 0.0;
+    double sumSqr = 0.0;
+    for (std::size_t i = 0; i < meanDist.size(); i++) {
+        const PointsKdTree::Neighbour* nb = result.data() + i * num;
+        if (nb->index == PointsKdTree::InvalidIndex) {
+            continue;
+        }
+        double dist = 0.0;
+        for (std::size_t j = 1; j < num; j++) {
+            dist += std::sqrt(double(nb[j].sqrDistance));
+        }
+        dist /= double(num - 1);
+        meanDist[i] = dist;
+        sum += dist;
+        sumSqr += dist * dist;
     }
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size()) {
-        points.erase(LineCnt, points.size());
+    auto count = double(tree.Size());
+    double mean = sum / count;
+    double stdDev = std::sqrt(std::max(sumSqr / count - mean * mean, 0.0));
+    double limit = mean + deviation * stdDev;
+
+    std::vector<std::size_t> outliers;
+    for (std::size_t i = 0; i < meanDist.size(); i++) {
+        if (meanDist[i] > limit) {
+            outliers.push_back(i);
+        }
     }
+    return outliers;
 }
 
 // ----------------------------------------------------------------------------
@@ -130,6 +306,7 @@ Reader::~Reader() = default;
 
 void Reader::clear()
 {
+    points.clear();
     intensity.clear();
     colors.clear();
     normals.clear();
@@ -190,6 +367,16 @@ int Reader::getHeight() const
     return height;
 }
 
+void Reader::setSubsampling(unsigned int step)
+{
+    subsampling = std::max(step, 1U);
+}
+
+unsigned int Reader::getSubsampling() const
+{
+    return subsampling;
+}
+
 // ----------------------------------------------------------------------------
 
 AscReader::AscReader() = default;
@@ -197,6 +384,15 @@ AscReader::AscReader() = default;
 void AscReader::read(const std::string& filename)
 {
     points.load(filename.c_str());
+    if (subsampling > 1) {
+        const std::vector<PointKernel::value_type>& all = points.getBasicPoints();
+        std::vector<PointKernel::value_type> kept;
+        kept.reserve(all.size() / subsampling + 1);
+        for (std::size_t i = 0; i < all.size(); i += subsampling) {
+            kept.push_back(all[i]);
+        }
+        points.setBasicPoints(kept);
+    }
     this->height = 1;
     this->width = points.size();
 }
@@ -246,90 +442,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -543,180 +655,624 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
-PlyReader::PlyReader() = default;
+namespace
+{
+/// Types of the numbers of the binary formats
+enum class NumberType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
 
-void PlyReader::read(const std::string& filename)
+struct Field
 {
-    clear();
+    NumberType type;
+    std::size_t size;
+    /// position of the value in its record
+    std::size_t offset;
+};
 
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+/// Size of the buffers used to read the records chunk by chunk
+constexpr std::size_t ChunkSize = 1 << 20;
 
-    std::string format;
-    std::vector<std::string> fields;
-    std::vector<std::string> types;
-    std::vector<int> sizes;
-    std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
+template<typename T>
+double decodeNumber(const char* data, bool swapByteOrder)
+{
+    std::array<char, sizeof(T)> bytes {};
+    if (swapByteOrder) {
+        std::reverse_copy(data, data + sizeof(T), bytes.begin());
+    }
+    else {
+        std::copy(data, data + sizeof(T), bytes.begin());
+    }
+    T value {};
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return static_cast<double>(value);
+}
 
-    this->width = numPoints;
-    this->height = 1;
+double decodeNumber(const char* data, NumberType type, bool swapByteOrder)
+{
+    switch (type) {
+        case NumberType::Int8:
+            return decodeNumber<int8_t>(data, swapByteOrder);
+        case NumberType::UInt8:
+            return decodeNumber<uint8_t>(data, swapByteOrder);
+        case NumberType::Int16:
+            return decodeNumber<int16_t>(data, swapByteOrder);
+        case NumberType::UInt16:
+            return decodeNumber<uint16_t>(data, swapByteOrder);
+        case NumberType::Int32:
+            return decodeNumber<int32_t>(data, swapByteOrder);
+        case NumberType::UInt32:
+            return decodeNumber<uint32_t>(data, swapByteOrder);
+        case NumberType::Float32:
+            return decodeNumber<float>(data, swapByteOrder);
+        case NumberType::Float64:
+            return decodeNumber<double>(data, swapByteOrder);
+    }
+    return 0.0;
+}
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
+/**
+ * The RecordSink class takes the decoded records of a file one by one and appends the known
+ * properties directly to the storage of the reader. Skipped records are not decoded at all.
+ */
+class RecordSink
+{
+public:
+    enum class ColorType
+    {
+        None,
+        /// separate red, green, blue and alpha values in the range [0, 255]
+        UChar,
+        /// separate red, green, blue and alpha values in the range [0, 1]
+        Float,
+        /// a single ARGB value stored as integer
+        Packed,
+        /// a single ARGB value whose bits are stored as float
+        PackedFloat
+    };
+
+    RecordSink(PointKernel& points,
+               std::vector<Base::Vector3f>& normals,
+               std::vector<float>& intensity,
+               std::vector<Base::Color>& colors,
+               unsigned int step)
+        : points(points)
+        , normals(normals)
+        , intensity(intensity)
+        , colors(colors)
+        , step(std::max(step, 1U))
+    {}
+
+    void setFields(const std::vector<std::string>& fields)
+    {
+        auto find = [&fields](const char* name, const char* alias = nullptr) {
+            auto it = std::ranges::find(fields, name);
+            if (it == fields.end() && alias) {
+                it = std::ranges::find(fields, alias);
+            }
+            return it != fields.end() ? std::size_t(it - fields.begin()) : none;
+        };
+
+        x = find("x");
+        y = find("y");
+        z = find("z");
+        normalX = find("normal_x", "nx");
+        normalY = find("normal_y", "ny");
+        normalZ = find("normal_z", "nz");
+        grey = find("intensity");
+        red = find("red");
+        green = find("green");
+        blue = find("blue");
+        alpha = find("alpha");
+        packed = find("rgb", "rgba");
+    }
+
+    /// Returns the index of the packed color field.
+    std::size_t getPackedColor() const
+    {
+        return packed;
     }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
+    /// Returns the index of the red color field.
+    std::size_t getRedColor() const
+    {
+        return red;
     }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
+    void setColorType(ColorType type)
+    {
+        colorType = type;
     }
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
+    /// Reserves the storage for the expected number of records.
+    void reserve(std::size_t records)
+    {
+        if (!hasData()) {
+            return;
+        }
+        std::size_t count = (records + step - 1) / step;
+        points.reserve(count);
+        if (hasNormals()) {
+            normals.reserve(count);
+        }
+        if (hasIntensity()) {
+            intensity.reserve(count);
+        }
+        if (hasColors()) {
+            colors.reserve(count);
+        }
     }
 
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
+    /// Moves to the next record and returns true if it's going to be kept.
+    bool next()
+    {
+        return (record++ % step) == 0;
     }
 
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
+    /// Appends the properties of the record whose field values are \a row.
+    void add(const double* row)
+    {
+        if (!hasData()) {
+            return;
+        }
 
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
+        points.push_back(Base::Vector3d(row[x], row[y], row[z]));
+        if (hasNormals()) {
+            normals.emplace_back(float(row[normalX]), float(row[normalY]), float(row[normalZ]));
+        }
+        if (hasIntensity()) {
+            intensity.push_back(static_cast<float>(row[grey]));
+        }
+        if (hasColors()) {
+            colors.push_back(getColor(row));
+        }
     }
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
+private:
+    bool hasData() const
+    {
+        return x != none && y != none && z != none;
     }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
+    bool hasNormals() const
+    {
+        return normalX != none && normalY != none && normalZ != none;
     }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
+    bool hasIntensity() const
+    {
+        return grey != none;
     }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
+    bool hasColors() const
+    {
+        switch (colorType) {
+            case ColorType::UChar:
+            case ColorType::Float:
+                return red != none && green != none && blue != none;
+            case ColorType::Packed:
+            case ColorType::PackedFloat:
+                return packed != none;
+            default:
+                return false;
+        }
     }
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    Base::Color getColor(const double* row) const
+    {
+        Base::Color col;
+        switch (colorType) {
+            case ColorType::UChar: {
+                float a = alpha != none ? static_cast<float>(row[alpha]) : 1.0F;
+                col.set(static_cast<float>(row[red]) / 255.0F,
+                        static_cast<float>(row[green]) / 255.0F,
+                        static_cast<float>(row[blue]) / 255.0F,
+                        a / 255.0F);
+            } break;
+            case ColorType::Float: {
+                float a = alpha != none ? static_cast<float>(row[alpha]) : 1.0F;
+                col.set(static_cast<float>(row[red]),
+                        static_cast<float>(row[green]),
+                        static_cast<float>(row[blue]),
+                        a);
+            } break;
+            case ColorType::Packed:
+                col.setPackedARGB(static_cast<uint32_t>(row[packed]));
+                break;
+            case ColorType::PackedFloat: {
+                static_assert(sizeof(float) == sizeof(uint32_t),
+                              "float and uint32_t have different sizes");
+                float f = static_cast<float>(row[packed]);
+                uint32_t value {};
+                std::memcpy(&value, &f, sizeof(value));
+                col.setPackedARGB(value);
+            } break;
+            default:
+                break;
+        }
+        return col;
     }
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::ranges::find(fields, "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
-    }
+private:
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    PointKernel& points;
+    std::vector<Base::Vector3f>& normals;
+    std::vector<float>& intensity;
+    std::vector<Base::Color>& colors;
+    unsigned int step;
+    std::size_t record {0};
+    ColorType colorType {ColorType::None};
+    std::size_t x {none}, y {none}, z {none};
+    std::size_t normalX {none}, normalY {none}, normalZ {none};
+    std::size_t grey {none};
+    std::size_t red {none}, green {none}, blue {none}, alpha {none};
+    std::size_t packed {none};
+};
 
-    it = std::ranges::find(fields, "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
+/**
+ * Checks that the stream still contains \a size bytes.
+ */
+void checkRemainingSize(std::istream& inp, std::size_t size)
+{
+    std::streambuf* buf = inp.rdbuf();
+    if (buf) {
+        std::streamoff ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+        std::streamoff ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
+        if (ulCurr + static_cast<std::streamoff>(size) > ulSize) {
+            throw Base::BadFormatError("File expects too many elements");
+        }
     }
+}
 
-    it = std::ranges::find(fields, "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
+/**
+ * Reads \a numRecords records whose values are stored one after another in the binary format
+ * described by \a fields. Only a chunk of the records is held in memory at a time.
+ */
+void readRecords(std::istream& inp,
+                 const std::vector<Field>& fields,
+                 std::size_t numRecords,
+                 bool swapByteOrder,
+                 RecordSink& sink)
+{
+    std::size_t recordSize = 0;
+    for (const auto& field : fields) {
+        recordSize += field.size;
+    }
+    if (recordSize == 0) {
+        return;
     }
 
-    it = std::ranges::find(fields, "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
+    checkRemainingSize(inp, recordSize * numRecords);
+    std::size_t chunk = std::max<std::size_t>(ChunkSize / recordSize, 1);
+    std::vector<char> buffer(std::min(chunk, numRecords) * recordSize);
+    std::vector<double> row(fields.size());
+    for (std::size_t done = 0; done < numRecords;) {
+        std::size_t count = std::min(chunk, numRecords - done);
+        inp.read(buffer.data(), static_cast<std::streamsize>(count * recordSize));
+        if (!inp) {
+            throw Base::BadFormatError("Unexpected end of file");
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            if (!sink.next()) {
+                continue;
+            }
+            const char* record = buffer.data() + i * recordSize;
+            for (std::size_t j = 0; j < fields.size(); j++) {
+                row[j] = decodeNumber(record + fields[j].offset, fields[j].type, swapByteOrder);
+            }
+            sink.add(row.data());
+        }
+        done += count;
     }
+}
 
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+/**
+ * Reads \a numRecords records from the binary buffer \a data where all values of the first
+ * field are followed by all values of the second field and so on.
+ */
+void readColumns(const std::vector<char>& data,
+                 const std::vector<Field>& fields,
+                 std::size_t numRecords,
+                 RecordSink& sink)
+{
+    std::vector<std::size_t> columns;
+    std::size_t size = 0;
+    for (const auto& field : fields) {
+        columns.push_back(size);
+        size += field.size * numRecords;
+    }
+    if (size > data.size()) {
+        throw Base::BadFormatError("File expects too many elements");
+    }
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    std::vector<double> row(fields.size());
+    for (std::size_t i = 0; i < numRecords; i++) {
+        if (!sink.next()) {
+            continue;
+        }
+        for (std::size_t j = 0; j < fields.size(); j++) {
+            const char* value = data.data() + columns[j] + i * fields[j].size;
+            row[j] = decodeNumber(value, fields[j].type, false);
         }
+        sink.add(row.data());
     }
+}
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+/**
+ * A block of complete text lines and the numbers parsed from it.
+ */
+struct TextBlock
+{
+    std::string text;
+    /// the values of each line padded with zeros to the number of fields
+    std::vector<double> values;
+    bool failed {false};
+};
+
+/**
+ * Parses the lines of \a block. Empty lines are skipped, numbers beyond \a numFields are
+ * ignored. The parsing doesn't depend on the locale.
+ */
+void parseBlock(TextBlock& block, std::size_t numFields)
+{
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+
+    const char* pos = block.text.data();
+    const char* end = pos + block.text.size();
+    block.values.clear();
+    while (pos < end) {
+        const char* eol = std::find(pos, end, '\n');
+        std::size_t field = 0;
+        while (pos < eol) {
+            while (pos < eol && isSpace(*pos)) {
+                ++pos;
+            }
+            if (pos == eol) {
+                break;
+            }
+            double value {};
+            const char* ptr = parseNumber(pos, eol, value);
+            if (!ptr || (ptr < eol && !isSpace(*ptr))) {
+                block.failed = true;
+                return;
+            }
+            if (field < numFields) {
+                block.values.push_back(value);
+            }
+            field++;
+            pos = ptr;
         }
+        if (field > 0) {
+            for (; field < numFields; field++) {
+                block.values.push_back(0.0);
+            }
+        }
+        pos = eol + 1;
     }
+    block.text.clear();
+}
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+/**
+ * Returns the position after the first \a count non-empty lines of \a text and decreases
+ * \a count by the number of non-empty lines found.
+ */
+std::size_t skipRecords(const std::string& text, std::size_t& count)
+{
+    std::size_t pos = 0;
+    while (count > 0 && pos < text.size()) {
+        std::size_t eol = std::min(text.find('\n', pos), text.size());
+        if (text.find_first_not_of(" \t\r", pos) < eol) {
+            count--;
         }
+        pos = eol + 1;
     }
+    return std::min(pos, text.size());
+}
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+/**
+ * Reads \a numRecords lines of \a numFields numbers each. The text is read in blocks of complete
+ * lines that are parsed in parallel and then passed to the sink in the order of the file.
+ */
+void readTextRecords(std::istream& inp,
+                     std::size_t numFields,
+                     std::size_t numRecords,
+                     RecordSink& sink)
+{
+    if (numFields == 0) {
+        return;
+    }
+
+    std::size_t numBlocks = std::max(2U * std::thread::hardware_concurrency(), 2U);
+    std::vector<TextBlock> blocks(numBlocks);
+    std::string rest;
+    std::size_t done = 0;
+    while (done < numRecords && inp) {
+        // fill the blocks with complete lines, the incomplete last line is kept for later
+        std::size_t missing = numRecords - done;
+        for (auto& block : blocks) {
+            block.text.swap(rest);
+            rest.clear();
+            if (missing == 0) {
+                block.text.clear();
+                continue;
+            }
+            std::size_t size = block.text.size();
+            block.text.resize(size + ChunkSize);
+            inp.read(block.text.data() + size, ChunkSize);
+            block.text.resize(size + std::size_t(inp.gcount()));
+            if (inp) {
+                std::size_t eol = block.text.rfind('\n');
+                if (eol != std::string::npos) {
+                    rest.assign(block.text, eol + 1);
+                    block.text.resize(eol + 1);
                 }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
+            }
+
+            // the lines after the last record belong to other elements and are not parsed
+            std::size_t end = skipRecords(block.text, missing);
+            if (missing == 0) {
+                block.text.resize(end);
+                rest.clear();
             }
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+
+        QtConcurrent::blockingMap(blocks, [numFields](TextBlock& block) {
+            parseBlock(block, numFields);
+        });
+
+        for (auto& block : blocks) {
+            if (block.failed) {
+                throw Base::BadFormatError("Failed to read numbers of ASCII data");
+            }
+            std::size_t lines = std::min(block.values.size() / numFields, numRecords - done);
+            for (std::size_t i = 0; i < lines; i++) {
+                if (sink.next()) {
+                    sink.add(block.values.data() + i * numFields);
                 }
-                colors.emplace_back(r, g, b, a);
             }
+            done += lines;
         }
     }
 }
 
+NumberType getPlyNumberType(const std::string& type)
+{
+    if (type == "char" || type == "int8") {
+        return NumberType::Int8;
+    }
+    if (type == "uchar" || type == "uint8") {
+        return NumberType::UInt8;
+    }
+    if (type == "short" || type == "int16") {
+        return NumberType::Int16;
+    }
+    if (type == "ushort" || type == "uint16") {
+        return NumberType::UInt16;
+    }
+    if (type == "int" || type == "int32") {
+        return NumberType::Int32;
+    }
+    if (type == "uint" || type == "uint32") {
+        return NumberType::UInt32;
+    }
+    if (type == "float" || type == "float32") {
+        return NumberType::Float32;
+    }
+    if (type == "double" || type == "float64") {
+        return NumberType::Float64;
+    }
+    throw Base::BadFormatError("Unexpected type");
+}
+
+NumberType getPcdNumberType(char type, int size)
+{
+    switch (size) {
+        case 1:
+            if (type == 'I') {
+                return NumberType::Int8;
+            }
+            if (type == 'U') {
+                return NumberType::UInt8;
+            }
+            break;
+        case 2:
+            if (type == 'I') {
+                return NumberType::Int16;
+            }
+            if (type == 'U') {
+                return NumberType::UInt16;
+            }
+            break;
+        case 4:
+            if (type == 'I') {
+                return NumberType::Int32;
+            }
+            if (type == 'U') {
+                return NumberType::UInt32;
+            }
+            if (type == 'F') {
+                return NumberType::Float32;
+            }
+            break;
+        case 8:
+            if (type == 'F') {
+                return NumberType::Float64;
+            }
+            break;
+        default:
+            break;
+    }
+    throw Base::BadFormatError("Unexpected type");
+}
+
+/// Skips \a count non-empty lines of the stream.
+void skipLines(std::istream& inp, std::size_t count)
+{
+    std::string line;
+    while (count > 0 && std::getline(inp, line)) {
+        boost::trim(line);
+        if (!line.empty()) {
+            count--;
+        }
+    }
+}
+}  // namespace
+
+PlyReader::PlyReader() = default;
+
+void PlyReader::read(const std::string& filename)
+{
+    clear();
+
+    Base::FileInfo fi(filename);
+    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+
+    std::string format;
+    std::vector<std::string> fields;
+    std::vector<std::string> types;
+    std::vector<int> sizes;
+    std::size_t offset = 0;
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
+
+    RecordSink sink(points, normals, intensity, colors, subsampling);
+    sink.setFields(fields);
+    std::size_t red = sink.getRedColor();
+    if (red != std::numeric_limits<std::size_t>::max()) {
+        if (types[red] == "uchar" || types[red] == "uint8") {
+            sink.setColorType(RecordSink::ColorType::UChar);
+        }
+        else if (types[red] == "float" || types[red] == "float32") {
+            sink.setColorType(RecordSink::ColorType::Float);
+        }
+    }
+    sink.reserve(numPoints);
+
+    if (format == "ascii") {
+        skipLines(inp, offset);
+        readTextRecords(inp, fields.size(), numPoints, sink);
+    }
+    else {
+        std::vector<Field> record;
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < fields.size(); i++) {
+            record.push_back({getPlyNumberType(types[i]), std::size_t(sizes[i]), size});
+            size += std::size_t(sizes[i]);
+        }
+
+        inp.seekg(static_cast<std::streamoff>(offset), std::ios::cur);
+        readRecords(inp, record, numPoints, format == "binary_big_endian", sink);
+    }
+
+    this->width = subsampling > 1 ? int(points.size()) : int(numPoints);
+    this->height = 1;
+}
+
 std::size_t PlyReader::readHeader(std::istream& in,
                                   std::string& format,
                                   std::size_t& offset,
@@ -887,136 +1443,6 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1034,14 +1460,38 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
+
+    RecordSink sink(points, normals, intensity, colors, subsampling);
+    sink.setFields(fields);
+    std::vector<Field> record;
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < fields.size(); i++) {
+        record.push_back({getPcdNumberType(types[i][0], sizes[i]), std::size_t(sizes[i]), size});
+        size += std::size_t(sizes[i]);
+    }
+
+    // the bits of a packed color of type float are taken as they are
+    std::size_t rgba = sink.getPackedColor();
+    if (rgba != std::numeric_limits<std::size_t>::max()) {
+        if (types[rgba] == "U") {
+            sink.setColorType(RecordSink::ColorType::Packed);
+        }
+        else if (types[rgba] == "F" && format == "ascii") {
+            sink.setColorType(RecordSink::ColorType::PackedFloat);
+        }
+        else if (types[rgba] == "F" && sizes[rgba] == 4) {
+            record[rgba].type = NumberType::UInt32;
+            sink.setColorType(RecordSink::ColorType::Packed);
+        }
+    }
+    sink.reserve(numPoints);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
     if (format == "ascii") {
-        readAscii(inp, data);
+        readTextRecords(inp, fields.size(), numPoints, sink);
     }
     else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+        readRecords(inp, record, numPoints, false, sink);
     }
     else if (format == "binary_compressed") {
         unsigned int c {};
@@ -1049,140 +1499,32 @@ void PcdReader::read(const std::string& filename)
         Base::InputStream str(inp);
         str >> c >> u;
 
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+        // check the sizes before allocating any memory for them
+        if (std::size_t(u) != size * numPoints) {
+            throw Base::BadFormatError("Uncompressed size doesn't match the fields and points");
         }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
+        std::istream::pos_type start = inp.tellg();
+        inp.seekg(0, std::ios::end);
+        std::istream::pos_type last = inp.tellg();
+        inp.seekg(start);
+        if (start < 0 || std::streamoff(c) > last - start) {
+            throw Base::BadFormatError("Compressed size exceeds the file");
         }
-    }
-
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
-    }
-
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
-    }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
-    }
-
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::ranges::find(fields, "rgb");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
-        }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        std::vector<char> uncompressed(u);
+        {
+            std::vector<char> compressed(c);
+            inp.read(compressed.data(), c);
+            if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) != u) {
+                throw Base::BadFormatError("Failed to decompress binary data");
+            }
         }
+        readColumns(uncompressed, record, numPoints, sink);
     }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
-        }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
-        }
+    if (subsampling > 1) {
+        this->width = int(points.size());
+        this->height = 1;
     }
 }
 
@@ -1257,139 +1599,6 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
@@ -1404,33 +1613,30 @@ public:
         , minDistance {distance}
     {}
 
-    void read()
-    {
-        e57::StructureNode root = imfi.root();
-        if (root.isDefined("data3D")) {
-            e57::VectorNode data3D(root.get("data3D"));
-            readData3D(data3D);
-        }
-    }
-
-    std::vector<Base::Color> getColors() const
+    /// Sets the storage where the points and their properties are appended to.
+    void setStorage(PointKernel& pts,
+                    std::vector<Base::Vector3f>& nor,
+                    std::vector<Base::Color>& col,
+                    std::vector<float>& inty)
     {
-        return colors;
+        points = &pts;
+        normals = &nor;
+        colors = &col;
+        intensity = &inty;
     }
 
-    std::vector<float> getItensity() const
+    void setSubsampling(unsigned int step)
     {
-        return intensity;
+        subsampling = std::max(step, 1U);
     }
 
-    const PointKernel& getPoints() const
-    {
-        return points;
-    }
-
-    const std::vector<Base::Vector3f>& getNormals() const
+    void read()
     {
-        return normals;
+        e57::StructureNode root = imfi.root();
+        if (root.isDefined("data3D")) {
+            e57::VectorNode data3D(root.get("data3D"));
+            readData3D(data3D);
+        }
     }
 
 private:
@@ -1645,6 +1851,18 @@ private:
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
 
+        std::size_t expected = std::size_t(cvn.childCount()) / subsampling;
+        points->reserve(points->size() + expected);
+        if (hasColor) {
+            colors->reserve(colors->size() + expected);
+        }
+        if (hasItensity) {
+            intensity->reserve(intensity->size() + expected);
+        }
+        if (hasNormal) {
+            normals->reserve(normals->size() + expected);
+        }
+
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
                 filter = false;
@@ -1661,18 +1879,18 @@ private:
                         filter = true;
                     }
                 }
-                if (!filter) {
-                    cnt_pts++;
-                    points.push_back(pt);
+                if (!filter && (cnt_pts++ % subsampling) == 0) {
+                    points->push_back(pt);
                     last = pt;
                     if (hasColor) {
-                        colors.push_back(getColor(proto, i));
+                        colors->push_back(getColor(proto, i));
                     }
                     if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
+                        intensity->push_back(proto.intensity[i]);
                     }
                     if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
+                        normals->push_back(
+                            getNormal(proto, i, hasPlacement, plm.getRotation()));
                     }
                 }
             }
@@ -1768,11 +1986,12 @@ private:
     bool useColor;
     bool checkState;
     double minDistance;
-    const size_t buf_size = 1024;
-    std::vector<Base::Color> colors;
-    std::vector<float> intensity;
-    PointKernel points;
-    std::vector<Base::Vector3f> normals;
+    unsigned int subsampling {1};
+    const size_t buf_size = 65536;
+    std::vector<Base::Color>* colors {nullptr};
+    std::vector<float>* intensity {nullptr};
+    PointKernel* points {nullptr};
+    std::vector<Base::Vector3f>* normals {nullptr};
 };
 }  // namespace
 
@@ -1784,20 +2003,21 @@ E57Reader::E57Reader(bool Color, bool State, double Distance)
 
 void E57Reader::read(const std::string& filename)
 {
+    clear();
     try {
         E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        reader.setStorage(points, normals, colors, intensity);
+        reader.setSubsampling(subsampling);
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
         width = points.size();
         height = 1;
     }
     catch (const Base::BadFormatError&) {
+        clear();
         throw;
     }
     catch (...) {
+        clear();
         throw Base::BadFormatError("Reading E57 file failed");
     }
 }
@@ -23,8 +23,6 @@
 #ifndef _PointsAlgos_h_
 #define _PointsAlgos_h_
 
-#include <Eigen/Core>
-
 #include "Points.h"
 #include "Properties.h"
 
@@ -40,9 +38,15 @@ public:
     /** Load a point cloud
      */
     static void Load(PointKernel&, const char* FileName);
-    /** Load a point cloud
+    /** Load a point cloud from a text file with the coordinates of a point per line.
+     * The file is parsed in parallel, lines that don't start with three numbers are skipped.
      */
     static void LoadAscii(PointKernel&, const char* FileName);
+    /** Returns the indices of the points whose mean distance to their \a neighbours nearest
+     * points exceeds the average of all points by more than \a deviation standard deviations.
+     */
+    static std::vector<std::size_t>
+    FindOutliers(const PointKernel&, std::size_t neighbours, double deviation);
 };
 
 class PointsExport Reader
@@ -64,6 +68,11 @@ public:
     bool isStructured() const;
     int getWidth() const;
     int getHeight() const;
+    /** Keeps only every \a step-th point of the file to reduce the size of huge clouds while
+     * reading them. A structured cloud becomes unstructured then.
+     */
+    void setSubsampling(unsigned int step);
+    unsigned int getSubsampling() const;
 
     Reader(const Reader&) = delete;
     Reader(Reader&&) = delete;
@@ -78,6 +87,7 @@ protected:
     std::vector<Base::Vector3f> normals;
     int width {0};
     int height {1};
+    unsigned int subsampling {1};
     // NOLINTEND
 };
 
@@ -101,13 +111,6 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder,
-                    std::istream&,
-                    std::size_t offset,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport PcdReader: public Reader
@@ -122,12 +125,6 @@ private:
                            std::vector<std::string>& fields,
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose,
-                    std::istream&,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport E57Reader: public Reader
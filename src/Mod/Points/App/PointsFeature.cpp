@@ -26,7 +26,9 @@
 #include <vector>
 #endif
 
+#include "NormalEstimation.h"
 #include "PointsFeature.h"
+#include "Properties.h"
 
 
 using namespace Points;
@@ -53,6 +55,20 @@ App::DocumentObjectExecReturn* Feature::execute()
     return App::DocumentObject::StdReturn;
 }
 
+void Feature::estimateNormals(std::size_t neighbours, bool orient)
+{
+    NormalEstimation estimation(Points.getValue());
+    estimation.SetNeighbours(neighbours);
+    estimation.SetOrientation(orient);
+
+    auto prop = dynamic_cast<PropertyNormalList*>(getPropertyByName("Normal"));
+    if (!prop) {
+        prop = static_cast<PropertyNormalList*>(
+            addDynamicProperty("Points::PropertyNormalList", "Normal"));
+    }
+    estimation.Perform(*prop);
+}
+
 void Feature::Restore(Base::XMLReader& reader)
 {
     GeoFeature::Restore(reader);
@@ -76,6 +76,11 @@ public:
         return &Points;
     }
 
+    /** Estimates the normals of the points from their \a neighbours nearest neighbours and
+     * stores them in the Normal property, which is added if it is missing.
+     */
+    void estimateNormals(std::size_t neighbours, bool orient);
+
 protected:
     void onChanged(const App::Property* prop) override;
     //@}
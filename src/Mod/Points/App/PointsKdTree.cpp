@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include <QtConcurrentMap>
+#endif
+
+#include "Points.h"
+#include "PointsKdTree.h"
+
+
+using namespace Points;
+
+namespace
+{
+/// Number of queries handled by one task of the parallel searches
+constexpr std::size_t BlockSize = 1024;
+
+std::vector<std::pair<std::size_t, std::size_t>> makeBlocks(std::size_t count)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t begin = 0; begin < count; begin += BlockSize) {
+        blocks.emplace_back(begin, std::min(begin + BlockSize, count));
+    }
+    return blocks;
+}
+
+float sqrDistance(const std::array<float, 3>& p1, const std::array<float, 3>& p2)
+{
+    float x = p1[0] - p2[0];
+    float y = p1[1] - p2[1];
+    float z = p1[2] - p2[2];
+    return x * x + y * y + z * z;
+}
+
+bool isCloser(const PointsKdTree::Neighbour& n1, const PointsKdTree::Neighbour& n2)
+{
+    return n1.sqrDistance < n2.sqrDistance;
+}
+}  // namespace
+
+PointsKdTree::PointsKdTree() = default;
+
+PointsKdTree::PointsKdTree(const PointKernel& kernel)
+{
+    Build(kernel.getBasicPoints());
+}
+
+PointsKdTree::PointsKdTree(const std::vector<Base::Vector3f>& points)
+{
+    Build(points);
+}
+
+void PointsKdTree::Clear()
+{
+    entries.clear();
+    nodes.clear();
+    numPoints = 0;
+    depth = 0;
+}
+
+void PointsKdTree::Build(const std::vector<Base::Vector3f>& points)
+{
+    Clear();
+    numPoints = points.size();
+    entries.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const Base::Vector3f& pnt = points[i];
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            entries.push_back({{pnt.x, pnt.y, pnt.z}, static_cast<uint32_t>(i)});
+        }
+    }
+
+    // each halving of the point ranges adds a level until the leaves are small enough
+    std::size_t count = entries.size();
+    while (((count + (std::size_t(1) << depth) - 1) >> depth) > LeafSize) {
+        depth++;
+    }
+    nodes.resize((std::size_t(1) << depth) - 1);
+    if (nodes.empty()) {
+        return;
+    }
+
+    Subtree root {0, 0, count, 0, entries.front().point, entries.front().point};
+    for (const auto& entry : entries) {
+        for (std::size_t i = 0; i < 3; i++) {
+            root.minPnt[i] = std::min(root.minPnt[i], entry.point[i]);
+            root.maxPnt[i] = std::max(root.maxPnt[i], entry.point[i]);
+        }
+    }
+
+    // the upper levels are built sequentially, the subtrees below in parallel
+    int taskLevel = 0;
+    std::size_t numTasks = 4 * std::max(std::thread::hardware_concurrency(), 1U);
+    while (taskLevel < depth && (std::size_t(1) << taskLevel) < numTasks) {
+        taskLevel++;
+    }
+    std::vector<Subtree> tasks;
+    buildNode(root, &tasks, taskLevel);
+    QtConcurrent::blockingMap(tasks, [this](const Subtree& tree) {
+        buildNode(tree, nullptr, depth);
+    });
+}
+
+void PointsKdTree::buildNode(const Subtree& tree, std::vector<Subtree>* tasks, int taskLevel)
+{
+    if (tree.level == depth) {
+        return;
+    }
+    if (tasks && tree.level == taskLevel) {
+        tasks->push_back(tree);
+        return;
+    }
+
+    // split the box of the node at the median of its longest side
+    uint32_t axis = 0;
+    for (uint32_t i = 1; i < 3; i++) {
+        if (tree.maxPnt[i] - tree.minPnt[i] > tree.maxPnt[axis] - tree.minPnt[axis]) {
+            axis = i;
+        }
+    }
+
+    std::size_t mid = (tree.begin + tree.end) / 2;
+    std::nth_element(entries.begin() + std::ptrdiff_t(tree.begin),
+                     entries.begin() + std::ptrdiff_t(mid),
+                     entries.begin() + std::ptrdiff_t(tree.end),
+                     [axis](const Entry& e1, const Entry& e2) {
+                         return e1.point[axis] < e2.point[axis];
+                     });
+    float split = entries[mid].point[axis];
+    nodes[tree.node] = Node {split, axis};
+
+    Subtree left {2 * tree.node + 1, tree.begin, mid, tree.level + 1, tree.minPnt, tree.maxPnt};
+    Subtree right {2 * tree.node + 2, mid, tree.end, tree.level + 1, tree.minPnt, tree.maxPnt};
+    left.maxPnt[axis] = split;
+    right.minPnt[axis] = split;
+    buildNode(left, tasks, taskLevel);
+    buildNode(right, tasks, taskLevel);
+}
+
+/**
+ * The state of a search. The offsets are the distances of the query point to the box of the
+ * visited node along the axes, the sum of their squares is a lower bound of the distance to the
+ * points of the node.
+ */
+struct PointsKdTree::Search
+{
+    Coords point;
+    std::size_t k {0};
+    float sqrRadius {0.0F};
+    std::array<float, 3> offsets {};
+    std::vector<Neighbour>& result;
+};
+
+void PointsKdTree::FindNearest(const Base::Vector3f& point,
+                               std::size_t k,
+                               std::vector<Neighbour>& result) const
+{
+    result.clear();
+    if (k == 0 || entries.empty()) {
+        return;
+    }
+
+    Search search {{point.x, point.y, point.z}, std::min(k, entries.size()), 0.0F, {}, result};
+    searchNearest(search, 0, 0, entries.size(), 0, 0.0F);
+}
+
+void PointsKdTree::searchNearest(Search& search,
+                                 std::size_t node,
+                                 std::size_t begin,
+                                 std::size_t end,
+                                 int level,
+                                 float minDist) const
+{
+    std::vector<Neighbour>& result = search.result;
+    if (level == depth) {
+        // the result is kept sorted by the distance
+        for (std::size_t i = begin; i < end; i++) {
+            float dist = sqrDistance(search.point, entries[i].point);
+            if (result.size() < search.k) {
+                result.emplace_back();
+            }
+            else if (dist >= result.back().sqrDistance) {
+                continue;
+            }
+            std::size_t pos = result.size() - 1;
+            for (; pos > 0 && result[pos - 1].sqrDistance > dist; pos--) {
+                result[pos] = result[pos - 1];
+            }
+            result[pos] = Neighbour {entries[i].index, dist};
+        }
+        return;
+    }
+
+    // the far side is only visited if it may contain closer points
+    const Node& split = nodes[node];
+    float diff = search.point[split.axis] - split.split;
+    std::size_t mid = (begin + end) / 2;
+    if (diff < 0.0F) {
+        searchNearest(search, 2 * node + 1, begin, mid, level + 1, minDist);
+    }
+    else {
+        searchNearest(search, 2 * node + 2, mid, end, level + 1, minDist);
+    }
+
+    float& offset = search.offsets[split.axis];
+    float oldOffset = offset;
+    float farDist = minDist - oldOffset * oldOffset + diff * diff;
+    if (result.size() < search.k || farDist < result.back().sqrDistance) {
+        offset = diff;
+        if (diff < 0.0F) {
+            searchNearest(search, 2 * node + 2, mid, end, level + 1, farDist);
+        }
+        else {
+            searchNearest(search, 2 * node + 1, begin, mid, level + 1, farDist);
+        }
+        offset = oldOffset;
+    }
+}
+
+void PointsKdTree::FindInRadius(const Base::Vector3f& point,
+                                float radius,
+                                std::vector<Neighbour>& result) const
+{
+    result.clear();
+    if (radius < 0.0F || entries.empty()) {
+        return;
+    }
+
+    Search search {{point.x, point.y, point.z}, 0, radius * radius, {}, result};
+    searchRadius(search, 0, 0, entries.size(), 0, 0.0F);
+    std::sort(result.begin(), result.end(), isCloser);
+}
+
+void PointsKdTree::searchRadius(Search& search,
+                                std::size_t node,
+                                std::size_t begin,
+                                std::size_t end,
+                                int level,
+                                float minDist) const
+{
+    if (level == depth) {
+        for (std::size_t i = begin; i < end; i++) {
+            float dist = sqrDistance(search.point, entries[i].point);
+            if (dist <= search.sqrRadius) {
+                search.result.push_back(Neighbour {entries[i].index, dist});
+            }
+        }
+        return;
+    }
+
+    const Node& split = nodes[node];
+    float diff = search.point[split.axis] - split.split;
+    std::size_t mid = (begin + end) / 2;
+    if (diff < 0.0F) {
+        searchRadius(search, 2 * node + 1, begin, mid, level + 1, minDist);
+    }
+    else {
+        searchRadius(search, 2 * node + 2, mid, end, level + 1, minDist);
+    }
+
+    float& offset = search.offsets[split.axis];
+    float oldOffset = offset;
+    float farDist = minDist - oldOffset * oldOffset + diff * diff;
+    if (farDist <= search.sqrRadius) {
+        offset = diff;
+        if (diff < 0.0F) {
+            searchRadius(search, 2 * node + 2, mid, end, level + 1, farDist);
+        }
+        else {
+            searchRadius(search, 2 * node + 1, begin, mid, level + 1, farDist);
+        }
+        offset = oldOffset;
+    }
+}
+
+void PointsKdTree::FindNearest(const std::vector<Base::Vector3f>& points,
+                               std::size_t k,
+                               std::vector<Neighbour>& result) const
+{
+    std::size_t num = std::min(k, entries.size());
+    result.assign(points.size() * num, Neighbour {});
+    if (num == 0) {
+        return;
+    }
+
+    auto blocks = makeBlocks(points.size());
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        std::vector<Neighbour> neighbours;
+        neighbours.reserve(num);
+        for (std::size_t i = block.first; i < block.second; i++) {
+            FindNearest(points[i], num, neighbours);
+            std::copy(neighbours.begin(),
+                      neighbours.end(),
+                      result.begin() + std::ptrdiff_t(i * num));
+        }
+    });
+}
+
+void PointsKdTree::FindNearest(std::size_t k, std::vector<Neighbour>& result) const
+{
+    std::size_t num = std::min(k, entries.size());
+    result.assign(numPoints * num, Neighbour {});
+    if (num == 0) {
+        return;
+    }
+
+    ForEachNearest(num, [&](uint32_t index, const std::vector<Neighbour>& neighbours) {
+        std::copy(neighbours.begin(),
+                  neighbours.end(),
+                  result.begin() + std::ptrdiff_t(index * num));
+    });
+}
+
+void PointsKdTree::ForEachNearest(
+    std::size_t k,
+    const std::function<void(uint32_t, const std::vector<Neighbour>&)>& func) const
+{
+    // going through the points in the order of the tree keeps the visited nodes in the cache
+    auto blocks = makeBlocks(entries.size());
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        std::vector<Neighbour> neighbours;
+        neighbours.reserve(std::min(k, entries.size()));
+        for (std::size_t i = block.first; i < block.second; i++) {
+            const Coords& pnt = entries[i].point;
+            FindNearest(Base::Vector3f(pnt[0], pnt[1], pnt[2]), k, neighbours);
+            func(entries[i].index, neighbours);
+        }
+    });
+}
+
+std::vector<std::vector<PointsKdTree::Neighbour>>
+PointsKdTree::FindInRadius(const std::vector<Base::Vector3f>& points, float radius) const
+{
+    std::vector<std::vector<Neighbour>> result(points.size());
+    auto blocks = makeBlocks(points.size());
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            FindInRadius(points[i], radius, result[i]);
+        }
+    });
+    return result;
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+
+/**
+ * The PointsKdTree class is a balanced kd-tree for nearest neighbour and radius searches in a
+ * point cloud. The points are copied and reordered so that the points of a leaf lie next to each
+ * other in memory. As the tree is balanced the nodes need no links, the children of the node i
+ * are the nodes 2i+1 and 2i+2.
+ *
+ * The indices of the search results refer to the point list the tree was built from. Invalid
+ * points with NaN coordinates are not part of the tree.
+ */
+class PointsExport PointsKdTree
+{
+public:
+    /// Maximum number of points of a leaf
+    static constexpr std::size_t LeafSize = 16;
+    static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    struct Neighbour
+    {
+        uint32_t index {InvalidIndex};
+        float sqrDistance {std::numeric_limits<float>::max()};
+    };
+
+    PointsKdTree();
+    /// Builds the tree of the points of \a kernel, the placement of the kernel is ignored.
+    explicit PointsKdTree(const PointKernel& kernel);
+    explicit PointsKdTree(const std::vector<Base::Vector3f>& points);
+
+    void Build(const std::vector<Base::Vector3f>& points);
+    void Clear();
+    /// Returns the number of valid points in the tree.
+    std::size_t Size() const
+    {
+        return entries.size();
+    }
+    /// Returns the number of points the tree was built from.
+    std::size_t CountPoints() const
+    {
+        return numPoints;
+    }
+
+    /** Searches the \a k points nearest to \a point. They are stored in \a result sorted by their
+     * distance, \a result has fewer than \a k elements only if the tree has fewer points.
+     */
+    void
+    FindNearest(const Base::Vector3f& point, std::size_t k, std::vector<Neighbour>& result) const;
+    /** Searches all points within \a radius around \a point. They are stored in \a result sorted
+     * by their distance.
+     */
+    void
+    FindInRadius(const Base::Vector3f& point, float radius, std::vector<Neighbour>& result) const;
+
+    /** Searches the nearest neighbours of all \a points in parallel. With n = min(k, Size()) the
+     * neighbours of the i-th point are stored at the positions i*n to (i+1)*n-1 of \a result.
+     */
+    void FindNearest(const std::vector<Base::Vector3f>& points,
+                     std::size_t k,
+                     std::vector<Neighbour>& result) const;
+    /** Searches the nearest neighbours of the points of the tree itself in parallel. The points
+     * are included in their own neighbourhood. The result is laid out as for the method above with
+     * respect to CountPoints(), the neighbours of invalid points are set to InvalidIndex.
+     */
+    void FindNearest(std::size_t k, std::vector<Neighbour>& result) const;
+    /** Calls \a func for each valid point of the tree with its index and its \a k nearest
+     * neighbours including the point itself. The calls are made in parallel.
+     */
+    void ForEachNearest(
+        std::size_t k,
+        const std::function<void(uint32_t, const std::vector<Neighbour>&)>& func) const;
+    /// Searches the points within \a radius around each of \a points in parallel.
+    std::vector<std::vector<Neighbour>> FindInRadius(const std::vector<Base::Vector3f>& points,
+                                                     float radius) const;
+
+private:
+    using Coords = std::array<float, 3>;
+    struct Entry
+    {
+        Coords point;
+        uint32_t index;
+    };
+    struct Node
+    {
+        float split;
+        uint32_t axis;
+    };
+    struct Subtree
+    {
+        std::size_t node;
+        std::size_t begin;
+        std::size_t end;
+        int level;
+        Coords minPnt;
+        Coords maxPnt;
+    };
+    struct Search;
+
+    void buildNode(const Subtree& tree, std::vector<Subtree>* tasks, int taskLevel);
+    void searchNearest(Search& search,
+                       std::size_t node,
+                       std::size_t begin,
+                       std::size_t end,
+                       int level,
+                       float minDist) const;
+    void searchRadius(Search& search,
+                      std::size_t node,
+                      std::size_t begin,
+                      std::size_t end,
+                      int level,
+                      float minDist) const;
+
+private:
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+    std::size_t numPoints {0};
+    int depth {0};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_KDTREE_H
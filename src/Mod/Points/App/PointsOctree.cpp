@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#endif
+
+#include "PointsOctree.h"
+
+
+using namespace Points;
+
+PointsOctree::PointsOctree(unsigned int leafSize)
+    : leafSize(std::max(leafSize, 1U))
+{}
+
+void PointsOctree::Clear()
+{
+    coords = nullptr;
+    boundBox = Base::BoundBox3f();
+    nodes.clear();
+    indices.clear();
+}
+
+void PointsOctree::Build(const std::vector<Base::Vector3f>& points)
+{
+    if (points.empty()) {
+        Clear();
+    }
+    else {
+        Build(&points.front().x, points.size());
+    }
+}
+
+void PointsOctree::Build(const float* coords, std::size_t count)
+{
+    Clear();
+    this->coords = coords;
+
+    std::vector<uint32_t> valid;
+    valid.reserve(count);
+    Base::BoundBox3f box;
+    for (std::size_t i = 0; i < count; i++) {
+        Base::Vector3f pnt = point(uint32_t(i));
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            valid.push_back(uint32_t(i));
+            box.Add(pnt);
+        }
+    }
+    if (valid.empty()) {
+        return;
+    }
+    boundBox = box;
+
+    // a cubic box gives the same point spacing along all axes
+    float edge = std::max({box.LengthX(), box.LengthY(), box.LengthZ()});
+    if (edge <= 0.0F) {
+        edge = 1.0F;
+    }
+    box.MaxX = box.MinX + edge;
+    box.MaxY = box.MinY + edge;
+    box.MaxZ = box.MinZ + edge;
+
+    indices.reserve(valid.size());
+    buildNode(box, valid.data(), valid.data() + valid.size(), 0);
+}
+
+int32_t PointsOctree::buildNode(const Base::BoundBox3f& box,
+                                uint32_t* first,
+                                uint32_t* last,
+                                int depth)
+{
+    auto index = int32_t(nodes.size());
+    nodes.emplace_back();
+    nodes.back().box = box;
+    nodes.back().begin = uint32_t(indices.size());
+    nodes.back().total = uint32_t(last - first);
+
+    if (last - first <= std::ptrdiff_t(leafSize) || depth >= MaxDepth) {
+        indices.insert(indices.end(), first, last);
+        nodes.back().count = uint32_t(last - first);
+        return index;
+    }
+
+    // the first point in each cell of the sample grid is kept by this node, the others are
+    // handed over to the octant of the children they fall into. Bit 2 of the octant is set for
+    // the upper half in x, bit 1 for y and bit 0 for z.
+    std::vector<uint8_t> occupied(Resolution * Resolution * Resolution, 0);
+    std::vector<std::pair<uint32_t, uint8_t>> rest;
+    rest.reserve(last - first);
+    std::array<std::size_t, 9> bounds {};
+    float scale = float(Resolution) / box.LengthX();
+    for (uint32_t* it = first; it != last; ++it) {
+        Base::Vector3f pnt = point(*it);
+        int cx = std::clamp(int((pnt.x - box.MinX) * scale), 0, Resolution - 1);
+        int cy = std::clamp(int((pnt.y - box.MinY) * scale), 0, Resolution - 1);
+        int cz = std::clamp(int((pnt.z - box.MinZ) * scale), 0, Resolution - 1);
+        int key = (cx * Resolution + cy) * Resolution + cz;
+        if (!occupied[key]) {
+            occupied[key] = 1;
+            indices.push_back(*it);
+        }
+        else {
+            int octant = (cx >= Resolution / 2 ? 4 : 0) | (cy >= Resolution / 2 ? 2 : 0)
+                | (cz >= Resolution / 2 ? 1 : 0);
+            rest.emplace_back(*it, uint8_t(octant));
+            bounds[octant + 1]++;
+        }
+    }
+    nodes.back().count = uint32_t(indices.size()) - nodes.back().begin;
+
+    // group the remaining points by their octants at the front of the range
+    for (int i = 0; i < 8; i++) {
+        bounds[i + 1] += bounds[i];
+    }
+    std::array<std::size_t, 8> fill {};
+    std::copy(bounds.begin(), bounds.end() - 1, fill.begin());
+    for (const auto& [pnt, octant] : rest) {
+        first[fill[octant]++] = pnt;
+    }
+    rest = {};
+
+    Base::Vector3f mid = box.GetCenter();
+    for (int i = 0; i < 8; i++) {
+        if (bounds[i] == bounds[i + 1]) {
+            continue;
+        }
+        Base::BoundBox3f octant = box;
+        ((i & 4) ? octant.MinX : octant.MaxX) = mid.x;
+        ((i & 2) ? octant.MinY : octant.MaxY) = mid.y;
+        ((i & 1) ? octant.MinZ : octant.MaxZ) = mid.z;
+        int32_t child = buildNode(octant, first + bounds[i], first + bounds[i + 1], depth + 1);
+        nodes[index].children[i] = child;
+    }
+
+    return index;
+}
+
+float PointsOctree::GetSpacing(const Node& node) const
+{
+    return node.box.LengthX() / float(Resolution);
+}
+
+std::vector<uint32_t>
+PointsOctree::Select(const ScaleFunction& scale, std::size_t budget, float spacing) const
+{
+    std::vector<uint32_t> selection;
+    if (nodes.empty()) {
+        return selection;
+    }
+
+    // the nodes whose points appear the coarsest on the screen come first
+    using Entry = std::pair<float, uint32_t>;
+    std::priority_queue<Entry> queue;
+    auto push = [&](uint32_t index) {
+        float pixels = scale(nodes[index]);
+        if (pixels >= 0.0F) {
+            queue.emplace(pixels * GetSpacing(nodes[index]), index);
+        }
+    };
+
+    push(0);
+    std::size_t points = 0;
+    while (!queue.empty()) {
+        auto [pixels, index] = queue.top();
+        queue.pop();
+
+        const Node& node = nodes[index];
+        if (points + node.count > budget) {
+            continue;
+        }
+        points += node.count;
+        selection.push_back(index);
+
+        if (pixels > spacing) {
+            for (int32_t child : node.children) {
+                if (child >= 0) {
+                    push(uint32_t(child));
+                }
+            }
+        }
+    }
+
+    return selection;
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+#include <Mod/Points/PointsGlobal.h>
+
+
+namespace Points
+{
+
+/**
+ * The PointsOctree class arranges a point cloud into a hierarchy of levels of detail.
+ * Each node owns an evenly spaced subset of the points in its box, the remaining points are
+ * passed to its eight children. Drawing the points of a node together with all of its ancestors
+ * thus gives an approximation of the cloud whose density grows with the depth of the node.
+ *
+ * The points themselves are not copied, the octree only stores their indices grouped per node.
+ * Invalid points with NaN coordinates are ignored.
+ */
+class PointsExport PointsOctree
+{
+public:
+    /// Number of sample cells per axis of a node
+    static constexpr int Resolution = 32;
+    /// Maximum depth of the tree to cope with many coincident points
+    static constexpr int MaxDepth = 21;
+
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// first entry and number of the node's own points in the index list
+        uint32_t begin {0};
+        uint32_t count {0};
+        /// number of points of the node and all its descendants
+        uint32_t total {0};
+        /// node indices of the children, -1 for empty octants
+        std::array<int32_t, 8> children {-1, -1, -1, -1, -1, -1, -1, -1};
+    };
+
+    /** Returns the size of a node in screen pixels per object space unit or a negative value if
+     * the node is not visible.
+     */
+    using ScaleFunction = std::function<float(const Node&)>;
+
+    /** Creates an empty octree. A node whose box contains at most \a leafSize points is not
+     * subdivided any further.
+     */
+    explicit PointsOctree(unsigned int leafSize = 4096);
+
+    /** Builds the octree of \a count points whose coordinates are given as consecutive x, y, z
+     * triples.
+     */
+    void Build(const float* coords, std::size_t count);
+    void Build(const std::vector<Base::Vector3f>& points);
+    void Clear();
+
+    /// The root node is the first element unless the octree is empty.
+    const std::vector<Node>& GetNodes() const
+    {
+        return nodes;
+    }
+    const std::vector<uint32_t>& GetIndices() const
+    {
+        return indices;
+    }
+    /// Returns the bounding box of the valid points, the box of the root node is a cube around it.
+    const Base::BoundBox3f& GetBoundBox() const
+    {
+        return boundBox;
+    }
+    /// Returns the distance of the points owned by the node \a node.
+    float GetSpacing(const Node& node) const;
+
+    /** Selects the nodes to be drawn. Starting at the root the nodes with the coarsest points on
+     * the screen are refined first until either the projected distance of their points falls
+     * below \a spacing pixels or the number of selected points would exceed \a budget.
+     * Nodes for which \a scale returns a negative value are skipped together with their
+     * descendants.
+     */
+    std::vector<uint32_t>
+    Select(const ScaleFunction& scale, std::size_t budget, float spacing) const;
+
+private:
+    int32_t buildNode(const Base::BoundBox3f& box, uint32_t* first, uint32_t* last, int depth);
+    Base::Vector3f point(uint32_t index) const
+    {
+        const float* xyz = coords + 3 * std::size_t(index);
+        return Base::Vector3f(xyz[0], xyz[1], xyz[2]);
+    }
+
+private:
+    unsigned int leafSize;
+    const float* coords {nullptr};
+    Base::BoundBox3f boundBox;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> indices;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_OCTREE_H
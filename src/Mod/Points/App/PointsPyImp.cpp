@@ -30,7 +30,11 @@
 #include <Base/GeometryPyCXX.h>
 #include <Base/VectorPy.h>
 
+#include "Downsampling.h"
+#include "NormalEstimation.h"
 #include "Points.h"
+#include "PointsAlgos.h"
+#include "PointsKdTree.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
 #include "PointsPy.cpp"
@@ -38,6 +42,53 @@
 
 using namespace Points;
 
+namespace
+{
+// converts a sequence of points into the local coordinate system of the kernel
+std::vector<Base::Vector3f> getQueryPoints(const PointKernel* kernel, PyObject* obj)
+{
+    Base::Matrix4D mat = kernel->getTransform();
+    mat.inverse();
+
+    Py::Sequence list(obj);
+    Py::Type vType(Base::getTypeAsObject(&Base::VectorPy::Type));
+    std::vector<Base::Vector3f> points;
+    points.reserve(list.size());
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        Base::Vector3d pnt;
+        if ((*it).isType(vType)) {
+            pnt = Py::Vector(*it).toVector();
+        }
+        else {
+            Py::Tuple tuple(*it);
+            pnt.x = (double)Py::Float(tuple[0]);
+            pnt.y = (double)Py::Float(tuple[1]);
+            pnt.z = (double)Py::Float(tuple[2]);
+        }
+        points.push_back(Base::convertTo<Base::Vector3f>(mat * pnt));
+    }
+    return points;
+}
+
+Py::Tuple toTuple(const PointsKdTree::Neighbour* first, const PointsKdTree::Neighbour* last)
+{
+    Py::Tuple tuple(last - first);
+    for (Py_ssize_t i = 0; first != last; ++first, ++i) {
+        tuple.setItem(i, Py::Long(static_cast<unsigned long>(first->index)));
+    }
+    return tuple;
+}
+
+Py::List toList(const std::vector<std::size_t>& indices)
+{
+    Py::List list;
+    for (std::size_t index : indices) {
+        list.append(Py::Long(static_cast<unsigned long>(index)));
+    }
+    return list;
+}
+}  // namespace
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation() const
 {
@@ -242,6 +293,143 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::nearestNeighbours(PyObject* args) const
+{
+    int k {};
+    PyObject* obj = nullptr;
+    if (!PyArg_ParseTuple(args, "i|O", &k, &obj)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        std::shared_ptr<const PointsKdTree> tree = kernel->getKdTree();
+        std::size_t num = std::min(std::size_t(std::max(k, 0)), tree->Size());
+        std::vector<PointsKdTree::Neighbour> result;
+        std::size_t count = kernel->size();
+        if (obj) {
+            std::vector<Base::Vector3f> points = getQueryPoints(kernel, obj);
+            count = points.size();
+            tree->FindNearest(points, num, result);
+        }
+        else {
+            tree->FindNearest(num, result);
+        }
+
+        // invalid points of this object have no neighbours
+        Py::List list;
+        for (std::size_t i = 0; i < count; i++) {
+            const PointsKdTree::Neighbour* first = result.data() + i * num;
+            const PointsKdTree::Neighbour* last = first + num;
+            if (num > 0 && first->index == PointsKdTree::InvalidIndex) {
+                last = first;
+            }
+            list.append(toTuple(first, last));
+        }
+        return Py::new_reference_to(list);
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::neighboursInRadius(PyObject* args) const
+{
+    double radius {};
+    PyObject* obj = nullptr;
+    if (!PyArg_ParseTuple(args, "d|O", &radius, &obj)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        std::shared_ptr<const PointsKdTree> tree = kernel->getKdTree();
+        std::vector<Base::Vector3f> points =
+            obj ? getQueryPoints(kernel, obj) : kernel->getBasicPoints();
+        auto result = tree->FindInRadius(points, static_cast<float>(radius));
+
+        Py::List list;
+        for (const auto& neighbours : result) {
+            list.append(toTuple(neighbours.data(), neighbours.data() + neighbours.size()));
+        }
+        return Py::new_reference_to(list);
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::findOutliers(PyObject* args) const
+{
+    int neighbours = 8;
+    double deviation = 1.0;
+    if (!PyArg_ParseTuple(args, "|id", &neighbours, &deviation)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        std::vector<std::size_t> outliers =
+            PointsAlgos::FindOutliers(*getPointKernelPtr(), std::max(neighbours, 1), deviation);
+        return Py::new_reference_to(toList(outliers));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::estimateNormals(PyObject* args) const
+{
+    int neighbours = 10;
+    PyObject* orient = Py_True;
+    if (!PyArg_ParseTuple(args, "|iO!", &neighbours, &PyBool_Type, &orient)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        NormalEstimation estimation(*kernel);
+        estimation.SetNeighbours(std::size_t(std::max(neighbours, 0)));
+        estimation.SetOrientation(Base::asBoolean(orient));
+
+        Py::List list;
+        for (const auto& normal : estimation.Perform()) {
+            list.append(Py::Vector(normal));
+        }
+        return Py::new_reference_to(list);
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::sampleVoxelGrid(PyObject* args) const
+{
+    double size {};
+    if (!PyArg_ParseTuple(args, "d", &size)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        auto indices = Downsampling::VoxelGrid(*kernel, size);
+        return new PointsPy(new PointKernel(Downsampling::Extract(*kernel, indices)));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::samplePoissonDisk(PyObject* args) const
+{
+    double radius {};
+    if (!PyArg_ParseTuple(args, "d", &radius)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        auto indices = Downsampling::PoissonDisk(*kernel, radius);
+        return new PointsPy(new PointKernel(Downsampling::Extract(*kernel, indices)));
+    }
+    PY_CATCH;
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
@@ -50,9 +50,9 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
-#include <boost/regex.hpp>
 
 // Qt
+#include <QFile>
 #include <QtConcurrentMap>
 
 #endif  //_PreComp_
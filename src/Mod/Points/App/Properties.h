@@ -85,6 +85,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -123,6 +127,7 @@ public:
     }
 
     void setValues(const std::vector<Base::Vector3f>& values);
+    void setValues(std::vector<Base::Vector3f>&& values);
 
     const std::vector<Base::Vector3f>& getValues() const
     {
@@ -137,6 +142,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
@@ -215,6 +224,10 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canSaveDocFileConcurrently() const override
+    {
+        return true;
+    }
     //@}
 
     /** @name Undo/Redo */
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #endif
 
 #include <Base/Matrix.h>
@@ -133,6 +134,17 @@ void PropertyPointKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+std::function<void()> PropertyPointKernel::RestoreDocFileConcurrently(Base::Reader& reader)
+{
+    auto kernel = std::make_shared<PointKernel>();
+    kernel->RestoreDocFile(reader);
+    return [this, kernel]() {
+        aboutToSetValue();
+        _cPoints->swap(kernel->getBasicPoints());
+        hasSetValue();
+    };
+}
+
 App::Property* PropertyPointKernel::Copy() const
 {
     PropertyPointKernel* prop = new PropertyPointKernel();
@@ -76,6 +76,11 @@ public:
     void Restore(Base::XMLReader& reader) override;
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canRestoreDocFileConcurrently() const override
+    {
+        return true;
+    }
+    std::function<void()> RestoreDocFileConcurrently(Base::Reader& reader) override;
     //@}
 
     /** @name Modification */
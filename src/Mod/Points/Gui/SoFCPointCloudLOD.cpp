@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#ifdef FC_OS_WIN32
+#include <windows.h>
+#endif
+#ifdef FC_OS_MACOSX
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#include <Inventor/SbPlane.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SoPickedPoint.h>
+#include <Inventor/SoPrimitiveVertex.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/actions/SoGetPrimitiveCountAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/bundles/SoMaterialBundle.h>
+#include <Inventor/details/SoPointDetail.h>
+#include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/elements/SoCoordinateElement.h>
+#include <Inventor/elements/SoGLLazyElement.h>
+#include <Inventor/elements/SoMaterialBindingElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoNormalBindingElement.h>
+#include <Inventor/elements/SoNormalElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
+#include <Inventor/elements/SoViewportRegionElement.h>
+#include <Inventor/misc/SoState.h>
+#endif
+
+#include <Gui/SoFCInteractiveElement.h>
+
+#include "SoFCPointCloudLOD.h"
+
+
+using namespace PointsGui;
+
+namespace
+{
+bool isValid(const SbVec3f& pnt)
+{
+    return !std::isnan(pnt[0]) && !std::isnan(pnt[1]) && !std::isnan(pnt[2]);
+}
+
+SbBox3f toBox(const Base::BoundBox3f& box)
+{
+    return SbBox3f(box.MinX, box.MinY, box.MinZ, box.MaxX, box.MaxY, box.MaxZ);
+}
+
+/// Checks whether the box lies completely outside one of the planes of the view volume.
+bool isCulled(const SbPlane (&planes)[6], const Base::BoundBox3f& box)
+{
+    for (const SbPlane& plane : planes) {
+        // the corner farthest along the inwards pointing normal
+        const SbVec3f& normal = plane.getNormal();
+        SbVec3f corner(normal[0] >= 0.0F ? box.MaxX : box.MinX,
+                       normal[1] >= 0.0F ? box.MaxY : box.MinY,
+                       normal[2] >= 0.0F ? box.MaxZ : box.MinZ);
+        if (plane.getDistance(corner) < 0.0F) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+SO_NODE_SOURCE(SoFCPointCloudLOD)
+
+void SoFCPointCloudLOD::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCPointCloudLOD, SoShape, "Shape");
+}
+
+SoFCPointCloudLOD::SoFCPointCloudLOD()
+{
+    SO_NODE_CONSTRUCTOR(SoFCPointCloudLOD);
+    SO_NODE_ADD_FIELD(pointBudget, (5000000));
+    SO_NODE_ADD_FIELD(interactiveBudget, (1000000));
+    SO_NODE_ADD_FIELD(pointSpacing, (1.0F));
+}
+
+SoFCPointCloudLOD::~SoFCPointCloudLOD() = default;
+
+void SoFCPointCloudLOD::buildOctree(const SoMFVec3f& points)
+{
+    coordinateData = points.getValues(0);
+    coordinateCount = points.getNum();
+    if (coordinateData && coordinateCount > 0) {
+        octree.Build(points.getValues(0)->getValue(), std::size_t(coordinateCount));
+    }
+    else {
+        octree.Clear();
+    }
+}
+
+/**
+ * Checks whether the octree was built for the coordinates \a coords.
+ */
+bool SoFCPointCloudLOD::hasOctree(const SoCoordinateElement* coords) const
+{
+    return coords->getArrayPtr3() == coordinateData && coords->getNum() == coordinateCount;
+}
+
+/**
+ * Renders the points of the octree nodes that are visible and needed to reach the point
+ * spacing on the screen. While navigating the smaller interactive budget is used.
+ * Without an octree for the current coordinates all points are drawn.
+ */
+void SoFCPointCloudLOD::GLRender(SoGLRenderAction* action)
+{
+    if (!shouldGLRender(action)) {
+        return;
+    }
+
+    SoState* state = action->getState();
+    // the drawn points depend on the camera
+    SoCacheElement::invalidate(state);
+
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
+    if (coords->getNum() == 0 || !coords->is3D()) {
+        return;
+    }
+    bool lod = hasOctree(coords);
+    const std::vector<Points::PointsOctree::Node>& nodes = octree.GetNodes();
+    const std::vector<uint32_t>& indices = octree.GetIndices();
+    if (lod && nodes.empty()) {
+        return;
+    }
+
+    // work in object space to avoid transforming the node boxes
+    SbViewVolume volume = SoViewVolumeElement::get(state);
+    volume.transform(SoModelMatrixElement::get(state).inverse());
+    SbPlane planes[6];
+    volume.getViewVolumePlanes(planes);
+    float height = SoViewportRegionElement::get(state).getViewportSizePixels()[1];
+
+    auto scale = [&](const Points::PointsOctree::Node& node) {
+        if (isCulled(planes, node.box)) {
+            return -1.0F;
+        }
+        Base::Vector3f mid = node.box.GetCenter();
+        float size = volume.getWorldToScreenScale(SbVec3f(mid.x, mid.y, mid.z), 1.0F);
+        return size > 0.0F ? height / size : std::numeric_limits<float>::max();
+    };
+
+    std::vector<uint32_t> selection;
+    if (lod) {
+        bool interactive = Gui::SoFCInteractiveElement::get(state);
+        uint32_t budget = interactive ? interactiveBudget.getValue() : pointBudget.getValue();
+        selection = octree.Select(scale, budget, pointSpacing.getValue());
+    }
+
+    SoMaterialBundle mb(action);
+    mb.sendFirst();
+
+    // colors and normals are only used if there is one per point
+    SoMaterialBindingElement::Binding binding = SoMaterialBindingElement::get(state);
+    bool perVertex = binding == SoMaterialBindingElement::PER_VERTEX
+        || binding == SoMaterialBindingElement::PER_VERTEX_INDEXED;
+    bool colors = perVertex && !SoLazyElement::isPacked(state)
+        && SoLazyElement::getNumDiffuse(state) == coords->getNum();
+    const SoNormalElement* normals = SoNormalElement::getInstance(state);
+    bool lighting = !mb.isColorOnly() && normals->getNum() == coords->getNum();
+
+    glPushAttrib(GL_ENABLE_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, coords->getArrayPtr3());
+    if (colors) {
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, 0, SoLazyElement::getDiffusePointer(state));
+    }
+    if (lighting) {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_FLOAT, 0, normals->getArrayPtr());
+    }
+    else {
+        glDisable(GL_LIGHTING);
+    }
+
+    for (uint32_t index : selection) {
+        const Points::PointsOctree::Node& node = nodes[index];
+        glDrawElements(GL_POINTS,
+                       GLsizei(node.count),
+                       GL_UNSIGNED_INT,
+                       indices.data() + node.begin);
+    }
+    if (!lod) {
+        glDrawArrays(GL_POINTS, 0, GLsizei(coords->getNum()));
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+    if (colors) {
+        // the color array has changed the current color behind Coin's back
+        SoGLLazyElement::getInstance(state)->reset(state, SoLazyElement::DIFFUSE_MASK);
+    }
+}
+
+/**
+ * Sets the bounding box of the valid points to \a box and its center to \a center.
+ * The box is taken from the octree unless the coordinates have changed behind its back.
+ */
+void SoFCPointCloudLOD::computeBBox(SoAction* action, SbBox3f& box, SbVec3f& center)
+{
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(action->getState());
+    box.makeEmpty();
+    if (hasOctree(coords)) {
+        if (octree.GetBoundBox().IsValid()) {
+            box = toBox(octree.GetBoundBox());
+        }
+    }
+    else {
+        for (int32_t i = 0; i < coords->getNum(); i++) {
+            const SbVec3f& pnt = coords->get3(i);
+            if (isValid(pnt)) {
+                box.extendBy(pnt);
+            }
+        }
+    }
+    if (box.isEmpty()) {
+        box.setBounds(SbVec3f(0, 0, 0), SbVec3f(0, 0, 0));
+    }
+    center = box.getCenter();
+}
+
+/**
+ * Adds the number of the points to the \a SoGetPrimitiveCountAction.
+ */
+void SoFCPointCloudLOD::getPrimitiveCount(SoGetPrimitiveCountAction* action)
+{
+    if (!this->shouldPrimitiveCount(action)) {
+        return;
+    }
+    action->addNumPoints(SoCoordinateElement::getInstance(action->getState())->getNum());
+}
+
+/**
+ * Picks the points of all octree nodes the pick volume passes through instead of testing every
+ * single point. Without an octree for the current coordinates all points are tested.
+ */
+void SoFCPointCloudLOD::rayPick(SoRayPickAction* action)
+{
+    if (!shouldRayPick(action)) {
+        return;
+    }
+
+    SoState* state = action->getState();
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
+    if (coords->getNum() == 0 || !coords->is3D()) {
+        return;
+    }
+
+    computeObjectSpaceRay(action);
+    bool perVertex = SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL;
+    bool normals = SoNormalBindingElement::get(state) != SoNormalBindingElement::OVERALL;
+
+    auto pick = [&](int32_t index) {
+        const SbVec3f& pnt = coords->get3(index);
+        if (isValid(pnt) && action->intersect(pnt)) {
+            SoPickedPoint* pp = action->addIntersection(pnt);
+            if (pp) {
+                auto detail = new SoPointDetail();
+                detail->setCoordinateIndex(index);
+                detail->setMaterialIndex(perVertex ? index : 0);
+                detail->setNormalIndex(normals ? index : 0);
+                pp->setDetail(detail, this);
+            }
+        }
+    };
+
+    if (!hasOctree(coords)) {
+        for (int32_t i = 0; i < coords->getNum(); i++) {
+            pick(i);
+        }
+        return;
+    }
+
+    const std::vector<Points::PointsOctree::Node>& nodes = octree.GetNodes();
+    const std::vector<uint32_t>& indices = octree.GetIndices();
+    if (nodes.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> stack {0};
+    while (!stack.empty()) {
+        const Points::PointsOctree::Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        SbVec3f intersection;
+        if (!action->intersect(toBox(node.box), intersection, TRUE)) {
+            continue;
+        }
+        for (uint32_t i = node.begin; i < node.begin + node.count; i++) {
+            pick(int32_t(indices[i]));
+        }
+        for (int32_t child : node.children) {
+            if (child >= 0) {
+                stack.push_back(uint32_t(child));
+            }
+        }
+    }
+}
+
+/**
+ * Generates all valid points regardless of the level of detail.
+ */
+void SoFCPointCloudLOD::generatePrimitives(SoAction* action)
+{
+    SoState* state = action->getState();
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
+    const SoNormalElement* normals = SoNormalElement::getInstance(state);
+    bool perVertex = SoMaterialBindingElement::get(state) != SoMaterialBindingElement::OVERALL;
+    bool hasNormals = normals->getNum() == coords->getNum();
+
+    SoPrimitiveVertex vertex;
+    SoPointDetail detail;
+    vertex.setDetail(&detail);
+
+    beginShape(action, SoShape::POINTS);
+    for (int32_t i = 0; i < coords->getNum(); i++) {
+        const SbVec3f& pnt = coords->get3(i);
+        if (!isValid(pnt)) {
+            continue;
+        }
+        vertex.setPoint(pnt);
+        detail.setCoordinateIndex(i);
+        if (perVertex) {
+            vertex.setMaterialIndex(i);
+            detail.setMaterialIndex(i);
+        }
+        if (hasNormals) {
+            vertex.setNormal(normals->get(i));
+            detail.setNormalIndex(i);
+        }
+        shapeVertex(&vertex);
+    }
+    endShape();
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+
+#ifndef POINTSGUI_SOFCPOINTCLOUDLOD_H
+#define POINTSGUI_SOFCPOINTCLOUDLOD_H
+
+#include <Inventor/SbBasic.h>
+#include <Inventor/fields/SoMFVec3f.h>
+#include <Inventor/fields/SoSFFloat.h>
+#include <Inventor/fields/SoSFUInt32.h>
+#include <Inventor/nodes/SoShape.h>
+#include <Mod/Points/App/PointsOctree.h>
+#include <Mod/Points/PointsGlobal.h>
+
+
+class SoCoordinateElement;
+
+namespace PointsGui
+{
+
+/**
+ * The SoFCPointCloudLOD class renders the points of the current coordinate element like
+ * SoPointSet does but organizes them in an octree of detail levels. Per frame only the points
+ * of the nodes inside the view volume are drawn, the level of detail is chosen by the screen
+ * space distance of the points and the point budget.
+ *
+ * The octree is built by buildOctree() when the coordinates are set, so rendering and picking
+ * never have to build it. Coordinates the octree wasn't built for are drawn and picked
+ * completely. Points with NaN coordinates are not drawn.
+ */
+// NOLINTBEGIN(cppcoreguidelines-special-member-functions,cppcoreguidelines-virtual-class-destructor)
+class PointsGuiExport SoFCPointCloudLOD: public SoShape
+{
+    using inherited = SoShape;
+
+    SO_NODE_HEADER(SoFCPointCloudLOD);
+
+public:
+    static void initClass();
+    SoFCPointCloudLOD();
+
+    /// Builds the octree of \a points, it must be called whenever the coordinates change
+    void buildOctree(const SoMFVec3f& points);
+
+    /// Maximum number of points drawn per frame
+    SoSFUInt32 pointBudget;
+    /// Maximum number of points drawn per frame while the view is being navigated
+    SoSFUInt32 interactiveBudget;
+    /// Distance of the points in pixels below which no finer level is drawn
+    SoSFFloat pointSpacing;
+
+protected:
+    void GLRender(SoGLRenderAction* action) override;
+    void computeBBox(SoAction* action, SbBox3f& box, SbVec3f& center) override;
+    void getPrimitiveCount(SoGetPrimitiveCountAction* action) override;
+    void rayPick(SoRayPickAction* action) override;
+    void generatePrimitives(SoAction* action) override;
+    // Force using the reference count mechanism.
+    ~SoFCPointCloudLOD() override;
+
+private:
+    bool hasOctree(const SoCoordinateElement* coords) const;
+
+private:
+    Points::PointsOctree octree;
+    const void* coordinateData {nullptr};
+    int32_t coordinateCount {0};
+};
+// NOLINTEND(cppcoreguidelines-special-member-functions,cppcoreguidelines-virtual-class-destructor)
+
+}  // namespace PointsGui
+
+
+#endif  // POINTSGUI_SOFCPOINTCLOUDLOD_H
@@ -37,6 +37,7 @@
 #include <Inventor/nodes/SoPointSet.h>
 #endif
 
+#include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Vector3D.h>
 #include <Gui/Application.h>
@@ -46,12 +47,26 @@
 #include <Mod/Points/App/PointsFeature.h>
 #include <Mod/Points/App/Properties.h>
 
+#include "SoFCPointCloudLOD.h"
 #include "ViewProvider.h"
 
 
 using namespace PointsGui;
 using namespace Points;
 
+namespace
+{
+SoFCPointCloudLOD* createPointCloud()
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Points/View");
+    auto points = new SoFCPointCloudLOD();
+    points->pointBudget = hGrp->GetUnsigned("PointBudget", points->pointBudget.getValue());
+    points->interactiveBudget =
+        hGrp->GetUnsigned("InteractivePointBudget", points->interactiveBudget.getValue());
+    return points;
+}
+}  // namespace
 
 PROPERTY_SOURCE_ABSTRACT(PointsGui::ViewProviderPoints, Gui::ViewProviderGeometryObject)
 
@@ -368,7 +383,7 @@ PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
 ViewProviderScattered::ViewProviderScattered()
 {
-    pcPoints = new SoPointSet();
+    pcPoints = createPointCloud();
     pcPoints->ref();
 }
 
@@ -540,7 +555,7 @@ PROPERTY_SOURCE(PointsGui::ViewProviderStructured, PointsGui::ViewProviderPoints
 
 ViewProviderStructured::ViewProviderStructured()
 {
-    pcPoints = new SoIndexedPointSet();
+    pcPoints = createPointCloud();
     pcPoints->ref();
 }
 
@@ -704,6 +719,22 @@ void ViewProviderPointsBuilder::buildNodes(const App::Property* prop,
 void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
                                              SoCoordinate3* coords,
                                              SoPointSet* points) const
+{
+    createCoordinates(prop, coords);
+    points->numPoints = coords->point.getNum();
+}
+
+void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
+                                             SoCoordinate3* coords,
+                                             SoFCPointCloudLOD* points) const
+{
+    // the invalid points are skipped by the node itself
+    createCoordinates(prop, coords);
+    points->buildOctree(coords->point);
+}
+
+void ViewProviderPointsBuilder::createCoordinates(const App::Property* prop,
+                                                  SoCoordinate3* coords) const
 {
     const Points::PropertyPointKernel* prop_points =
         static_cast<const Points::PropertyPointKernel*>(prop);
@@ -721,7 +752,6 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop,
         vec[idx].setValue(it->x, it->y, it->z);
     }
 
-    points->numPoints = cPts.size();
     coords->point.finishEditing();
 }
 
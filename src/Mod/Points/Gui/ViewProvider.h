@@ -59,6 +59,7 @@ class Feature;
 
 namespace PointsGui
 {
+class SoFCPointCloudLOD;
 
 class ViewProviderPointsBuilder: public Gui::ViewProviderBuilder
 {
@@ -68,6 +69,10 @@ public:
     void buildNodes(const App::Property*, std::vector<SoNode*>&) const override;
     void createPoints(const App::Property*, SoCoordinate3*, SoPointSet*) const;
     void createPoints(const App::Property*, SoCoordinate3*, SoIndexedPointSet*) const;
+    void createPoints(const App::Property*, SoCoordinate3*, SoFCPointCloudLOD*) const;
+
+private:
+    void createCoordinates(const App::Property*, SoCoordinate3*) const;
 };
 
 /**
@@ -142,7 +147,7 @@ protected:
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
 protected:
-    SoPointSet* pcPoints;
+    SoFCPointCloudLOD* pcPoints;
 };
 
 /**
@@ -170,7 +175,7 @@ protected:
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
 protected:
-    SoIndexedPointSet* pcPoints;
+    SoFCPointCloudLOD* pcPoints;
 };
 
 using ViewProviderPython = Gui::ViewProviderFeaturePythonT<ViewProviderScattered>;
@@ -0,0 +1,510 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Benchmarks of the document, mesh, point cloud and shape operations.
+#
+# Usage:
+#   FreeCADCmd benchmark.py <command> [options] [files ...]
+#   FreeCADCmd benchmark.py <command> --help
+#
+# Commands:
+#   part-format        saving and loading of Part shapes in text BRep and binary format
+#   expressions        recompute with and without skipping unchanged expression bindings
+#   mesh-import        import speed of binary STL, binary PLY and OBJ files
+#   mesh-bulk          transformation, area, volume and vertex normals of meshes
+#   mesh-smoothing     smoothing methods and point normals of meshes
+#   mesh-decimation    single-threaded and parallel decimation of meshes
+#   mesh-boolean       classic and corefinement mesh boolean operations
+#   mesh-document      saving and loading of meshes in the legacy and compact format
+#   points-ascii       import speed of ASCII point clouds
+#   points-processing  normal estimation and downsampling of point clouds
+#
+# Without input files the commands use synthetic models. A tessellated sphere
+# with a sampling of N has about 2 * N^2 triangles. The preferences changed by
+# a command are restored at the end.
+
+import argparse
+import contextlib
+import math
+import os
+import random
+import sys
+import tempfile
+import time
+
+import FreeCAD as App
+
+
+def timed(func, repeat=1):
+    """Returns the result of the last call of func and the mean time of a call."""
+    result = None
+    start = time.perf_counter()
+    for _ in range(repeat):
+        result = func()
+    return result, (time.perf_counter() - start) / repeat
+
+
+@contextlib.contextmanager
+def parameters(group, **values):
+    """Sets boolean and integer parameters of group and restores them afterwards."""
+    grp = App.ParamGet(group)
+    saved = []
+    for name, value in values.items():
+        kind = "Bool" if isinstance(value, bool) else "Int"
+        if name in getattr(grp, "Get" + kind + "s")():
+            saved.append((kind, name, getattr(grp, "Get" + kind)(name)))
+        else:
+            saved.append((kind, name, None))
+        getattr(grp, "Set" + kind)(name, value)
+    try:
+        yield
+    finally:
+        for kind, name, value in saved:
+            if value is None:
+                getattr(grp, "Rem" + kind)(name)
+            else:
+                getattr(grp, "Set" + kind)(name, value)
+
+
+def load_meshes(paths, sampling):
+    import Mesh
+
+    if paths:
+        return [(os.path.basename(path), Mesh.Mesh(path)) for path in paths]
+    return [("sphere", Mesh.createSphere(10.0, sampling))]
+
+
+def rate(count, elapsed):
+    return count / elapsed if elapsed > 0 else 0.0
+
+
+# ---------------------------------------------------------------------------
+
+
+def part_format(args):
+    import Part
+
+    def synthetic_model(count=40):
+        shapes = []
+        for i in range(count):
+            block = Part.makeBox(10, 10, 10, App.Vector(i * 12, 0, 0))
+            block = block.makeFillet(1.0, block.Edges)
+            for j in range(3):
+                hole = Part.makeCylinder(1.5, 10, App.Vector(i * 12 + 2.5 + j * 2.5, 5, 0))
+                block = block.cut(hole)
+            shapes.append(block)
+        return Part.makeCompound(shapes)
+
+    def measure(shape, binary, path):
+        save_time = load_time = 0.0
+        for _ in range(args.repeat):
+            doc = App.newDocument("ShapeFormatBench")
+            doc.BinaryBrep = binary
+            doc.addObject("Part::Feature", "Model").Shape = shape
+            _, elapsed = timed(lambda: doc.saveAs(path))
+            save_time += elapsed
+            App.closeDocument(doc.Name)
+
+            doc, elapsed = timed(lambda: App.openDocument(path))
+            doc.getObject("Model").Shape.isNull()
+            load_time += elapsed
+            App.closeDocument(doc.Name)
+        return save_time / args.repeat, load_time / args.repeat, os.path.getsize(path)
+
+    models = []
+    for path in args.files:
+        shape = Part.Shape()
+        shape.read(path)
+        models.append((os.path.basename(path), shape))
+    if not models:
+        models = [("synthetic", synthetic_model())]
+
+    print(
+        "{:<24} {:>6} {:>10} {:>10} {:>12}".format(
+            "model", "format", "save [s]", "load [s]", "size [KB]"
+        )
+    )
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "shape_format.FCStd")
+        for name, shape in models:
+            for binary in (False, True):
+                save, load, size = measure(shape, binary, path)
+                print(
+                    "{:<24} {:>6} {:>10.3f} {:>10.3f} {:>12.1f}".format(
+                        name[:24], "bin" if binary else "brep", save, load, size / 1024.0
+                    )
+                )
+
+
+def expressions(args):
+    # Half of the bindings of each object depend on a parameter object that
+    # changes before each recompute, the other half on one that does not.
+    doc = App.newDocument("ExpressionBench")
+    changing = doc.addObject("App::FeaturePython", "Changing")
+    static = doc.addObject("App::FeaturePython", "Static")
+    for params in (changing, static):
+        for i in range(args.bindings):
+            params.addProperty("App::PropertyLength", "P{}".format(i))
+            setattr(params, "P{}".format(i), i + 1)
+    for n in range(args.objects):
+        obj = doc.addObject("App::FeaturePython", "Obj{}".format(n))
+        for i in range(args.bindings):
+            name = "L{}".format(i)
+            obj.addProperty("App::PropertyLength", name)
+            params = "Changing" if i % 2 else "Static"
+            expression = "{0}.P{1} * 2 + {0}.P{1} / 3 + sin(30) * 1 mm".format(params, i)
+            obj.setExpression(name, expression)
+    doc.recompute()
+
+    def measure(skip):
+        group = "User parameter:BaseApp/Preferences/Document"
+        with parameters(group, SkipUnchangedExpressions=skip):
+            # warm up the caches
+            changing.P1 = changing.P1.Value + 1
+            doc.recompute()
+            elapsed = 0.0
+            for _ in range(args.repeat):
+                changing.P1 = changing.P1.Value + 1
+                elapsed += timed(doc.recompute)[1]
+            return elapsed / args.repeat
+
+    try:
+        full = measure(False)
+        skipped = measure(True)
+    finally:
+        App.closeDocument(doc.Name)
+
+    print("{} objects with {} bindings each".format(args.objects, args.bindings))
+    print("{:<28} {:>12}".format("evaluation", "recompute [s]"))
+    print("{:<28} {:>12.4f}".format("all bindings", full))
+    print("{:<28} {:>12.4f}".format("skip unchanged bindings", skipped))
+
+
+def mesh_import(args):
+    import Mesh
+
+    with tempfile.TemporaryDirectory() as directory:
+        paths = args.files
+        if not paths:
+            sphere = Mesh.createSphere(10.0, args.sampling)
+            paths = [os.path.join(directory, "sphere." + ext) for ext in ("stl", "ply", "obj")]
+            for path in paths:
+                sphere.write(path)
+
+        print("{:<32} {:>12} {:>10} {:>14}".format("file", "triangles", "load [s]", "triangles/s"))
+        for path in paths:
+            mesh, elapsed = timed(lambda: Mesh.Mesh(path), args.repeat)
+            print(
+                "{:<32} {:>12} {:>10.3f} {:>14.0f}".format(
+                    os.path.basename(path)[:32],
+                    mesh.CountFacets,
+                    elapsed,
+                    rate(mesh.CountFacets, elapsed),
+                )
+            )
+
+
+def mesh_bulk(args):
+    matrix = App.Matrix()
+    matrix.move(App.Vector(1, 2, 3))
+    matrix.rotateZ(0.1)
+
+    print(
+        "{:<24} {:>12} {:>12} {:>10} {:>10} {:>10}".format(
+            "mesh", "triangles", "transform", "area", "volume", "normals"
+        )
+    )
+    for name, mesh in load_meshes(args.files, args.sampling):
+        times = (
+            timed(lambda: mesh.transform(matrix), args.repeat)[1],
+            timed(lambda: mesh.Area, args.repeat)[1],
+            timed(lambda: mesh.Volume, args.repeat)[1],
+            timed(lambda: mesh.getPointNormals(), args.repeat)[1],
+        )
+        print(
+            "{:<24} {:>12} {:>10.2f}ms {:>8.2f}ms {:>8.2f}ms {:>8.2f}ms".format(
+                name[:24], mesh.CountFacets, *(t * 1000.0 for t in times)
+            )
+        )
+
+
+def mesh_smoothing(args):
+    methods = ("Laplace", "Taubin", "PlaneFit", "MedianFilter")
+
+    print(
+        "{:<24} {:>12} {:>10} {:>10} {:>10} {:>12} {:>10}".format(
+            "mesh", "points", *methods, "normals"
+        )
+    )
+    for name, mesh in load_meshes(args.files, args.sampling):
+        times = []
+        for method in methods:
+            # each method runs on a copy of the mesh
+            copy = mesh.copy()
+            smooth = lambda: copy.smooth(Method=method, Iteration=1, Jacobi=args.jacobi)
+            times.append(timed(smooth, args.repeat)[1])
+        times.append(timed(lambda: mesh.getPointNormals(), args.repeat)[1])
+        print(
+            "{:<24} {:>12} {:>8.1f}ms {:>8.1f}ms {:>8.1f}ms {:>10.1f}ms {:>8.1f}ms".format(
+                name[:24], mesh.CountPoints, *(t * 1000.0 for t in times)
+            )
+        )
+
+
+def mesh_decimation(args):
+    print(
+        "{:<24} {:>12} {:>10} {:>12} {:>10} {:>12}".format(
+            "mesh", "triangles", "serial", "triangles", "parallel", "triangles"
+        )
+    )
+    for name, mesh in load_meshes(args.files, args.sampling):
+        target = int(mesh.CountFacets * args.ratio)
+        serial = mesh.copy()
+        parallel = mesh.copy()
+        _, serial_time = timed(lambda: serial.decimate(target))
+        _, parallel_time = timed(lambda: parallel.decimate(target, args.error, math.radians(60)))
+        print(
+            "{:<24} {:>12} {:>9.2f}s {:>12} {:>9.2f}s {:>12}".format(
+                name[:24],
+                mesh.CountFacets,
+                serial_time,
+                serial.CountFacets,
+                parallel_time,
+                parallel.CountFacets,
+            )
+        )
+
+
+def mesh_boolean(args):
+    # Two overlapping spheres are measured with the samplings N/4, N/2 and N. A
+    # closed result has no open edges.
+    import Mesh
+
+    def open_edges(mesh):
+        return sum(1 for facet in mesh.Facets for index in facet.NeighbourIndices if index < 0)
+
+    print(
+        "{:>10} {:<12} {:<14} {:>10} {:>10} {:>12}".format(
+            "triangles", "operation", "algorithm", "time", "open", "volume"
+        )
+    )
+    for count in (args.sampling // 4, args.sampling // 2, args.sampling):
+        sphere1 = Mesh.createSphere(10.0, count)
+        sphere2 = Mesh.createSphere(10.0, count)
+        sphere2.translate(7.0, 3.0, 1.0)
+        for operation in ("unite", "intersect", "difference"):
+            for algorithm in ("Classic", "Corefinement"):
+                result, elapsed = timed(
+                    lambda: getattr(sphere1, operation)(sphere2, algorithm), args.repeat
+                )
+                print(
+                    "{:>10} {:<12} {:<14} {:>8.1f}ms {:>10} {:>12.3f}".format(
+                        sphere1.CountFacets,
+                        operation,
+                        algorithm,
+                        elapsed * 1000.0,
+                        open_edges(result),
+                        result.Volume,
+                    )
+                )
+
+
+def mesh_document(args):
+    # name, compact format, quantization bits, stored neighbours
+    modes = (
+        ("legacy", False, 0, True),
+        ("compact", True, 0, True),
+        ("compact rebuild", True, 0, False),
+        ("quantized 16", True, 16, True),
+    )
+
+    def measure(meshes, path):
+        doc = App.newDocument("MeshDocument")
+        for _, mesh in meshes:
+            doc.addObject("Mesh::Feature", "Mesh").Mesh = mesh
+        save = 0.0
+        for _ in range(args.repeat):
+            save += timed(lambda: doc.saveAs(path))[1]
+        App.closeDocument(doc.Name)
+
+        load = 0.0
+        for _ in range(args.repeat):
+            doc, elapsed = timed(lambda: App.openDocument(path))
+            load += elapsed
+            App.closeDocument(doc.Name)
+        return save / args.repeat, load / args.repeat, os.path.getsize(path)
+
+    meshes = load_meshes(args.files, args.sampling)
+    print(
+        "{} meshes with {} triangles".format(
+            len(meshes), sum(mesh.CountFacets for _, mesh in meshes)
+        )
+    )
+    print("{:<18} {:>10} {:>10} {:>12}".format("format", "save", "load", "size"))
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "meshes.FCStd")
+        for name, compact, bits, neighbours in modes:
+            with parameters(
+                "User parameter:BaseApp/Preferences/Mod/Mesh/Document",
+                CompactFormat=compact,
+                QuantizationBits=bits,
+                StoreNeighbours=neighbours,
+            ):
+                save, load, size = measure(meshes, path)
+            print(
+                "{:<18} {:>8.1f}ms {:>8.1f}ms {:>10.1f}MB".format(
+                    name, save * 1000.0, load * 1000.0, size / 1e6
+                )
+            )
+
+
+def points_ascii(args):
+    # Only Points.Points(path) is used, so the numbers of two builds can be
+    # compared directly. The synthetic file holds random x, y, z coordinates.
+    import Points
+
+    def write_synthetic_file(path):
+        rand = random.Random(0)
+        with open(path, "w") as file:
+            file.write("# synthetic point cloud\n")
+            block = 100000
+            for start in range(0, args.points, block):
+                lines = (
+                    "{:.6f} {:.6f} {:.6f}\n".format(
+                        rand.uniform(-1000.0, 1000.0),
+                        rand.uniform(-1000.0, 1000.0),
+                        rand.uniform(-1000.0, 1000.0),
+                    )
+                    for _ in range(min(block, args.points - start))
+                )
+                file.write("".join(lines))
+
+    with tempfile.TemporaryDirectory() as directory:
+        paths = args.files
+        if not paths:
+            paths = [os.path.join(directory, "cloud.asc")]
+            write_synthetic_file(paths[0])
+
+        print(
+            "{:<32} {:>12} {:>10} {:>10} {:>14} {:>10}".format(
+                "file", "points", "size [MB]", "load [s]", "points/s", "MB/s"
+            )
+        )
+        for path in paths:
+            size = os.path.getsize(path) / (1024.0 * 1024.0)
+            cloud, elapsed = timed(lambda: Points.Points(path), args.repeat)
+            print(
+                "{:<32} {:>12} {:>10.1f} {:>10.3f} {:>14.0f} {:>10.1f}".format(
+                    os.path.basename(path)[:32],
+                    cloud.CountPoints,
+                    size,
+                    elapsed,
+                    rate(cloud.CountPoints, elapsed),
+                    rate(size, elapsed),
+                )
+            )
+
+
+def points_processing(args):
+    # The synthetic cloud has random points on a sphere with a radius of 10. The
+    # voxel size and the Poisson disk radius are 1% of the diagonal of the
+    # bounding box of the points.
+    import Points
+
+    def sphere(count):
+        rand = random.Random(0)
+        cloud = Points.Points()
+        block = 100000
+        for start in range(0, count, block):
+            pts = []
+            for _ in range(min(block, count - start)):
+                z = rand.uniform(-1.0, 1.0)
+                phi = rand.uniform(0.0, 2.0 * math.pi)
+                r = math.sqrt(1.0 - z * z)
+                pts.append((10.0 * r * math.cos(phi), 10.0 * r * math.sin(phi), 10.0 * z))
+            cloud.addPoints(pts)
+        return cloud
+
+    if args.files:
+        clouds = [(os.path.basename(path), Points.Points(path)) for path in args.files]
+    else:
+        clouds = [("sphere", sphere(args.points))]
+
+    print(
+        "{:<24} {:>12} {:>10} {:>10} {:>17} {:>17}".format(
+            "cloud", "points", "normals", "oriented", "voxel grid", "poisson disk"
+        )
+    )
+    for name, cloud in clouds:
+        size = 0.01 * cloud.BoundBox.DiagonalLength
+        _, plain = timed(lambda: cloud.estimateNormals(args.neighbours, False))
+        _, oriented = timed(lambda: cloud.estimateNormals(args.neighbours, True))
+        voxels, voxel = timed(lambda: cloud.sampleVoxelGrid(size))
+        samples, poisson = timed(lambda: cloud.samplePoissonDisk(size))
+        print(
+            "{:<24} {:>12} {:>9.2f}s {:>9.2f}s {:>7.2f}s {:>8} {:>7.2f}s {:>8}".format(
+                name[:24],
+                cloud.CountPoints,
+                plain,
+                oriented,
+                voxel,
+                voxels.CountPoints,
+                poisson,
+                samples.CountPoints,
+            )
+        )
+
+
+# ---------------------------------------------------------------------------
+
+
+def make_parser():
+    parser = argparse.ArgumentParser(prog="benchmark.py")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    def add(name, func, help, repeat=3, sampling=None, files=True):
+        cmd = commands.add_parser(name, help=help)
+        cmd.set_defaults(func=func)
+        cmd.add_argument("--repeat", type=int, default=repeat)
+        if sampling:
+            cmd.add_argument("--sampling", type=int, default=sampling)
+        if files:
+            cmd.add_argument("files", nargs="*")
+        return cmd
+
+    add("part-format", part_format, "saving and loading of shapes in BRep and binary format")
+    cmd = add("expressions", expressions, "skipping unchanged expression bindings", 5, files=False)
+    cmd.add_argument("--objects", type=int, default=200)
+    cmd.add_argument("--bindings", type=int, default=20)
+    add("mesh-import", mesh_import, "import of STL, PLY and OBJ files", sampling=500)
+    add("mesh-bulk", mesh_bulk, "bulk operations of the mesh kernel", 5, sampling=1000)
+    cmd = add("mesh-smoothing", mesh_smoothing, "smoothing and point normals", sampling=1000)
+    cmd.add_argument("--jacobi", action="store_true", help="move the points on several threads")
+    cmd = add("mesh-decimation", mesh_decimation, "serial and parallel decimation", 1, 1000)
+    cmd.add_argument("--ratio", type=float, default=0.1)
+    cmd.add_argument("--error", type=float, default=0.01)
+    add("mesh-boolean", mesh_boolean, "mesh boolean algorithms", sampling=200, files=False)
+    add("mesh-document", mesh_document, "mesh document formats", sampling=1000)
+    cmd = add("points-ascii", points_ascii, "import of ASCII point clouds")
+    cmd.add_argument("--points", type=int, default=5000000)
+    cmd = add("points-processing", points_processing, "point cloud processing", 1)
+    cmd.add_argument("--points", type=int, default=1000000)
+    cmd.add_argument("--neighbours", type=int, default=10)
+    return parser
+
+
+def script_arguments():
+    # FreeCADCmd passes its own arguments and the path of the script first
+    script = os.path.basename(__file__)
+    for index, arg in enumerate(sys.argv):
+        if os.path.basename(arg) == script:
+            return sys.argv[index + 1 :]
+    return sys.argv[1:]
+
+
+def main():
+    args = make_parser().parse_args(script_arguments())
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
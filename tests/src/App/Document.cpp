@@ -5,6 +5,8 @@
 
 #include "App/Application.h"
 #include "App/Document.h"
+#include "App/FeatureTest.h"
+#include "App/RecomputeProfiler.h"
 #include "App/StringHasher.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
@@ -94,4 +96,227 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, parallelRecomputeMatchesSerialRecompute)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool oldValue = hGrp->GetBool("ParallelRecompute", false);
+    auto base = doc()->addObject<App::FeatureTestConcurrent>("Base");
+    auto left = doc()->addObject<App::FeatureTestConcurrent>("Left");
+    auto right = doc()->addObject<App::FeatureTestConcurrent>("Right");
+    auto top = doc()->addObject<App::FeatureTestConcurrent>("Top");
+    std::array<App::FeatureTestConcurrent*, 4> objs {base, left, right, top};
+    base->Input.setValue(1.0);
+    left->Source.setValue(base);
+    left->Input.setValue(2.0);
+    right->Source.setValue(base);
+    right->Input.setValue(3.0);
+    top->Source.setValue(left);
+    top->Input.setValue(4.0);
+    hGrp->SetBool("ParallelRecompute", true);
+
+    // Act
+    int parallelCount = doc()->recompute();
+    std::vector<double> parallelValues;
+    for (auto obj : objs) {
+        parallelValues.push_back(obj->Value.getValue());
+        obj->touch();
+    }
+    hGrp->SetBool("ParallelRecompute", false);
+    int serialCount = doc()->recompute();
+    hGrp->SetBool("ParallelRecompute", oldValue);
+
+    // Assert
+    EXPECT_EQ(parallelCount, 4);
+    EXPECT_EQ(serialCount, 4);
+    for (std::size_t i = 0; i < objs.size(); ++i) {
+        EXPECT_DOUBLE_EQ(parallelValues[i], objs[i]->Value.getValue());
+        EXPECT_FALSE(objs[i]->isTouched());
+    }
+    EXPECT_DOUBLE_EQ(top->Value.getValue(), 7.0);
+}
+
+TEST_F(DocumentTest, parallelRecomputeKeepsChangesInMainThread)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool oldValue = hGrp->GetBool("ParallelRecompute", false);
+    long oldThreads = hGrp->GetInt("RecomputeThreads", 0);
+    auto base = doc()->addObject<App::FeatureTestConcurrent>("Base");
+    auto left = doc()->addObject<App::FeatureTestConcurrent>("Left");
+    auto right = doc()->addObject<App::FeatureTestConcurrent>("Right");
+    base->Input.setValue(1.0);
+    left->Source.setValue(base);
+    left->Input.setValue(2.0);
+    right->Source.setValue(base);
+    right->Input.setValue(3.0);
+    std::vector<std::thread::id> changedBy;
+    boost::signals2::scoped_connection conn = doc()->signalChangedObject.connect(
+        [&changedBy](const App::DocumentObject& /*obj*/, const App::Property& /*prop*/) {
+            changedBy.push_back(std::this_thread::get_id());
+        });
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+
+    // Act
+    int count = doc()->recompute();
+    hGrp->SetBool("ParallelRecompute", oldValue);
+    hGrp->SetInt("RecomputeThreads", oldThreads);
+
+    // Assert
+    EXPECT_EQ(count, 3);
+    EXPECT_DOUBLE_EQ(left->Value.getValue(), 3.0);
+    EXPECT_DOUBLE_EQ(right->Value.getValue(), 4.0);
+    for (auto obj : {base, left, right}) {
+        EXPECT_TRUE(obj->Prepared.getValue());
+        EXPECT_NE(obj->preparedBy, std::this_thread::get_id());
+        EXPECT_FALSE(obj->isTouched());
+    }
+    EXPECT_FALSE(changedBy.empty());
+    for (auto id : changedBy) {
+        EXPECT_EQ(id, std::this_thread::get_id());
+    }
+}
+
+TEST_F(DocumentTest, recomputeReusesDependencyCacheForTouchedCone)
+{
+    // Arrange
+    auto base = doc()->addObject<App::FeatureTest>("Base");
+    auto child = doc()->addObject<App::FeatureTest>("Child");
+    auto other = doc()->addObject<App::FeatureTest>("Other");
+    child->Source1.setValue(base);
+    doc()->recompute();
+    auto misses = doc()->getDependencyCacheStats().misses;
+
+    // Act
+    base->touch();
+    int count = doc()->recompute();
+
+    // Assert
+    const auto& stats = doc()->getDependencyCacheStats();
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(stats.misses, misses);
+    EXPECT_EQ(stats.lastRecomputeSize, 2);
+    EXPECT_EQ(other->ExecCount.getValue(), 1);
+    EXPECT_EQ(child->ExecCount.getValue(), 2);
+}
+
+TEST_F(DocumentTest, recomputeSchedulesObjectsTouchedDuringRecompute)
+{
+    // Arrange
+    auto base = doc()->addObject<App::FeatureTest>("Base");
+    auto other = doc()->addObject<App::FeatureTest>("Other");
+    doc()->recompute();
+    bool touched = false;
+    boost::signals2::scoped_connection conn = doc()->signalRecomputedObject.connect(
+        [&](const App::DocumentObject& obj) {
+            if (&obj == base && !touched) {
+                touched = true;
+                other->enforceRecompute();
+            }
+        });
+
+    // Act
+    base->touch();
+    int count = doc()->recompute();
+
+    // Assert
+    EXPECT_TRUE(touched);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(base->ExecCount.getValue(), 2);
+    EXPECT_EQ(other->ExecCount.getValue(), 2);
+    EXPECT_FALSE(other->isTouched());
+}
+
+TEST_F(DocumentTest, dependencyCacheIgnoresChangesOfOtherDocuments)
+{
+    // Arrange
+    auto base = doc()->addObject<App::FeatureTest>("Base");
+    auto child = doc()->addObject<App::FeatureTest>("Child");
+    child->Source1.setValue(base);
+    doc()->recompute();
+    std::string otherName = App::GetApplication().getUniqueDocumentName("other");
+    auto other = App::GetApplication().newDocument(otherName.c_str(), "testUser");
+    auto first = other->addObject<App::FeatureTest>("First");
+    auto second = other->addObject<App::FeatureTest>("Second");
+    auto misses = doc()->getDependencyCacheStats().misses;
+
+    // Act
+    second->Source1.setValue(first);
+    base->touch();
+    doc()->recompute();
+    auto stats = doc()->getDependencyCacheStats();
+    App::GetApplication().closeDocument(otherName.c_str());
+
+    // Assert
+    EXPECT_EQ(stats.misses, misses);
+    EXPECT_EQ(child->ExecCount.getValue(), 2);
+}
+
+TEST_F(DocumentTest, dependencyCachePatchesChangedLinks)
+{
+    // Arrange
+    auto first = doc()->addObject<App::FeatureTest>("First");
+    auto second = doc()->addObject<App::FeatureTest>("Second");
+    auto third = doc()->addObject<App::FeatureTest>("Third");
+    second->Source1.setValue(first);
+    doc()->recompute();
+    auto misses = doc()->getDependencyCacheStats().misses;
+    auto patches = doc()->getDependencyCacheStats().patches;
+    std::vector<const App::DocumentObject*> order;
+    boost::signals2::scoped_connection conn = doc()->signalRecomputedObject.connect(
+        [&order](const App::DocumentObject& obj) {
+            order.push_back(&obj);
+        });
+
+    // Act: in both directions the new link may contradict the cached order
+    first->Source1.setValue(third);
+    second->Source1.setValue(nullptr);
+    third->Source2.setValue(second);
+    for (auto obj : {first, second, third}) {
+        obj->touch();
+    }
+    int count = doc()->recompute();
+
+    // Assert
+    const auto& stats = doc()->getDependencyCacheStats();
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(stats.misses, misses);
+    EXPECT_GT(stats.patches, patches);
+    std::vector<const App::DocumentObject*> expected {second, third, first};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(DocumentTest, recomputeProfileRecordsCriticalPath)
+{
+    // Arrange
+    auto base = doc()->addObject<App::FeatureTest>("Base");
+    auto child = doc()->addObject<App::FeatureTest>("Child");
+    auto grandchild = doc()->addObject<App::FeatureTest>("Grandchild");
+    child->Source1.setValue(base);
+    grandchild->Source1.setValue(child);
+    doc()->recompute();
+    doc()->setRecomputeProfiling(true);
+
+    // Act
+    base->Integer.setValue(1);
+    doc()->recompute();
+    doc()->setRecomputeProfiling(false);
+
+    // Assert
+    const auto& profiler = doc()->getRecomputeProfiler();
+    const auto& entries = profiler.getEntries();
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[0].name, "Base");
+    EXPECT_EQ(entries[0].reason, "Changed: Integer");
+    EXPECT_EQ(entries[1].reason, "Enforced");
+    EXPECT_THAT(profiler.getCriticalPath(), testing::ElementsAre("Base", "Child", "Grandchild"));
+    EXPECT_GE(profiler.getTotalTime(), profiler.getCriticalPathTime());
+    std::stringstream json;
+    profiler.exportChromeTrace(json);
+    EXPECT_THAT(json.str(), testing::HasSubstr("\"traceEvents\""));
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -2,8 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 #include <App/Application.h>
+#include <App/CompactElementMap.h>
 #include <App/ElementMap.h>
+#include <Base/FileInfo.h>
 #include <src/App/InitApplication.h>
 
 // NOLINTBEGIN(readability-magic-numbers)
@@ -326,6 +330,108 @@ TEST_F(ElementMapTest, findAll)
     EXPECT_EQ(findResult2[1].first, anotherMappedName2);
 }
 
+TEST_F(ElementMapTest, restoreSharesPostfixes)
+{
+    // Arrange
+    auto elementMap = std::make_shared<Data::ElementMap>();
+    Data::MappedName name1("Edge1");
+    Data::MappedName name2("Edge2");
+    name1 += ";:M;FUS;:H1:7,F";
+    name2 += ";:M;FUS;:H1:7,F";
+    elementMap->setElementName(Data::IndexedName("Face", 1), name1, 1);
+    elementMap->setElementName(Data::IndexedName("Face", 2), name2, 1);
+    std::stringstream stream;
+    elementMap->beforeSave(_hasher);
+    elementMap->save(stream);
+
+    // Act
+    auto restored = std::make_shared<Data::ElementMap>()->restore(_hasher, stream);
+    auto restored1 = restored->find(Data::IndexedName("Face", 1));
+    auto restored2 = restored->find(Data::IndexedName("Face", 2));
+
+    // Assert
+    EXPECT_EQ(restored->size(), 2);
+    EXPECT_EQ(restored1, name1);
+    EXPECT_EQ(restored2, name2);
+    EXPECT_EQ(restored->find(name2), Data::IndexedName("Face", 2));
+    EXPECT_EQ(restored1.postfixBytes().constData(), restored2.postfixBytes().constData());
+}
+
+TEST_F(ElementMapTest, compactElementMapLookup)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    elementMap.hasher = _hasher;
+    Data::ElementIDRefs sids;
+    sids.push_back(_hasher->getID("Edge7;:M;FUS"));
+    Data::MappedName edgeName("Edge7");
+    edgeName += ";:M;FUS";
+    elementMap.setElementName(Data::IndexedName("Face", 1), Data::MappedName("Face1;:H1,F"), 1);
+    elementMap.setElementName(Data::IndexedName("Face", 1), Data::MappedName("Face1;:H2,F"), 1);
+    elementMap.setElementName(Data::IndexedName("Face", 3), edgeName, 1, &sids);
+    elementMap.setElementName(Data::IndexedName("Edge", 2), Data::MappedName("Edge2;:G"), 1);
+
+    // Act
+    Data::CompactElementMap compact(elementMap);
+    Data::ElementIDRefs foundSids;
+    auto face3 = compact.find(Data::MappedName("Edge7;:M;FUS"), &foundSids);
+    auto face1Names = compact.findAll(Data::IndexedName("Face", 1));
+
+    // Assert
+    EXPECT_EQ(compact.size(), elementMap.size());
+    EXPECT_EQ(face3, Data::IndexedName("Face", 3));
+    ASSERT_EQ(foundSids.size(), 1);
+    EXPECT_EQ(foundSids[0].value(), sids[0].value());
+    EXPECT_EQ(compact.find(edgeName), Data::IndexedName("Face", 3));
+    EXPECT_FALSE(compact.find(Data::MappedName("Edge7;:M;FU")));
+    EXPECT_EQ(compact.find(Data::IndexedName("Face", 1)), Data::MappedName("Face1;:H1,F"));
+    EXPECT_FALSE(compact.find(Data::IndexedName("Face", 2)));
+    EXPECT_FALSE(compact.find(Data::IndexedName("Face", 4)));
+    EXPECT_FALSE(compact.find(Data::IndexedName("Wire", 1)));
+    ASSERT_EQ(face1Names.size(), 2);
+    EXPECT_EQ(face1Names[0].first, Data::MappedName("Face1;:H1,F"));
+    EXPECT_EQ(face1Names[1].first, Data::MappedName("Face1;:H2,F"));
+}
+
+TEST_F(ElementMapTest, compactElementMapSaveAndMapFile)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    for (int i = 1; i <= 100; ++i) {
+        Data::MappedName name("Edge" + std::to_string(i));
+        name += ";:M;FUS";
+        elementMap.setElementName(Data::IndexedName("Face", i), name, 1);
+    }
+    Data::CompactElementMap compact(elementMap);
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    {
+        std::ofstream file(fi.filePath(), std::ios::binary);
+        file << "Header00";
+        compact.save(file);
+    }
+
+    // Act
+    auto mapped = std::make_unique<Data::CompactElementMap>();
+    mapped->restore(fi.filePath(), 8);
+    auto restored = mapped->toElementMap(1);
+    Data::CompactElementMap invalid;
+
+    // Assert
+    EXPECT_TRUE(mapped->isMapped());
+    EXPECT_EQ(mapped->blockSize(), compact.blockSize());
+    EXPECT_EQ(mapped->size(), 100);
+    EXPECT_EQ(mapped->find(Data::MappedName("Edge42;:M;FUS")), Data::IndexedName("Face", 42));
+    EXPECT_EQ(mapped->find(Data::IndexedName("Face", 7)), Data::MappedName("Edge7;:M;FUS"));
+    EXPECT_EQ(restored->size(), 100);
+    EXPECT_EQ(restored->find(Data::IndexedName("Face", 100)), Data::MappedName("Edge100;:M;FUS"));
+    EXPECT_THROW(invalid.restore(fi.filePath(), 3), Base::RuntimeError);
+    EXPECT_TRUE(invalid.empty());
+
+    // Clean up
+    mapped.reset();
+    fi.deleteFile();
+}
+
 TEST_F(ElementMapTest, mimicOnePart)
 {
     // Arrange
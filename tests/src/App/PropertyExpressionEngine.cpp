@@ -6,8 +6,10 @@
 #include "App/Document.h"
 #include "App/DocumentObject.h"
 #include "App/Expression.h"
+#include "App/Link.h"
 #include "App/ObjectIdentifier.h"
 #include "App/PropertyExpressionEngine.h"
+#include "App/PropertyUnits.h"
 
 #include "src/App/InitApplication.h"
 
@@ -90,4 +92,89 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeReevaluatesChangedBindings)
+{
+    auto source_obj = this_doc()->addObject("App::FeatureTest", "Source");
+    auto source = static_cast<App::PropertyLength*>(source_obj->addDynamicProperty("App::PropertyLength", "Width"));
+    auto target = static_cast<App::PropertyLength*>(target_prop());
+    source->setValue(2.0);
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "Source.Width * 2"));
+    this_obj()->setExpression(target_path, target_rule);
+
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 4.0);
+
+    // the input changed
+    source->setValue(3.0);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 6.0);
+
+    // the bound property was changed directly, the binding takes over again
+    target->setValue(10.0);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 6.0);
+
+    // nothing changed
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 6.0);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterInputWasDeleted)
+{
+    auto source_obj = this_doc()->addObject("App::FeatureTest", "Source");
+    auto source = static_cast<App::PropertyLength*>(source_obj->addDynamicProperty("App::PropertyLength", "Width"));
+    auto target = static_cast<App::PropertyLength*>(target_prop());
+    source->setValue(2.0);
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "Source.Width * 2"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj()->ExpressionEngine.execute();
+
+    // the cached evaluation must not refer to the deleted object, so the
+    // binding is evaluated again and fails
+    this_doc()->removeObject("Source");
+    EXPECT_THROW(this_obj()->ExpressionEngine.execute(), Base::Exception);
+    EXPECT_DOUBLE_EQ(target->getValue(), 4.0);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeReevaluatesBindingsReadThroughLinks)
+{
+    auto source_obj = this_doc()->addObject("App::FeatureTest", "Source");
+    auto source = static_cast<App::PropertyLength*>(source_obj->addDynamicProperty("App::PropertyLength", "Width"));
+    auto other_obj = this_doc()->addObject("App::FeatureTest", "Other");
+    auto other = static_cast<App::PropertyLength*>(other_obj->addDynamicProperty("App::PropertyLength", "Width"));
+    auto link = static_cast<App::Link*>(this_doc()->addObject("App::Link", "Link"));
+    auto target = static_cast<App::PropertyLength*>(target_prop());
+    source->setValue(2.0);
+    other->setValue(5.0);
+    link->LinkedObject.setValue(source_obj);
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "Link.LinkedObject.Width * 2"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 4.0);
+
+    // the linked object changed, the link itself did not
+    source->setValue(3.0);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 6.0);
+
+    // the link points to another object
+    link->LinkedObject.setValue(other_obj);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 10.0);
+
+    // the former linked object is no input anymore, the new one is
+    source->setValue(4.0);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 10.0);
+    other->setValue(6.0);
+    this_obj()->ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(target->getValue(), 12.0);
+}
+
 // clang-format on
@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <zipios++/zipinputstream.h>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +133,105 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+class ZipEntryData: public Base::Persistence
+{
+public:
+    ZipEntryData(std::string data, bool concurrent)
+        : data {std::move(data)}
+        , concurrent {concurrent}
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(data.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << data;
+    }
+    bool canSaveDocFileConcurrently() const override
+    {
+        return concurrent;
+    }
+
+private:
+    std::string data;
+    bool concurrent;
+};
+
+TEST(ZipWriterTest, concurrentWriteFilesKeepsOrderAndContent)
+{
+    // Arrange
+    std::stringstream buffer;
+    std::vector<std::unique_ptr<ZipEntryData>> objects;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 10; ++i) {
+        contents.emplace_back(1000 * (i + 1), static_cast<char>('a' + i));
+        objects.push_back(std::make_unique<ZipEntryData>(contents.back(), i % 2 == 0));
+    }
+
+    // Act
+    {
+        Base::ZipWriter writer(buffer);
+        writer.setThreadCount(4);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            writer.addFile(("File" + std::to_string(i) + ".bin").c_str(), objects[i].get());
+        }
+        writer.writeFiles();
+    }
+
+    // Assert
+    zipios::ZipInputStream zip(buffer);
+    std::string document((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(document, "<Document/>");
+    for (std::size_t i = 0; i < contents.size(); ++i) {
+        auto entry = zip.getNextEntry();
+        ASSERT_TRUE(entry->isValid());
+        EXPECT_EQ(entry->getName(), "File" + std::to_string(i) + ".bin");
+        std::string data((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(data, contents[i]);
+    }
+}
+
+TEST(ZipWriterTest, concurrentWriteFilesWithSmallBufferKeepsOrder)
+{
+    // Arrange
+    std::stringstream buffer;
+    std::vector<std::unique_ptr<ZipEntryData>> objects;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 40; ++i) {
+        contents.emplace_back(100 * (i + 1), static_cast<char>('A' + i % 26));
+        objects.push_back(std::make_unique<ZipEntryData>(contents.back(), i % 3 != 0));
+    }
+
+    // Act
+    {
+        Base::ZipWriter writer(buffer);
+        writer.setThreadCount(3);
+        writer.setMaxBufferSize(1);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            writer.addFile(("File" + std::to_string(i) + ".bin").c_str(), objects[i].get());
+        }
+        writer.writeFiles();
+    }
+
+    // Assert
+    zipios::ZipInputStream zip(buffer);
+    std::string document((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(document, "<Document/>");
+    for (std::size_t i = 0; i < contents.size(); ++i) {
+        auto entry = zip.getNextEntry();
+        ASSERT_TRUE(entry->isValid());
+        EXPECT_EQ(entry->getName(), "File" + std::to_string(i) + ".bin");
+        std::string data((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(data, contents[i]);
+    }
+}
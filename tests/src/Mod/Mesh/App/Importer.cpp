@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/OutOfCore.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
@@ -37,4 +40,169 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountEdges(), 1950);
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
+
+TEST_F(ImporterTest, TestMappedBinarySTL)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    for (int i = 0; i < 10; i++) {
+        Base::Vector3f p1(float(i), 0, 0);
+        Base::Vector3f p2(float(i + 1), 0, 0);
+        Base::Vector3f p3(float(i), 1, 0);
+        Base::Vector3f p4(float(i + 1), 1, 0);
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+    }
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    MeshCore::MeshOutput output(kernel);
+    EXPECT_TRUE(output.SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::BSTL));
+
+    // Act
+    MeshCore::MeshKernel mapped;
+    MeshCore::MeshInput mappedInput(mapped);
+    bool ok = mappedInput.LoadMappedBinarySTL(fi.filePath().c_str());
+
+    MeshCore::MeshKernel streamed;
+    MeshCore::MeshInput streamedInput(streamed);
+    Base::ifstream str(fi, std::ios::in | std::ios::binary);
+    streamedInput.LoadBinarySTL(str);
+    str.close();
+    fi.deleteFile();
+
+    // Assert
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(mapped.CountPoints(), 22);
+    EXPECT_EQ(mapped.CountFacets(), 20);
+    EXPECT_EQ(mapped.CountPoints(), streamed.CountPoints());
+    EXPECT_EQ(mapped.CountFacets(), streamed.CountFacets());
+    // the points of a facet are read in the order 3, 1, 2
+    EXPECT_EQ(streamed.GetFacet(0)._aclPoints[0], Base::Vector3f(0, 1, 0));
+    EXPECT_EQ(streamed.GetFacet(0)._aclPoints[1], Base::Vector3f(0, 0, 0));
+    for (std::size_t i = 0; i < mapped.CountPoints(); i++) {
+        EXPECT_EQ(Base::Vector3f(mapped.GetPoint(i)), Base::Vector3f(streamed.GetPoint(i)));
+    }
+    for (std::size_t i = 0; i < mapped.CountFacets(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(mapped.GetFacets()[i]._aulPoints[j], streamed.GetFacets()[i]._aulPoints[j]);
+        }
+    }
+}
+
+TEST_F(ImporterTest, TestMappedAsciiSTL)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(0, 1, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 1, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(1, 1, 0)));
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    MeshCore::MeshOutput output(kernel);
+    EXPECT_TRUE(output.SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::ASTL));
+
+    // Act
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    bool mapped = input.LoadMappedBinarySTL(fi.filePath().c_str());
+    bool loaded = input.LoadAny(fi.filePath().c_str());
+    fi.deleteFile();
+
+    // Assert
+    EXPECT_FALSE(mapped);
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(mesh.CountPoints(), 4);
+    EXPECT_EQ(mesh.CountFacets(), 2);
+}
+
+TEST_F(ImporterTest, TestOutOfCore)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    for (int i = 0; i < 100; i++) {
+        Base::Vector3f p1(float(i), 0, 0);
+        Base::Vector3f p2(float(i + 1), 0, 0);
+        Base::Vector3f p3(float(i), 1, 0);
+        Base::Vector3f p4(float(i + 1), 1, 0);
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+    }
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    MeshCore::MeshOutput output(kernel);
+    EXPECT_TRUE(output.SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::BSTL));
+    Base::FileInfo ply(Base::FileInfo::getTempFileName() + ".ply");
+
+    // Act
+    unsigned long numChunks {};
+    unsigned long numOpenEdges {};
+    unsigned long numFacets {};
+    {
+        MeshCore::MeshOutOfCore outOfCore(fi.filePath(), 50);
+        numChunks = outOfCore.CountChunks();
+        numOpenEdges = outOfCore.CountOpenEdges();
+        numFacets = outOfCore.CountFacets();
+        outOfCore.Export(ply.filePath());
+    }
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    bool loaded = input.LoadAny(ply.filePath().c_str());
+    fi.deleteFile();
+    ply.deleteFile();
+
+    // Assert
+    EXPECT_EQ(numChunks, 4);
+    EXPECT_EQ(numOpenEdges, 202);
+    EXPECT_EQ(numFacets, 200);
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(mesh.CountPoints(), 202);
+    EXPECT_EQ(mesh.CountFacets(), 200);
+}
+
+TEST_F(ImporterTest, TestOutOfCoreThinChunks)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    for (int i = 0; i < 100; i++) {
+        Base::Vector3f p1(float(i), 0, 0);
+        Base::Vector3f p2(float(i + 1), 0, 0);
+        Base::Vector3f p3(float(i), 1, 0);
+        Base::Vector3f p4(float(i + 1), 1, 0);
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+        kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+    }
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    MeshCore::MeshOutput output(kernel);
+    EXPECT_TRUE(output.SaveAny(fi.filePath().c_str(), MeshCore::MeshIO::BSTL));
+    Base::FileInfo ply(Base::FileInfo::getTempFileName() + ".ply");
+
+    // Act
+    // the chunks are thinner than the edges, so the halo must reach beyond the adjacent chunks
+    unsigned long numChunks {};
+    unsigned long numOpenEdges {};
+    {
+        MeshCore::MeshOutOfCore outOfCore(fi.filePath(), 2);
+        numChunks = outOfCore.CountChunks();
+        numOpenEdges = outOfCore.CountOpenEdges();
+        outOfCore.Export(ply.filePath());
+    }
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshInput input(mesh);
+    bool loaded = input.LoadAny(ply.filePath().c_str());
+    fi.deleteFile();
+    ply.deleteFile();
+
+    // Assert
+    EXPECT_EQ(numChunks, 100);
+    EXPECT_EQ(numOpenEdges, 202);
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(mesh.CountPoints(), 202);
+    EXPECT_EQ(mesh.CountFacets(), 200);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,8 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
 #include <gtest/gtest.h>
 #include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/IO/CompactFormat.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+namespace
+{
+MeshCore::MeshKernel makeBox(const Base::Vector3f& min, const Base::Vector3f& max)
+{
+    MeshCore::MeshPointArray points;
+    for (int i = 0; i < 8; i++) {
+        points.push_back(Base::Vector3f(i & 1 ? max.x : min.x,
+                                        i & 2 ? max.y : min.y,
+                                        i & 4 ? max.z : min.z));
+    }
+    const int quads[6][4] = {{0, 2, 3, 1},
+                             {4, 5, 7, 6},
+                             {0, 1, 5, 4},
+                             {2, 6, 7, 3},
+                             {0, 4, 6, 2},
+                             {1, 3, 7, 5}};
+    MeshCore::MeshFacetArray facets;
+    for (const auto& quad : quads) {
+        facets.push_back(MeshCore::MeshFacet(quad[0], quad[1], quad[2]));
+        facets.push_back(MeshCore::MeshFacet(quad[0], quad[2], quad[3]));
+    }
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+
+/// Returns a grid of size x size squares in the xy plane, point (i, j) is lifted by height(i, j)
+template<class Func>
+MeshCore::MeshKernel makeGrid(int size, Func height)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (int i = 0; i <= size; i++) {
+        for (int j = 0; j <= size; j++) {
+            points.push_back(Base::Vector3f(float(i), float(j), float(height(i, j))));
+        }
+    }
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            MeshCore::PointIndex p0 = i * (size + 1) + j;
+            MeshCore::PointIndex p1 = p0 + size + 1;
+            facets.push_back(MeshCore::MeshFacet(p0, p1, p0 + 1));
+            facets.push_back(MeshCore::MeshFacet(p0 + 1, p1, p1 + 1));
+        }
+    }
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+
+unsigned long countOpenEdges(const MeshCore::MeshKernel& kernel)
+{
+    unsigned long openEdges = 0;
+    for (const auto& facet : kernel.GetFacets()) {
+        for (MeshCore::FacetIndex neighbour : facet._aulNeighbours) {
+            if (neighbour == MeshCore::FACET_INDEX_MAX) {
+                openEdges++;
+            }
+        }
+    }
+    return openEdges;
+}
+
+float booleanVolume(const MeshCore::MeshKernel& mesh1,
+                    const MeshCore::MeshKernel& mesh2,
+                    MeshCore::SetOperations::OperationType type)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::MeshBoolean boolOp(mesh1, mesh2, result, type);
+    boolOp.Do();
+    EXPECT_EQ(countOpenEdges(result), 0);
+    return result.GetVolume();
+}
+
+bool sameFacets(const MeshCore::MeshKernel& mesh1, const MeshCore::MeshKernel& mesh2)
+{
+    return std::ranges::equal(mesh1.GetFacets(),
+                              mesh2.GetFacets(),
+                              [](const MeshCore::MeshFacet& f1, const MeshCore::MeshFacet& f2) {
+                                  return std::ranges::equal(f1._aulPoints, f2._aulPoints)
+                                      && std::ranges::equal(f1._aulNeighbours, f2._aulNeighbours);
+                              });
+}
+}  // namespace
+
 TEST(MeshTest, TestDefault)
 {
     MeshCore::MeshKernel kernel;
@@ -95,4 +190,354 @@ TEST(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+
+TEST(MeshTest, TestBulkOperations)
+{
+    Base::Vector3f p0 {0, 0, 0};
+    Base::Vector3f p1 {1, 0, 0};
+    Base::Vector3f p2 {0, 1, 0};
+    Base::Vector3f p3 {0, 0, 1};
+    MeshCore::MeshKernel kernel;
+    kernel = std::vector<MeshCore::MeshGeomFacet> {MeshCore::MeshGeomFacet(p0, p2, p1),
+                                                   MeshCore::MeshGeomFacet(p0, p1, p3),
+                                                   MeshCore::MeshGeomFacet(p0, p3, p2),
+                                                   MeshCore::MeshGeomFacet(p1, p2, p3)};
+
+    EXPECT_FLOAT_EQ(kernel.GetSurface(), 1.5F + std::sqrt(3.0F) / 2.0F);
+    EXPECT_FLOAT_EQ(kernel.GetVolume(), 1.0F / 6.0F);
+
+    std::vector<Base::Vector3f> normals = kernel.CalcVertexNormals();
+    ASSERT_EQ(normals.size(), 4);
+    for (MeshCore::PointIndex i = 0; i < 4; i++) {
+        if (kernel.GetPoint(i) == p0) {
+            EXPECT_EQ(normals[i], Base::Vector3f(-1, -1, -1));
+        }
+        EXPECT_EQ(kernel.CalcVertexNormal(i), normals[i]);
+    }
+
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3f(1, 2, 3));
+    kernel.Transform(mat);
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 1.0F);
+    EXPECT_FLOAT_EQ(box.MinY, 2.0F);
+    EXPECT_FLOAT_EQ(box.MinZ, 3.0F);
+    EXPECT_FLOAT_EQ(box.MaxX, 2.0F);
+    EXPECT_FLOAT_EQ(box.MaxY, 3.0F);
+    EXPECT_FLOAT_EQ(box.MaxZ, 4.0F);
+}
+
+TEST(MeshTest, TestParallelDecimation)
+{
+    // a planar grid large enough to be split into several blocks
+    const int size = 400;
+    MeshCore::MeshKernel kernel = makeGrid(size, [](int, int) {
+        return 0.0F;
+    });
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplifyParallel(int(kernel.CountFacets() / 10), 0.01F, 0.5F);
+
+    unsigned long openEdges = countOpenEdges(kernel);
+
+    // the boundary is simplified, too, but keeps its shape
+    EXPECT_LE(kernel.CountFacets(), 2 * size * size / 10 + size);
+    EXPECT_LT(openEdges, 4 * size);
+    EXPECT_NEAR(kernel.GetSurface(), float(size * size), 0.1F);
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().LengthX(), float(size));
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().LengthY(), float(size));
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().LengthZ(), 0.0F);
+}
+
+TEST(MeshTest, TestParallelDecimationKeepsSharpEdges)
+{
+    // a roof with a ridge of 90 degrees along the middle of the grid
+    const int size = 400;
+    MeshCore::MeshKernel kernel = makeGrid(size, [](int i, int) {
+        return std::abs(i - size / 2);
+    });
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplifyParallel(int(kernel.CountFacets() / 10), 0.01F, 0.5F);
+
+    EXPECT_LE(kernel.CountFacets(), 2 * size * size / 10 + size);
+    EXPECT_NEAR(kernel.GetSurface(), std::sqrt(2.0F) * float(size * size), 1.0F);
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().LengthZ(), float(size / 2));
+}
+
+TEST(MeshTest, TestSelfIntersections)
+{
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(2, 0, 0),
+                                            Base::Vector3f(0, 2, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0.5F, 0.5F, -1),
+                                            Base::Vector3f(0.5F, 0.5F, 1),
+                                            Base::Vector3f(0.5F, 1.2F, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(5, 5, 5),
+                                            Base::Vector3f(6, 5, 5),
+                                            Base::Vector3f(5, 6, 5)));
+
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+
+    EXPECT_TRUE(kernel.HasSelfIntersections());
+    // a pair is reported for each grid cell that contains both facets
+    EXPECT_FALSE(pairs.empty());
+    for (const auto& pair : pairs) {
+        EXPECT_EQ(pair.first, 0);
+        EXPECT_EQ(pair.second, 1);
+    }
+}
+
+TEST(MeshTest, TestNoSelfIntersections)
+{
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(0, 1, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 1, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(1, 1, 0)));
+
+    MeshCore::MeshEvalSelfIntersection eval(kernel);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs;
+    eval.GetIntersections(pairs);
+
+    EXPECT_FALSE(kernel.HasSelfIntersections());
+    EXPECT_TRUE(pairs.empty());
+}
+
+TEST(MeshTest, TestQueriesAfterModification)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(0, 1, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 1, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(1, 1, 0)));
+    Mesh::MeshObject mesh(kernel);
+    Mesh::MeshObject::TRay ray(Base::Vector3d(0.25, 0.25, -1), Base::Vector3d(0, 0, 1));
+    std::size_t before = mesh.foraminate(ray, std::numbers::pi / 2).size();
+
+    // Act: the grid used by the queries must follow the kernel, also if it is modified
+    // through a reference obtained before the grid was built
+    MeshCore::MeshKernel& ref = mesh.getKernel();
+    std::size_t unchanged = mesh.foraminate(ray, std::numbers::pi / 2).size();
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(10, 0, 0));
+    ref.Transform(mat);
+    std::size_t after = mesh.foraminate(ray, std::numbers::pi / 2).size();
+
+    ray.first.x = 10.25;
+    Mesh::MeshObject::TFaceSection section;
+    bool found = mesh.nearestFacetOnRay(ray, std::numbers::pi / 2, section);
+
+    // Assert
+    EXPECT_EQ(before, 1);
+    EXPECT_EQ(unchanged, 1);
+    EXPECT_EQ(after, 0);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(section.first, 0);
+    EXPECT_DOUBLE_EQ(section.second.x, 10.25);
+    EXPECT_DOUBLE_EQ(section.second.z, 0.0);
+}
+
+TEST(MeshTest, TestQueriesAfterMovingPoints)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(0, 1, 0)));
+    Mesh::MeshObject mesh(kernel);
+    Mesh::MeshObject::TRay ray(Base::Vector3d(10.25, 0.25, -1), Base::Vector3d(0, 0, 1));
+    std::size_t before = mesh.foraminate(ray, std::numbers::pi / 2).size();
+
+    // Act
+    MeshCore::MeshKernel& ref = mesh.getKernel();
+    for (MeshCore::PointIndex i = 0; i < ref.CountPoints(); i++) {
+        ref.MovePoint(i, Base::Vector3f(10, 0, 0));
+    }
+    std::size_t after = mesh.foraminate(ray, std::numbers::pi / 2).size();
+
+    // Assert
+    EXPECT_EQ(before, 0);
+    EXPECT_EQ(after, 1);
+}
+
+TEST(MeshTest, TestCrossSectionsOfScaledMesh)
+{
+    // Arrange
+    MeshCore::MeshKernel kernel;
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(0, 1, 0)));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 1, 0),
+                                            Base::Vector3f(1, 0, 0),
+                                            Base::Vector3f(1, 1, 0)));
+    Base::Matrix4D mat;
+    mat.scale(Base::Vector3d(2, 4, 1));
+    Mesh::MeshObject mesh(kernel, mat);
+
+    // Act
+    std::vector<Mesh::MeshObject::TPlane> planes;
+    planes.emplace_back(Base::Vector3f(1.5F, 0, 0), Base::Vector3f(1, 0, 0));
+    std::vector<Mesh::MeshObject::TPolylines> sections;
+    mesh.crossSections(planes, sections);
+
+    // Assert
+    ASSERT_EQ(sections.size(), 1);
+    EXPECT_FALSE(sections[0].empty());
+    Base::BoundBox3f box;
+    for (const auto& polyline : sections[0]) {
+        for (const auto& pnt : polyline) {
+            box.Add(pnt);
+        }
+    }
+    EXPECT_FLOAT_EQ(box.MinX, 1.5F);
+    EXPECT_FLOAT_EQ(box.MaxX, 1.5F);
+    EXPECT_FLOAT_EQ(box.MinY, 0.0F);
+    EXPECT_FLOAT_EQ(box.MaxY, 4.0F);
+}
+
+TEST(MeshTest, TestBooleanCorefinement)
+{
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        makeBox(Base::Vector3f(0.5F, 0.5F, 0.5F), Base::Vector3f(1.5F, 1.5F, 1.5F));
+
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Union), 1.875F, 1e-5F);
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Intersect), 0.125F, 1e-5F);
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Difference), 0.875F, 1e-5F);
+}
+
+TEST(MeshTest, TestBooleanCorefinementCoplanar)
+{
+    // the boxes share the planes of their bottom and top faces
+    MeshCore::MeshKernel box1 = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        makeBox(Base::Vector3f(0.5F, 0.5F, 0), Base::Vector3f(1.5F, 1.5F, 1));
+
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Union), 1.75F, 1e-5F);
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Intersect), 0.25F, 1e-5F);
+    EXPECT_NEAR(booleanVolume(box1, box2, MeshCore::SetOperations::Difference), 0.75F, 1e-5F);
+    EXPECT_NEAR(booleanVolume(box1, box1, MeshCore::SetOperations::Union), 1.0F, 1e-5F);
+}
+
+TEST(MeshTest, TestAdjacency)
+{
+    MeshCore::MeshKernel kernel = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshAdjacency pointToPoints(kernel, MeshCore::MeshAdjacency::PointToPoints);
+    MeshCore::MeshAdjacency pointToFacets(kernel, MeshCore::MeshAdjacency::PointToFacets);
+    MeshCore::MeshAdjacency facetToFacets(kernel, MeshCore::MeshAdjacency::FacetToFacets);
+    MeshCore::MeshRefPointToPoints refPointToPoints(kernel);
+    MeshCore::MeshRefPointToFacets refPointToFacets(kernel);
+    MeshCore::MeshRefFacetToFacets refFacetToFacets(kernel);
+
+    ASSERT_EQ(pointToPoints.Size(), 8);
+    ASSERT_EQ(facetToFacets.Size(), 12);
+    for (MeshCore::PointIndex i = 0; i < 8; i++) {
+        auto points = pointToPoints[i];
+        auto facets = pointToFacets[i];
+        EXPECT_TRUE(std::ranges::equal(points, refPointToPoints[i]));
+        EXPECT_TRUE(std::ranges::equal(facets, refPointToFacets[i]));
+    }
+    for (MeshCore::FacetIndex i = 0; i < 12; i++) {
+        auto facets = facetToFacets[i];
+        EXPECT_TRUE(std::ranges::equal(facets, refFacetToFacets[i]));
+        EXPECT_TRUE(std::ranges::binary_search(facets, i));
+    }
+}
+
+TEST(MeshTest, TestParallelSmoothing)
+{
+    // a planar grid whose inner points are lifted alternately
+    const int size = 100;
+    MeshCore::MeshKernel kernel = makeGrid(size, [](int i, int j) {
+        bool inner = i > 0 && j > 0 && i < size && j < size;
+        return inner && (i + j) % 2 == 1 ? 0.1F : 0.0F;
+    });
+
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SetJacobi(true);
+    smooth.Smooth(10);
+
+    // the border points are kept and the inner points get the same height
+    MeshCore::PointIndex center = (size / 2) * (size + 1) + size / 2;
+    EXPECT_FLOAT_EQ(kernel.GetPoint(size).z, 0.0F);
+    EXPECT_NEAR(kernel.GetPoint(center).z, kernel.GetPoint(center + 1).z, 1e-4F);
+    EXPECT_NEAR(kernel.GetPoint(center).z, kernel.GetPoint(center + size + 1).z, 1e-4F);
+    EXPECT_FLOAT_EQ(kernel.GetBoundBox().LengthX(), float(size));
+}
+
+TEST(MeshTest, TestSmoothingMovesPointsInPlace)
+{
+    MeshCore::MeshKernel inPlace = makeBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel jacobi = inPlace;
+
+    MeshCore::LaplaceSmoothing smoothInPlace(inPlace);
+    smoothInPlace.Smooth(1);
+    MeshCore::LaplaceSmoothing smoothJacobi(jacobi);
+    smoothJacobi.SetJacobi(true);
+    smoothJacobi.Smooth(1);
+
+    // by default the later points already see the new positions of their neighbours
+    EXPECT_FALSE(smoothInPlace.IsJacobi());
+    EXPECT_EQ(inPlace.GetPoint(0), jacobi.GetPoint(0));
+    EXPECT_NE(inPlace.GetPoint(7), jacobi.GetPoint(7));
+}
+
+TEST(MeshTest, TestCompactFormat)
+{
+    const int size = 50;
+    MeshCore::MeshKernel kernel = makeGrid(size, [](int i, int) {
+        return std::sin(0.3F * i) * 7.0F;
+    });
+    Base::Matrix4D mat;
+    mat.scale(0.1, 0.1, 0.1);
+    kernel.Transform(mat);
+
+    std::stringstream legacy;
+    kernel.Write(legacy);
+
+    // lossless with the stored neighbourhood
+    std::stringstream exact;
+    MeshCore::WriterCompact writer(kernel);
+    EXPECT_TRUE(writer.Save(exact));
+    EXPECT_TRUE(exact.str().size() < legacy.str().size() / 2);
+
+    MeshCore::MeshKernel copy;
+    copy.Read(exact);
+    ASSERT_EQ(copy.CountPoints(), kernel.CountPoints());
+    ASSERT_EQ(copy.CountFacets(), kernel.CountFacets());
+    EXPECT_TRUE(std::ranges::equal(copy.GetPoints(),
+                                   kernel.GetPoints(),
+                                   [](const Base::Vector3f& p1, const Base::Vector3f& p2) {
+                                       return p1.x == p2.x && p1.y == p2.y && p1.z == p2.z;
+                                   }));
+    EXPECT_TRUE(sameFacets(copy, kernel));
+
+    // quantized with the neighbourhood rebuilt on reading
+    std::stringstream quantized;
+    writer.SetQuantization(16);
+    writer.SetStoreNeighbours(false);
+    EXPECT_TRUE(writer.Save(quantized));
+    copy.Read(quantized);
+    ASSERT_EQ(copy.CountPoints(), kernel.CountPoints());
+    float maxDist = 0.0F;
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        maxDist = std::max(maxDist, Base::Distance(copy.GetPoint(i), kernel.GetPoint(i)));
+    }
+    EXPECT_TRUE(maxDist < 1e-4F);
+    EXPECT_TRUE(sameFacets(copy, kernel));
+
+    // truncated data is rejected
+    std::string data = exact.str();
+    std::stringstream truncated(data.substr(0, data.size() / 2));
+    EXPECT_THROW(copy.Read(truncated), Base::BadFormatError);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
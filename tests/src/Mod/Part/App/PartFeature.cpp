@@ -230,3 +230,41 @@ TEST_F(FeaturePartTest, getComplexElementTypes)
     EXPECT_STREQ(types[1], "Edge");
     EXPECT_STREQ(types[2], "Vertex");
 }
+
+TEST_F(FeaturePartTest, boxesRecomputeInParallel)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool oldValue = hGrp->GetBool("ParallelRecompute", false);
+    for (unsigned i = 0; i < _boxes.size(); i++) {
+        _boxes[i]->Length.setValue(i + 1.0);
+    }
+    hGrp->SetBool("ParallelRecompute", true);
+
+    // Act
+    _doc->recompute();
+    hGrp->SetBool("ParallelRecompute", oldValue);
+
+    // Assert
+    for (unsigned i = 0; i < _boxes.size(); i++) {
+        EXPECT_FALSE(_boxes[i]->isTouched());
+        EXPECT_NEAR(getVolume(_boxes[i]->Shape.getShape().getShape()),
+                    (i + 1.0) * 6.0,
+                    Base::Precision::Confusion());
+    }
+}
+
+TEST_F(FeaturePartTest, boxPreparedForOtherDimensionsIsRebuilt)
+{
+    // Arrange
+    auto box = _boxes[0];
+    box->prepareRecompute();
+    box->Length.setValue(4.0);
+
+    // Act
+    box->execute();
+
+    // Assert
+    EXPECT_NEAR(getVolume(box->Shape.getShape().getShape()), 24.0, Base::Precision::Confusion());
+}
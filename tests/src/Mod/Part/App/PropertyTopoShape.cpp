@@ -2,16 +2,68 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+
 #include <BRepFilletAPI_MakeFillet.hxx>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
 #include "PartTestHelpers.h"
 #include "Mod/Part/App/TopoShapeCompoundPy.h"
+#include <App/Application.h>
+#include <Base/FileInfo.h>
+#include <zipios++/zipfile.h>
 
 using namespace Part;
 using namespace PartTestHelpers;
 
+namespace
+{
+// Sets a parameter and restores it when going out of scope
+class ParameterGuard
+{
+public:
+    ParameterGuard(const char* group, const char* name, bool value)
+    {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(group);
+        std::string key(name);
+        // an unset parameter returns the preset
+        if (hGrp->GetBool(name, false) == hGrp->GetBool(name, true)) {
+            bool old = hGrp->GetBool(name);
+            restore = [hGrp, key, old]() { hGrp->SetBool(key.c_str(), old); };
+        }
+        else {
+            restore = [hGrp, key]() { hGrp->RemoveBool(key.c_str()); };
+        }
+        hGrp->SetBool(name, value);
+    }
+    ParameterGuard(const char* group, const char* name, long value)
+    {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(group);
+        std::string key(name);
+        if (hGrp->GetInt(name, 0) == hGrp->GetInt(name, 1)) {
+            long old = hGrp->GetInt(name);
+            restore = [hGrp, key, old]() { hGrp->SetInt(key.c_str(), old); };
+        }
+        else {
+            restore = [hGrp, key]() { hGrp->RemoveInt(key.c_str()); };
+        }
+        hGrp->SetInt(name, value);
+    }
+    ~ParameterGuard()
+    {
+        restore();
+    }
+    ParameterGuard(const ParameterGuard&) = delete;
+    ParameterGuard& operator=(const ParameterGuard&) = delete;
+
+private:
+    std::function<void()> restore;
+};
+
+constexpr const char* partGeneral = "User parameter:BaseApp/Preferences/Mod/Part/General";
+}  // namespace
+
 class PropertyTopoShapeTest: public ::testing::Test, public PartTestHelperClass
 {
 protected:
@@ -269,3 +321,163 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testLazyRestore)
+{
+    // Arrange
+    ParameterGuard lazy(partGeneral, "LazyLoadShapes", true);
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".FCStd");
+    std::string name = _common->getNameInDocument();
+    auto mapSize = _common->Shape.getShape().getElementMapSize();
+    auto volume = _common->Shape.getShape().getBoundBox().Volume();
+    _doc->saveAs(fi.filePath().c_str());
+    App::GetApplication().closeDocument(_docName.c_str());
+
+    // Act
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    auto common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    ASSERT_NE(common, nullptr);
+    bool pending = common->Shape.isLoadPending();
+    const auto& shape = common->Shape.getShape();
+
+    // Assert
+    EXPECT_TRUE(pending);
+    EXPECT_FALSE(common->Shape.isLoadPending());
+    EXPECT_FALSE(shape.isNull());
+    EXPECT_EQ(shape.getElementMapSize(), mapSize);
+    EXPECT_DOUBLE_EQ(shape.getBoundBox().Volume(), volume);
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testLazySaveKeepsShapePending)
+{
+    // Arrange
+    ParameterGuard lazy(partGeneral, "LazyLoadShapes", true);
+    ParameterGuard backup("User parameter:BaseApp/Preferences/Document",
+                          "CreateBackupFiles",
+                          false);
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".FCStd");
+    std::string name = _common->getNameInDocument();
+    auto mapSize = _common->Shape.getShape().getElementMapSize();
+    auto volume = _common->Shape.getShape().getBoundBox().Volume();
+    _doc->saveAs(fi.filePath().c_str());
+    App::GetApplication().closeDocument(_docName.c_str());
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    auto common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    ASSERT_NE(common, nullptr);
+
+    // Act
+    doc->save();
+    bool pending = common->Shape.isLoadPending();
+    bool loaded = !common->Shape.getShape().isNull();
+    App::GetApplication().closeDocument(doc->getName());
+    doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    ASSERT_NE(common, nullptr);
+    const auto& reloaded = common->Shape.getShape();
+
+    // Assert
+    EXPECT_TRUE(pending);
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(reloaded.getElementMapSize(), mapSize);
+    EXPECT_DOUBLE_EQ(reloaded.getBoundBox().Volume(), volume);
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testConcurrentRestore)
+{
+    // Arrange
+    ParameterGuard threads("User parameter:BaseApp/Preferences/Document", "RestoreThreads", 4L);
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".FCStd");
+    std::string name = _common->getNameInDocument();
+    auto mapSize = _common->Shape.getShape().getElementMapSize();
+    auto volume = _common->Shape.getShape().getBoundBox().Volume();
+    _doc->saveAs(fi.filePath().c_str());
+    App::GetApplication().closeDocument(_docName.c_str());
+
+    // Act
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    auto common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    ASSERT_NE(common, nullptr);
+    const auto& shape = common->Shape.getShape();
+
+    // Assert
+    EXPECT_FALSE(shape.isNull());
+    EXPECT_EQ(shape.getElementMapSize(), mapSize);
+    EXPECT_DOUBLE_EQ(shape.getBoundBox().Volume(), volume);
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testBinaryBrepRoundTrip)
+{
+    // Arrange
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".FCStd");
+    std::string name = _common->getNameInDocument();
+    auto mapSize = _common->Shape.getShape().getElementMapSize();
+    auto volume = _common->Shape.getShape().getBoundBox().Volume();
+    _doc->BinaryBrep.setValue(true);
+    _doc->saveAs(fi.filePath().c_str());
+    App::GetApplication().closeDocument(_docName.c_str());
+
+    // Act
+    zipios::ZipFile zip(fi.filePath());
+    bool hasEntry = zip.getEntry(name + ".Shape.bin").get() != nullptr;
+    zip.close();
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    auto common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    ASSERT_NE(common, nullptr);
+    const auto& shape = common->Shape.getShape();
+
+    // Assert
+    EXPECT_TRUE(hasEntry);
+    EXPECT_TRUE(doc->BinaryBrep.getValue());
+    EXPECT_FALSE(shape.isNull());
+    EXPECT_EQ(shape.getElementMapSize(), mapSize);
+    EXPECT_DOUBLE_EQ(shape.getBoundBox().Volume(), volume);
+
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testSharedShapeFile)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    hGrp->SetBool("DeduplicateShapes", true);
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".FCStd");
+    auto copy = _doc->addObject<Part::Feature>("Copy");
+    auto link = dynamic_cast<App::PropertyLink*>(
+        copy->addDynamicProperty("App::PropertyLink", "Source"));
+    link->setValue(_common);
+    copy->Shape.setValue(_common->Shape.getShape());
+    std::string name = _common->getNameInDocument();
+    _doc->saveAs(fi.filePath().c_str());
+    App::GetApplication().closeDocument(_docName.c_str());
+
+    // Act
+    zipios::ZipFile zip(fi.filePath());
+    bool hasCopyFile = zip.getEntry("Copy.Shape.bin").get() != nullptr
+        || zip.getEntry("Copy.Shape.brp").get() != nullptr;
+    zip.close();
+    auto doc = App::GetApplication().openDocument(fi.filePath().c_str());
+    auto common = dynamic_cast<Part::Common*>(doc->getObject(name.c_str()));
+    auto restored = dynamic_cast<Part::Feature*>(doc->getObject("Copy"));
+    ASSERT_NE(common, nullptr);
+    ASSERT_NE(restored, nullptr);
+
+    // Assert
+    EXPECT_FALSE(hasCopyFile);
+    EXPECT_FALSE(restored->Shape.getValue().IsNull());
+    EXPECT_TRUE(restored->Shape.getValue().IsEqual(common->Shape.getValue()));
+
+    hGrp->SetBool("DeduplicateShapes", false);
+    App::GetApplication().closeDocument(doc->getName());
+    fi.deleteFile();
+}
@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
+#include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Points/App/Downsampling.h>
+#include <Mod/Points/App/NormalEstimation.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
+#include <Mod/Points/App/PointsKdTree.h>
+#include <Mod/Points/App/PointsOctree.h>
+#include <Mod/Points/App/Properties.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 
@@ -138,6 +145,32 @@ TEST_F(PointsTest, TestASCII)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestParseASCII)
+{
+    std::string name = getFileName() + ".asc";
+    {
+        Base::ofstream str(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        str << "# scanner export\r\n"
+            << "X Y Z\n"
+            << "1.5 -2 3e2\r\n"
+            << "\n"
+            << "+4,5.25,-6 255 0 0\n"
+            << "\t7 8 9";
+    }
+
+    Points::AscReader reader;
+    reader.read(name);
+
+    // the header lines are skipped and further columns are ignored
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(reader.getWidth(), 3);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[0].z, 300.0F);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[1].x, 4.0F);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[1].y, 5.25F);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[2].z, 9.0F);
+}
+
 TEST_F(PointsTest, TestPlainPLY)
 {
     std::string name = getFileName();
@@ -156,6 +189,39 @@ TEST_F(PointsTest, TestPlainPLY)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestASCIIPLYWithFaces)
+{
+    std::string name = getFileName() + ".ply";
+    {
+        Base::ofstream str(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        str << "ply\n"
+            << "format ascii 1.0\n"
+            << "element vertex 3\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "element face 1\n"
+            << "property list uchar int vertex_indices\n"
+            << "end_header\n"
+            << "0 0 0\n"
+            << "1 0 0\n"
+            << "\n"
+            << "0 1 0\n"
+            << "3 0 1 2\n"
+            << "not a number\n";
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    // only the vertex lines are parsed
+    const Points::PointKernel& points = reader.getPoints();
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(reader.getWidth(), 3);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[1].x, 1.0F);
+    EXPECT_FLOAT_EQ(points.getBasicPoints()[2].y, 1.0F);
+}
+
 TEST_F(PointsTest, TestPLYWithProperties)
 {
     std::string name = getFileName();
@@ -238,4 +304,249 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestSubsampling)
+{
+    std::string name = getFileName();
+    Points::PcdWriter writer(getKernel());
+    writer.setIntensities(getIntensity());
+    writer.setColors(getColors());
+    writer.setWidth(4);
+    writer.setHeight(2);
+    writer.write(name);
+
+    Points::PcdReader reader;
+    reader.setSubsampling(3);
+    reader.read(name);
+
+    // only the points 0, 3 and 6 are kept and the cloud is no longer structured
+    ASSERT_EQ(reader.getPoints().size(), 3);
+    EXPECT_EQ(reader.getIntensities().size(), 3);
+    EXPECT_EQ(reader.getColors().size(), 3);
+    EXPECT_FLOAT_EQ(reader.getIntensities()[1], 0.4F);
+    EXPECT_FALSE(reader.isStructured());
+    EXPECT_EQ(reader.getWidth(), 3);
+}
+
+TEST(PointsOctreeTest, TestLevelOfDetail)
+{
+    // a regular grid of points with every tenth point marked as invalid
+    const int size = 50;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < size * size * size; i++) {
+        if (i % 10 == 0) {
+            points.emplace_back(nan, nan, nan);
+        }
+        else {
+            points.emplace_back(float(i % size), float(i / size % size), float(i / size / size));
+        }
+    }
+    std::size_t valid = points.size() - points.size() / 10;
+
+    Points::PointsOctree octree(1000);
+    octree.Build(points);
+    const auto& nodes = octree.GetNodes();
+    const auto& indices = octree.GetIndices();
+    ASSERT_TRUE(nodes.size() > 1);
+    EXPECT_EQ(nodes.front().total, valid);
+
+    // the points with x == 0 are all invalid
+    const Base::BoundBox3f& box = octree.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 1.0F);
+    EXPECT_FLOAT_EQ(box.MinY, 0.0F);
+    EXPECT_FLOAT_EQ(box.MaxX, float(size - 1));
+    EXPECT_FLOAT_EQ(box.MaxZ, float(size - 1));
+
+    // each valid point is owned by exactly one node
+    std::vector<int> owned(points.size(), 0);
+    for (uint32_t index : indices) {
+        owned[index]++;
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(owned[i], i % 10 == 0 ? 0 : 1);
+    }
+
+    // without limits all points are drawn
+    auto all = [](const Points::PointsOctree::Node&) {
+        return 1e6F;
+    };
+    std::size_t count = 0;
+    for (uint32_t index : octree.Select(all, indices.size(), 1.0F)) {
+        count += nodes[index].count;
+    }
+    EXPECT_EQ(count, valid);
+
+    // the budget is respected and the coarse levels come first
+    count = 0;
+    std::vector<uint32_t> selection = octree.Select(all, valid / 2, 1.0F);
+    for (uint32_t index : selection) {
+        count += nodes[index].count;
+    }
+    EXPECT_TRUE(count <= valid / 2);
+    EXPECT_EQ(selection.front(), 0);
+
+    // invisible nodes are skipped
+    auto none = [](const Points::PointsOctree::Node&) {
+        return -1.0F;
+    };
+    EXPECT_TRUE(octree.Select(none, valid, 1.0F).empty());
+}
+
+TEST(PointsKdTreeTest, TestNeighbours)
+{
+    // a regular grid with a spacing of 1 and an invalid point
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++) {
+            for (int k = 0; k < 20; k++) {
+                points.emplace_back(float(i), float(j), float(k));
+            }
+        }
+    }
+    points[1].x = std::numeric_limits<float>::quiet_NaN();
+
+    Points::PointsKdTree tree(points);
+    EXPECT_EQ(tree.Size(), points.size() - 1);
+    EXPECT_EQ(tree.CountPoints(), points.size());
+
+    // an inner point has six neighbours at distance 1
+    std::vector<Points::PointsKdTree::Neighbour> result;
+    Base::Vector3f center(10.0F, 10.0F, 10.0F);
+    tree.FindNearest(center, 7, result);
+    ASSERT_EQ(result.size(), 7);
+    EXPECT_EQ(result[0].index, 10 * 400 + 10 * 20 + 10);
+    EXPECT_FLOAT_EQ(result[0].sqrDistance, 0.0F);
+    EXPECT_FLOAT_EQ(result[6].sqrDistance, 1.0F);
+
+    tree.FindInRadius(center + Base::Vector3f(0.1F, 0.1F, 0.1F), 1.0F, result);
+    EXPECT_EQ(result.size(), 4);
+
+    // the neighbourhood of each point starts with the point itself
+    tree.FindNearest(4, result);
+    ASSERT_EQ(result.size(), points.size() * 4);
+    EXPECT_EQ(result[4].index, Points::PointsKdTree::InvalidIndex);
+    for (std::size_t i = 2; i < points.size(); i++) {
+        EXPECT_FLOAT_EQ(result[i * 4].sqrDistance, 0.0F);
+        EXPECT_FLOAT_EQ(result[i * 4 + 3].sqrDistance, 1.0F);
+    }
+}
+
+TEST(PointsKdTreeTest, TestOutliers)
+{
+    Points::PointKernel kernel;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            kernel.push_back(Base::Vector3d(i, j, 0));
+        }
+    }
+    kernel.push_back(Base::Vector3d(5, 5, 20));
+
+    std::vector<std::size_t> outliers = Points::PointsAlgos::FindOutliers(kernel, 8, 3.0);
+    ASSERT_EQ(outliers.size(), 1);
+    EXPECT_EQ(outliers.front(), 100);
+}
+
+TEST(PointsKdTreeTest, TestCachedTree)
+{
+    // Arrange
+    Points::PointKernel kernel;
+    kernel.push_back(Base::Vector3d(0, 0, 0));
+    kernel.push_back(Base::Vector3d(1, 0, 0));
+    std::vector<Points::PointsKdTree::Neighbour> result;
+
+    // Act
+    auto tree = kernel.getKdTree();
+    Points::PointKernel copy(kernel);
+    kernel.setPoint(1, Base::Vector3d(5, 0, 0));
+    auto modified = kernel.getKdTree();
+    modified->FindNearest(Base::Vector3f(4, 0, 0), 1, result);
+
+    // Assert
+    EXPECT_EQ(copy.getKdTree(), tree);
+    EXPECT_NE(modified, tree);
+    EXPECT_EQ(kernel.getKdTree(), modified);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_FLOAT_EQ(result.front().sqrDistance, 1.0F);
+}
+
+TEST(PointsNormalsTest, TestSphere)
+{
+    // evenly distributed points on two spheres with an invalid point
+    const int count = 2000;
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < count; i++) {
+        float z = 1.0F - (2.0F * float(i) + 1.0F) / float(count);
+        float r = std::sqrt(1.0F - z * z);
+        float phi = 2.39996F * float(i);
+        Base::Vector3f dir(r * std::cos(phi), r * std::sin(phi), z);
+        points.push_back(dir * 5.0F);
+        points.push_back(dir * 2.0F + Base::Vector3f(20.0F, 0.0F, 0.0F));
+    }
+    points[0].x = std::numeric_limits<float>::quiet_NaN();
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+
+    Points::NormalEstimation estimation(kernel);
+    std::vector<Base::Vector3f> normals = estimation.Perform();
+    ASSERT_EQ(normals.size(), points.size());
+    EXPECT_FLOAT_EQ(normals[0].Length(), 0.0F);
+
+    // the normals point outwards
+    for (std::size_t i = 1; i < points.size(); i++) {
+        Base::Vector3f dir = points[i];
+        if (i % 2 == 1) {
+            dir.x -= 20.0F;
+        }
+        dir.Normalize();
+        EXPECT_TRUE(dir * normals[i] > 0.99F);
+    }
+
+    Points::PropertyNormalList prop;
+    estimation.Perform(prop);
+    EXPECT_EQ(prop.getValues(), normals);
+}
+
+TEST(PointsDownsamplingTest, TestVoxelGridAndPoissonDisk)
+{
+    // a grid with a spacing of 0.1
+    Points::PointKernel kernel;
+    for (int i = 0; i < 50; i++) {
+        for (int j = 0; j < 50; j++) {
+            kernel.push_back(Base::Vector3d(0.1 * i, 0.1 * j, 0.0));
+        }
+    }
+    const std::vector<Base::Vector3f>& points = kernel.getBasicPoints();
+
+    // the extent of 4.9 gives 10 x 10 cubes
+    std::vector<std::size_t> voxels = Points::Downsampling::VoxelGrid(kernel, 0.5);
+    EXPECT_EQ(voxels.size(), 100);
+    EXPECT_TRUE(std::is_sorted(voxels.begin(), voxels.end()));
+    Points::PointKernel reduced = Points::Downsampling::Extract(kernel, voxels);
+    ASSERT_EQ(reduced.size(), voxels.size());
+    EXPECT_EQ(reduced.getBasicPoints().back(), points[voxels.back()]);
+
+    const float radius = 0.35F;
+    std::vector<std::size_t> samples = Points::Downsampling::PoissonDisk(kernel, radius);
+    std::vector<Base::Vector3f> kept;
+    for (std::size_t index : samples) {
+        kept.push_back(points[index]);
+    }
+    ASSERT_FALSE(kept.empty());
+    EXPECT_TRUE(kept.size() < points.size() / 4);
+
+    // no two samples are closer than the radius and each point is near a sample
+    Points::PointsKdTree tree(kept);
+    std::vector<Points::PointsKdTree::Neighbour> result;
+    for (const auto& pnt : kept) {
+        tree.FindNearest(pnt, 2, result);
+        EXPECT_TRUE(result[1].sqrDistance >= radius * radius);
+    }
+    for (const auto& pnt : points) {
+        tree.FindNearest(pnt, 1, result);
+        EXPECT_TRUE(result[0].sqrDistance < radius * radius);
+    }
+
+    EXPECT_THROW(Points::Downsampling::VoxelGrid(kernel, 0.0), Base::ValueError);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
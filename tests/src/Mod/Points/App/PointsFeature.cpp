@@ -1,6 +1,9 @@
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include <src/App/InitApplication.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/Properties.h>
 
 class PointsFeatureTest: public ::testing::Test
 {
@@ -33,4 +36,28 @@ TEST_F(PointsFeatureTest, getComplexElementTypes)
 
     EXPECT_EQ(types.size(), 0);
 }
+
+TEST_F(PointsFeatureTest, estimateNormals)
+{
+    // Arrange
+    Points::Feature pf;
+    Points::PointKernel pk;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            pk.push_back(Base::Vector3d(i, j, 0));
+        }
+    }
+    pf.Points.setValue(pk);
+
+    // Act
+    pf.estimateNormals(8, false);
+
+    // Assert
+    auto prop = dynamic_cast<Points::PropertyNormalList*>(pf.getPropertyByName("Normal"));
+    ASSERT_NE(prop, nullptr);
+    ASSERT_EQ(prop->getSize(), 100);
+    for (const auto& normal : prop->getValues()) {
+        EXPECT_FLOAT_EQ(std::fabs(normal.z), 1.0F);
+    }
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)